@@ -14,6 +14,7 @@ TEMPLATE = app
 
 include(depends/depends.pri)
 include(widgets/QHexEdit/QHexEdit.pri)
+include(redasm/redasm.pri)
 debug: include(unittest/unittest.pri)
 
 DEFINES += GIT_VERSION='\\\"'$$system("git rev-parse --short HEAD")'\\\"'
@@ -34,229 +35,74 @@ win32
     RC_FILE = $$PWD/res/windows/resources.rc
 }
 
-SOURCES += main.cpp\
-        mainwindow.cpp \
-    redasm/plugins/plugins.cpp \
-    redasm/plugins/format.cpp \
+SOURCES += main.cpp \
+    mainwindow.cpp \
     widgets/disassemblerview/disassemblerview.cpp \
     widgets/disassemblertextview/disassemblertextview.cpp \
     models/symboltablemodel.cpp \
     models/symboltablefiltermodel.cpp \
     models/disassemblermodel.cpp \
     models/segmentsmodel.cpp \
-    redasm/analyzer/analyzer.cpp \
-    redasm/disassembler/disassembler.cpp \
     widgets/listingmap.cpp \
     models/referencesmodel.cpp \
     dialogs/referencesdialog.cpp \
-    redasm/formats/psxexe/psxexe.cpp \
-    redasm/formats/psxexe/psxexe_analyzer.cpp \
-    redasm/formats/pe/pe.cpp \
     widgets/disassemblerview/disassemblerthread.cpp \
-    redasm/plugins/assembler/printer.cpp \
-    redasm/formats/pe/pe_analyzer.cpp \
-    redasm/formats/pe/pe_utils.cpp \
     dialogs/gotodialog.cpp \
-    redasm/formats/elf/elf.cpp \
-    redasm/support/utils.cpp \
-    redasm/support/demangler.cpp \
-    redasm/assemblers/mips/mips.cpp \
-    redasm/assemblers/x86/x86.cpp \
-    redasm/plugins/assembler/assembler.cpp \
-    redasm/formats/pe/vb/vb_analyzer.cpp \
-    redasm/formats/pe/vb/vb_components.cpp \
-    redasm/formats/pe/pe_imports.cpp \
-    redasm/disassembler/disassemblerbase.cpp \
-    redasm/disassembler/types/listing.cpp \
-    redasm/disassembler/types/referencetable.cpp \
-    redasm/disassembler/types/symboltable.cpp \
-    redasm/support/coff/coff_symboltable.cpp \
     widgets/disassemblertextview/disassemblerhighlighter.cpp \
     dialogs/databasedialog.cpp \
-    redasm/support/hash.cpp \
-    redasm/signatures/patparser.cpp \
     models/databasemodel.cpp \
-    redasm/support/serializer.cpp \
-    redasm/signatures/signaturedb.cpp \
     dialogs/aboutdialog.cpp \
     widgets/disassemblergraphview/disassemblergraphview.cpp \
     widgets/disassemblerview/disassemblerdocument.cpp \
     widgets/disassemblertextview/disassemblertextdocument.cpp \
     widgets/disassemblergraphview/disassemblergraphdocument.cpp \
     widgets/disassemblergraphview/functionblockitem.cpp \
-    redasm/redasm.cpp \
-    redasm/formats/pe/pe_resources.cpp \
-    redasm/formats/pe/borland/borland_version.cpp \
     dialogs/manualloaddialog.cpp \
-    redasm/formats/binary/binary.cpp \
-    redasm/assemblers/chip8/chip8.cpp \
-    redasm/support/endianness.cpp \
-    redasm/vmil/vmil_instructions.cpp \
-    redasm/vmil/vmil_emulator.cpp \
-    redasm/vmil/vmil_printer.cpp \
-    redasm/assemblers/mips/mips_quirks.cpp \
-    redasm/assemblers/mips/mips_printer.cpp \
-    redasm/assemblers/x86/x86_printer.cpp \
-    redasm/assemblers/chip8/chip8_printer.cpp \
-    redasm/assemblers/chip8/chip8_emulator.cpp \
-    redasm/assemblers/mips/mips_emulator.cpp \
-    redasm/formats/dex/dex.cpp \
-    redasm/assemblers/dalvik/dalvik.cpp \
-    redasm/assemblers/dalvik/dalvik_printer.cpp \
-    redasm/formats/dex/dex_statemachine.cpp \
-    redasm/formats/dex/dex_utils.cpp \
     themeprovider.cpp \
     widgets/graphview/graphitems/graphitem.cpp \
     widgets/graphview/graphitems/graphtextitem.cpp \
     widgets/graphview/graphview.cpp \
     widgets/graphview/graphviewprivate.cpp \
-    redasm/formats/elf/elf_analyzer.cpp \
-    redasm/disassembler/disassemblerapi.cpp \
-    redasm/assemblers/cil/cil.cpp \
-    redasm/formats/pe/dotnet/dotnet.cpp \
-    redasm/formats/pe/dotnet/dotnet_reader.cpp \
-    redasm/graph/graph.cpp \
-    redasm/graph/graph_layout.cpp \
-    redasm/disassembler/graph/functiongraph.cpp \
-    redasm/graph/graph_genetic.cpp \
-    redasm/disassembler/graph/callgraph.cpp \
     dialogs/callgraphdialog.cpp \
     widgets/callgraphview/callgraphview.cpp \
     widgets/callgraphview/callgraphitem.cpp \
     widgets/graphview/graphviewmetrics.cpp \
-    redasm/formats/xbe/xbe.cpp \
-    redasm/support/ordinals.cpp \
-    redasm/formats/gba/gba.cpp \
-    redasm/formats/gba/gba_analyzer.cpp \
-    redasm/assemblers/metaarm/metaarm.cpp \
-    redasm/assemblers/metaarm/metaarm_printer.cpp \
-    redasm/assemblers/metaarm/metaarm_emulator.cpp \
-    redasm/assemblers/metaarm/arm.cpp \
-    redasm/assemblers/metaarm/armthumb.cpp \
-    redasm/assemblers/metaarm/arm_common.cpp
+    widgets/listingtextview/listingrenderer.cpp \
+    widgets/listingtextview/listingtextview.cpp
 
 HEADERS  += mainwindow.h \
-    redasm/redasm.h \
-    redasm/plugins/format.h \
-    redasm/plugins/base.h \
-    redasm/plugins/plugins.h \
     widgets/disassemblerview/disassemblerview.h \
     widgets/disassemblertextview/disassemblertextview.h \
     models/symboltablemodel.h \
     models/symboltablefiltermodel.h \
     models/disassemblermodel.h \
     models/segmentsmodel.h \
-    redasm/analyzer/analyzer.h \
-    redasm/disassembler/disassembler.h \
     widgets/listingmap.h \
     models/referencesmodel.h \
     dialogs/referencesdialog.h \
-    redasm/formats/psxexe/psxexe.h \
-    redasm/formats/psxexe/psxexe_analyzer.h \
-    redasm/formats/pe/pe.h \
-    redasm/formats/pe/pe_constants.h \
-    redasm/formats/pe/pe_headers.h \
     widgets/disassemblerview/disassemblerthread.h \
-    redasm/plugins/assembler/printer.h \
-    redasm/formats/pe/pe_analyzer.h \
-    redasm/formats/pe/pe_utils.h \
     dialogs/gotodialog.h \
-    redasm/formats/elf/elf.h \
-    redasm/formats/elf/elf64_header.h \
-    redasm/formats/elf/elf32_header.h \
-    redasm/formats/elf/elf_common.h \
-    redasm/support/demangler.h \
-    redasm/support/utils.h \
-    redasm/assemblers/mips/mips.h \
-    redasm/assemblers/x86/x86.h \
-    redasm/formats/pe/vb/vb_analyzer.h \
-    redasm/formats/pe/vb/vb_header.h \
-    redasm/formats/pe/vb/vb_components.h \
-    redasm/formats/pe/pe_imports.h \
-    redasm/disassembler/disassemblerbase.h \
-    redasm/disassembler/types/listing.h \
-    redasm/disassembler/types/referencetable.h \
-    redasm/disassembler/types/symboltable.h \
-    redasm/support/coff/coff_symboltable.h \
-    redasm/support/coff/coff_types.h \
-    redasm/support/coff/coff_constants.h \
-    redasm/support/cachemap.h \
     widgets/disassemblertextview/disassemblerhighlighter.h \
     dialogs/databasedialog.h \
-    redasm/support/hash.h \
-    redasm/signatures/patparser.h \
     models/databasemodel.h \
-    redasm/support/serializer.h \
-    redasm/signatures/signaturedb.h \
     dialogs/aboutdialog.h \
     widgets/disassemblergraphview/disassemblergraphview.h \
     widgets/disassemblerview/disassemblerdocument.h \
     widgets/disassemblertextview/disassemblertextdocument.h \
     widgets/disassemblergraphview/disassemblergraphdocument.h \
     widgets/disassemblergraphview/functionblockitem.h \
-    redasm/formats/pe/pe_resources.h \
-    redasm/formats/pe/borland/borland_types.h \
-    redasm/formats/pe/borland/borland_version.h \
     dialogs/manualloaddialog.h \
-    redasm/formats/binary/binary.h \
-    redasm/assemblers/chip8/chip8.h \
-    redasm/support/endianness.h \
-    redasm/vmil/vmil_instructions.h \
-    redasm/vmil/vmil_types.h \
-    redasm/vmil/vmil_emulator.h \
-    redasm/vmil/vmil_printer.h \
-    redasm/assemblers/mips/mips_printer.h \
-    redasm/assemblers/mips/mips_quirks.h \
-    redasm/assemblers/x86/x86_printer.h \
-    redasm/assemblers/chip8/chip8_emulator.h \
-    redasm/assemblers/chip8/chip8_printer.h \
-    redasm/assemblers/chip8/chip8_registers.h \
-    redasm/assemblers/mips/mips_emulator.h \
-    redasm/formats/dex/dex.h \
-    redasm/formats/dex/dex_constants.h \
-    redasm/formats/dex/dex_header.h \
-    redasm/assemblers/dalvik/dalvik.h \
-    redasm/assemblers/dalvik/dalvik_printer.h \
-    redasm/assemblers/dalvik/dalvik_metadata.h \
-    redasm/assemblers/dalvik/dalvik_opcodes.h \
-    redasm/formats/dex/dex_statemachine.h \
-    redasm/formats/dex/dex_utils.h \
-    redasm/formats/pe/pe_debug.h \
-    redasm/formats/pe/pe_common.h \
     themeprovider.h \
     widgets/graphview/graphitems/graphitem.h \
     widgets/graphview/graphitems/graphtextitem.h \
     widgets/graphview/graphview.h \
     widgets/graphview/graphviewprivate.h \
-    redasm/formats/elf/elf_analyzer.h \
-    redasm/disassembler/disassemblerapi.h \
-    redasm/formats/pe/dotnet/dotnet_header.h \
-    redasm/assemblers/cil/cil.h \
-    redasm/formats/pe/dotnet/dotnet.h \
-    redasm/formats/pe/dotnet/dotnet_tables.h \
-    redasm/formats/pe/dotnet/dotnet_reader.h \
-    redasm/graph/graph.h \
-    redasm/graph/graph_layout.h \
-    redasm/disassembler/graph/functiongraph.h \
-    redasm/graph/vertex.h \
-    redasm/support/genetic.h \
-    redasm/graph/graph_genetic.h \
-    redasm/disassembler/graph/callgraph.h \
     dialogs/callgraphdialog.h \
     widgets/callgraphview/callgraphview.h \
     widgets/callgraphview/callgraphitem.h \
     widgets/graphview/graphviewmetrics.h \
-    redasm/formats/xbe/xbe.h \
-    redasm/formats/xbe/xbe_header.h \
-    redasm/support/ordinals.h \
-    redasm/formats/gba/gba.h \
-    redasm/formats/gba/gba_analyzer.h \
-    redasm/assemblers/metaarm/metaarm.h \
-    redasm/assemblers/metaarm/metaarm_printer.h \
-    redasm/assemblers/metaarm/metaarm_emulator.h \
-    redasm/assemblers/metaarm/arm.h \
-    redasm/assemblers/metaarm/armthumb.h \
-    redasm/assemblers/metaarm/arm_common.h
+    widgets/listingtextview/listingrenderer.h \
+    widgets/listingtextview/listingtextview.h
 
 FORMS    += mainwindow.ui \
     widgets/disassemblerview/disassemblerview.ui \
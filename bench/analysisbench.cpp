@@ -0,0 +1,403 @@
+#include "analysisbench.h"
+#include "pegenerator.h"
+#include "elfgenerator.h"
+#include "dexgenerator.h"
+#include "x86generator.h"
+#include "../redasm/disassembler/disassembler.h"
+#include "../redasm/disassembler/graph/functiongraph.h"
+#include "../redasm/formats/binary/binary.h"
+#include "../redasm/support/batch.h"
+#include <json.hpp>
+#include <functional>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <limits>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#define ANALYSIS_FUNCTIONS      2000       // Synthetic inputs, multiplied by the runner's scale
+#define ANALYSIS_RAW_BASE       0x00400000
+#define ANALYSIS_MAX_ITERATIONS 100
+
+namespace AnalysisPhases {
+    enum: u32 { Load = 0, Exploration, Strings, Code, Dataflow, Analyzer, Sort, Signatures, GraphBuild, GraphLayout, Count };
+}
+
+static const char* PHASE_NAMES[] = { "load", "exploration", "strings", "code", "dataflow", "analyzer", "sort",
+                                     "signatures", "graph-build", "graph-layout" };
+
+static const u32 PASS_PHASES[] = { AnalysisPhases::Count, // PassTypes::None, never pending
+                                   AnalysisPhases::Strings, AnalysisPhases::Code, AnalysisPhases::Dataflow,
+                                   AnalysisPhases::Analyzer, AnalysisPhases::Sort };
+
+using json = nlohmann::json;
+
+struct AnalysisCorpus
+{
+    AnalysisCorpus(): bits(0), baseaddress(0) { }
+
+    std::vector<u8> data;
+    std::string assembler; // Raw binaries only, formats are probed otherwise
+    u32 bits;
+    address_t baseaddress;
+};
+
+struct AnalysisRun { double phases[AnalysisPhases::Count]; u64 instructions; };
+
+typedef std::function<bool(AnalysisCorpus&)> CorpusLoader;
+
+static double elapsedSince(const std::chrono::steady_clock::time_point& start) { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); }
+
+static bool analysisEnabled(const BenchmarkRunner& runner, const std::string& prefix)
+{
+    for(const char* phasename : PHASE_NAMES)
+    {
+        if(runner.enabled(prefix + phasename))
+            return true;
+    }
+
+    return runner.enabled(prefix + "total");
+}
+
+static bool analysisRun(AnalysisCorpus& corpus, AnalysisRun& run)
+{
+    std::fill(std::begin(run.phases), std::end(run.phases), 0);
+
+    auto start = std::chrono::steady_clock::now();
+    REDasm::FormatPlugin* format = NULL;
+
+    if(corpus.assembler.empty())
+    {
+        format = REDasm::getFormat(corpus.data.data(), corpus.data.size());
+
+        if(format && format->isBinary()) // Unknown format: raw binaries need an assembler
+        {
+            delete format;
+            format = NULL;
+        }
+    }
+    else
+    {
+        REDasm::BinaryFormat* binaryformat = REDasm::declareFormatPlugin<REDasm::BinaryFormat>(corpus.data.data(), corpus.data.size());
+        binaryformat->build(corpus.assembler, corpus.bits, 0, corpus.baseaddress, corpus.baseaddress, corpus.data.size());
+        format = binaryformat;
+    }
+
+    run.phases[AnalysisPhases::Load] = elapsedSince(start);
+
+    if(!format)
+        return false;
+
+    REDasm::AssemblerPlugin* assembler = REDasm::getAssembler(format->assembler());
+
+    if(!assembler)
+    {
+        delete format;
+        return false;
+    }
+
+    REDasm::Disassembler disassembler(REDasm::Buffer(corpus.data.data(), corpus.data.size()), assembler, format);
+
+    // Part of the analyzer phase: steps of the level running "signatures", the passes sharing its walk included
+    disassembler.setAnalyzerCallback([&run](const std::vector<REDasm::AnalyzerPass*>& level, double elapsed) {
+        for(const REDasm::AnalyzerPass* pass : level)
+        {
+            if(pass->name != "signatures")
+                continue;
+
+            run.phases[AnalysisPhases::Signatures] += elapsed;
+            break;
+        }
+    });
+
+    start = std::chrono::steady_clock::now();
+    disassembler.disassembleLazy(); // Reachable code, the remaining passes are stepped below
+    run.phases[AnalysisPhases::Exploration] = elapsedSince(start);
+
+    while(disassembler.hasPendingPasses())
+    {
+        u32 phase = PASS_PHASES[disassembler.currentPass()];
+        start = std::chrono::steady_clock::now();
+        disassembler.runPendingPasses(1);
+        run.phases[phase] += elapsedSince(start);
+    }
+
+    REDasm::Listing& listing = disassembler.listing();
+    run.instructions = listing.size();
+
+    std::vector<address_t> functions;
+
+    disassembler.symbolTable()->iterate(REDasm::SymbolTypes::FunctionMask, [&functions](const REDasm::SymbolPtr& symbol) -> bool {
+        functions.push_back(symbol->address);
+        return true;
+    });
+
+    for(address_t address : functions)
+    {
+        REDasm::FunctionGraph graph(listing);
+
+        start = std::chrono::steady_clock::now();
+        bool built = graph.buildBlocks(address);
+        run.phases[AnalysisPhases::GraphBuild] += elapsedSince(start);
+
+        if(!built)
+            continue;
+
+        start = std::chrono::steady_clock::now();
+        graph.layout();
+        run.phases[AnalysisPhases::GraphLayout] += elapsedSince(start);
+    }
+
+    return true;
+}
+
+static bool analysisMeasure(const BenchmarkRunner& runner, const std::string& name, const CorpusLoader& loader, std::vector<BenchmarkResult>& results)
+{
+    AnalysisCorpus corpus;
+
+    if(!loader(corpus))
+    {
+        std::cerr << "Cannot load corpus '" << name << "'" << std::endl;
+        return false;
+    }
+
+    std::string prefix = "analysis/" + name + "/";
+    BenchmarkResult phases[AnalysisPhases::Count], total;
+    AnalysisRun run;
+    double elapsed = 0;
+
+    for(BenchmarkResult& result : phases)
+        result.best = std::numeric_limits<double>::max();
+
+    total.best = std::numeric_limits<double>::max();
+
+    while((!total.iterations || (elapsed < runner.minTime())) && (total.iterations < ANALYSIS_MAX_ITERATIONS))
+    {
+        if(!analysisRun(corpus, run))
+        {
+            std::cerr << "Cannot analyze corpus '" << name << "'" << std::endl;
+            return false;
+        }
+
+        double analysis = 0; // Load to sort: the work a full disassemble() does, signatures are already in the analyzer phase
+
+        for(u32 i = 0; i < AnalysisPhases::Count; i++)
+        {
+            phases[i].best = std::min(phases[i].best, run.phases[i]);
+            phases[i].mean += run.phases[i];
+            elapsed += run.phases[i];
+
+            if(i <= AnalysisPhases::Sort)
+                analysis += run.phases[i];
+        }
+
+        total.best = std::min(total.best, analysis);
+        total.mean += analysis;
+        total.iterations++;
+    }
+
+    for(u32 i = 0; i < AnalysisPhases::Count; i++)
+    {
+        BenchmarkResult& result = phases[i];
+        result.name = prefix + PHASE_NAMES[i];
+        result.iterations = total.iterations;
+        result.mean /= total.iterations;
+        results.push_back(result);
+    }
+
+    total.name = prefix + "total";
+    total.items = run.instructions; // Instructions/s
+    total.mean /= total.iterations;
+    results.push_back(total);
+    return true;
+}
+
+#ifndef _WIN32
+static bool analysisProcess(const BenchmarkRunner& runner, const std::string& name, const CorpusLoader& loader, std::vector<BenchmarkResult>& results, u64& peakrss)
+{
+    int fds[2];
+
+    if(pipe(fds) != 0)
+    {
+        std::cerr << "Cannot run corpus '" << name << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    pid_t pid = fork();
+
+    if(!pid) // Worker: the corpus is loaded here too, report through the pipe and skip parent's atexit handlers
+    {
+        close(fds[0]);
+
+        if(!analysisMeasure(runner, name, loader, results))
+            _exit(1);
+
+        json report = json::array();
+
+        for(const BenchmarkResult& result : results)
+        {
+            report.push_back({ { "name", result.name }, { "iterations", result.iterations }, { "items", result.items },
+                               { "best_ms", result.best }, { "mean_ms", result.mean } });
+        }
+
+        std::string serialized = report.dump();
+
+        for(size_t i = 0; i < serialized.size(); ) // Larger than the pipe's buffer: the parent is reading
+        {
+            ssize_t n = write(fds[1], serialized.c_str() + i, serialized.size() - i);
+
+            if(n < 0)
+                _exit(2);
+
+            i += n;
+        }
+
+        close(fds[1]);
+        _exit(0);
+    }
+
+    close(fds[1]);
+
+    if(pid < 0)
+    {
+        std::cerr << "Cannot run corpus '" << name << "': " << std::strerror(errno) << std::endl;
+        close(fds[0]);
+        return false;
+    }
+
+    std::string report;
+    char buffer[4096];
+    ssize_t n = 0;
+
+    while((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+        report.append(buffer, n);
+
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage;
+
+    while(wait4(pid, &status, 0, &usage) < 0)
+    {
+        if(errno != EINTR)
+            return false;
+    }
+
+    if(!WIFEXITED(status) || WEXITSTATUS(status)) // Errors are printed by the worker
+    {
+        if(WIFSIGNALED(status))
+            std::cerr << "Corpus '" << name << "' crashed with signal " << WTERMSIG(status) << std::endl;
+
+        return false;
+    }
+
+    try
+    {
+        for(const json& jresult : json::parse(report))
+        {
+            BenchmarkResult result;
+            result.name = jresult.at("name").get<std::string>();
+            result.iterations = jresult.at("iterations").get<u64>();
+            result.items = jresult.at("items").get<u64>();
+            result.best = jresult.at("best_ms").get<double>();
+            result.mean = jresult.at("mean_ms").get<double>();
+            results.push_back(result);
+        }
+    }
+    catch(...)
+    {
+        std::cerr << "Invalid report for corpus '" << name << "'" << std::endl;
+        return false;
+    }
+
+    peakrss = usage.ru_maxrss;
+    return !results.empty();
+}
+#endif
+
+static void analysisCorpus(BenchmarkRunner& runner, const std::string& name, const CorpusLoader& loader)
+{
+    if(!analysisEnabled(runner, "analysis/" + name + "/"))
+        return;
+
+    std::vector<BenchmarkResult> results;
+    u64 peakrss = 0;
+
+#ifdef _WIN32
+    if(!analysisMeasure(runner, name, loader, results))
+        return;
+
+    peakrss = REDasm::Batch::peakRSS(); // No fork(): the process' high-water mark, earlier corpora included
+#else
+    if(!analysisProcess(runner, name, loader, results, peakrss)) // Its own process: an absolute peak for each corpus
+        return;
+#endif
+
+    results.back().peakrss = peakrss; // Total
+
+    for(const BenchmarkResult& result : results)
+    {
+        if(runner.enabled(result.name))
+            runner.record(result);
+    }
+}
+
+static bool loadFile(const std::string& filename, AnalysisCorpus& corpus)
+{
+    std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+
+    if(!ifs.is_open())
+        return false;
+
+    corpus.data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    return !corpus.data.empty();
+}
+
+void analysisBenchmarks(BenchmarkRunner &runner)
+{
+    u32 functions = ANALYSIS_FUNCTIONS * runner.scale();
+    std::string size = std::to_string(functions);
+
+    analysisCorpus(runner, "pe/" + size, [functions](AnalysisCorpus& corpus) -> bool {
+        corpus.data = PEGenerator::executable(functions);
+        return true;
+    });
+
+    analysisCorpus(runner, "elf/" + size, [functions](AnalysisCorpus& corpus) -> bool {
+        corpus.data = ELFGenerator::executable(functions);
+        return true;
+    });
+
+    analysisCorpus(runner, "dex/" + std::to_string(std::min<u32>(functions, DEXGEN_MAX_METHODS)), [functions](AnalysisCorpus& corpus) -> bool {
+        corpus.data = DEXGenerator::dex(functions);
+        return true;
+    });
+
+    analysisCorpus(runner, "raw/" + size, [functions](AnalysisCorpus& corpus) -> bool { // Code, then strings
+        u32 stringsaddress = ANALYSIS_RAW_BASE + (functions * X86GEN_FUNCTION_SIZE);
+        std::vector<u8> strings = X86Generator::strings(functions);
+
+        corpus.data = X86Generator::code(functions, ANALYSIS_RAW_BASE, stringsaddress);
+        corpus.data.insert(corpus.data.end(), strings.begin(), strings.end());
+        corpus.assembler = "x86_32";
+        corpus.bits = 32;
+        corpus.baseaddress = ANALYSIS_RAW_BASE;
+        return true;
+    });
+
+    for(const std::string& filename : runner.corpora())
+    {
+        size_t idx = filename.find_last_of("/\\");
+
+        analysisCorpus(runner, "file/" + ((idx != std::string::npos) ? filename.substr(idx + 1) : filename), [&filename](AnalysisCorpus& corpus) -> bool {
+            return loadFile(filename, corpus);
+        });
+    }
+}
@@ -0,0 +1,8 @@
+#ifndef ANALYSISBENCH_H
+#define ANALYSISBENCH_H
+
+#include "benchmarkrunner.h"
+
+void analysisBenchmarks(BenchmarkRunner& runner);
+
+#endif // ANALYSISBENCH_H
@@ -0,0 +1,37 @@
+#-------------------------------------------------
+#
+# Micro benchmarks, built on redasm/ only
+#
+#-------------------------------------------------
+
+CONFIG   += console c++11
+CONFIG   -= qt app_bundle
+
+TARGET = redasm-bench
+TEMPLATE = app
+
+include(../depends/depends.pri)
+include(../redasm/redasm.pri)
+
+SOURCES += main.cpp \
+    benchmarkrunner.cpp \
+    pegenerator.cpp \
+    pebench.cpp \
+    chip8generator.cpp \
+    vmilbench.cpp \
+    listingbench.cpp \
+    x86generator.cpp \
+    elfgenerator.cpp \
+    dexgenerator.cpp \
+    analysisbench.cpp
+
+HEADERS += benchmarkrunner.h \
+    pegenerator.h \
+    pebench.h \
+    chip8generator.h \
+    vmilbench.h \
+    listingbench.h \
+    x86generator.h \
+    elfgenerator.h \
+    dexgenerator.h \
+    analysisbench.h
@@ -0,0 +1,185 @@
+#include "benchmarkrunner.h"
+#include <json.hpp>
+#include <unordered_map>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <limits>
+
+#define BENCHMARK_MAX_ITERATIONS 100000
+#define BENCHMARK_COMPARE_FLOOR  0.05 // Milliseconds: smaller slowdowns are timer noise
+#define BENCHMARK_RSS_FLOOR      1024 // KB: smaller growths are allocator noise
+
+using json = nlohmann::json;
+
+BenchmarkRunner::BenchmarkRunner(const std::vector<std::string> &filters, double mintime, u32 scale): _filters(filters), _mintime(mintime), _scale(scale ? scale : 1) { }
+
+bool BenchmarkRunner::enabled(const std::string &name) const
+{
+    if(this->_filters.empty())
+        return true;
+
+    for(const std::string& filter : this->_filters)
+    {
+        if(name.find(filter) != std::string::npos)
+            return true;
+    }
+
+    return false;
+}
+
+double BenchmarkRunner::minTime() const { return this->_mintime; }
+u32 BenchmarkRunner::scale() const { return this->_scale; }
+const std::vector<std::string> &BenchmarkRunner::corpora() const { return this->_corpora; }
+void BenchmarkRunner::addCorpus(const std::string &filename) { this->_corpora.push_back(filename); }
+
+void BenchmarkRunner::run(const std::string &name, const Body &body, u64 items)
+{
+    if(!this->enabled(name))
+        return;
+
+    BenchmarkResult result;
+    result.name = name;
+    result.items = items;
+    result.best = std::numeric_limits<double>::max();
+
+    double total = 0;
+
+    while((total < this->_mintime) && (result.iterations < BENCHMARK_MAX_ITERATIONS))
+    {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        result.best = std::min(result.best, elapsed);
+        total += elapsed;
+        result.iterations++;
+    }
+
+    result.mean = total / result.iterations;
+    this->record(result);
+}
+
+void BenchmarkRunner::record(const BenchmarkResult &result)
+{
+    std::cout << std::left << std::setw(40) << result.name << std::right
+              << std::setw(8) << result.iterations << " iter"
+              << std::fixed << std::setprecision(4)
+              << std::setw(12) << result.best << " ms best"
+              << std::setw(12) << result.mean << " ms mean";
+
+    if(result.items)
+        std::cout << std::setprecision(0) << std::setw(14) << (result.items * 1000.0 / result.best) << " items/s";
+
+    if(result.peakrss)
+        std::cout << std::setw(10) << result.peakrss << " KB peak RSS";
+
+    std::cout << std::endl;
+
+    this->_results.push_back(result);
+}
+
+const std::vector<BenchmarkResult> &BenchmarkRunner::results() const { return this->_results; }
+
+bool BenchmarkRunner::writeJson(const std::string &filename) const
+{
+    json results = json::array();
+
+    for(const BenchmarkResult& result : this->_results)
+    {
+        json jresult = { { "name", result.name },
+                         { "iterations", result.iterations },
+                         { "best_ms", result.best },
+                         { "mean_ms", result.mean } };
+
+        if(result.items)
+        {
+            jresult["items"] = result.items;
+            jresult["items_per_s"] = result.items * 1000.0 / result.best;
+        }
+
+        if(result.peakrss)
+            jresult["peak_rss_kb"] = result.peakrss;
+
+        results.push_back(jresult);
+    }
+
+    std::ofstream ofs(filename, std::ios::out | std::ios::trunc);
+
+    if(!ofs.is_open())
+        return false;
+
+    ofs << json({ { "scale", this->_scale }, { "min_time_ms", this->_mintime }, { "results", results } }).dump(2) << std::endl;
+    return true;
+}
+
+bool BenchmarkRunner::compare(const std::string &filename, double threshold, size_t &regressions) const
+{
+    std::ifstream ifs(filename);
+    regressions = 0;
+
+    if(!ifs.is_open())
+    {
+        std::cerr << "Cannot read baseline '" << filename << "'" << std::endl;
+        return false;
+    }
+
+    std::unordered_map<std::string, BenchmarkResult> baselinemap;
+
+    try
+    {
+        json baseline;
+        ifs >> baseline;
+
+        for(const json& jresult : baseline.at("results"))
+        {
+            BenchmarkResult& result = baselinemap[jresult.at("name").get<std::string>()];
+            result.best = jresult.at("best_ms").get<double>();
+            result.peakrss = jresult.value("peak_rss_kb", u64(0));
+        }
+    }
+    catch(...)
+    {
+        std::cerr << "Invalid baseline '" << filename << "'" << std::endl;
+        return false;
+    }
+
+    for(const BenchmarkResult& result : this->_results)
+    {
+        auto it = baselinemap.find(result.name);
+
+        if(it == baselinemap.end())
+            continue;
+
+        const BenchmarkResult& baseline = it->second;
+
+        if(baseline.best > 0)
+        {
+            double delta = ((result.best / baseline.best) - 1.0) * 100.0;
+
+            if((delta > threshold) && ((result.best - baseline.best) >= BENCHMARK_COMPARE_FLOOR))
+            {
+                std::cerr << "REGRESSION " << result.name << ": " << std::fixed << std::setprecision(4) << baseline.best << " ms -> "
+                          << result.best << " ms (+" << std::setprecision(1) << delta << "%)" << std::endl;
+
+                regressions++;
+            }
+        }
+
+        if(baseline.peakrss && result.peakrss)
+        {
+            double delta = ((static_cast<double>(result.peakrss) / baseline.peakrss) - 1.0) * 100.0;
+
+            if((delta > threshold) && (result.peakrss >= (baseline.peakrss + BENCHMARK_RSS_FLOOR)))
+            {
+                std::cerr << "REGRESSION " << result.name << ": " << baseline.peakrss << " KB -> " << result.peakrss
+                          << " KB peak RSS (+" << std::fixed << std::setprecision(1) << delta << "%)" << std::endl;
+
+                regressions++;
+            }
+        }
+    }
+
+    return true;
+}
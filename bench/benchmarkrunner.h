@@ -0,0 +1,46 @@
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "../redasm/redasm.h"
+
+struct BenchmarkResult
+{
+    BenchmarkResult(): iterations(0), items(0), peakrss(0), best(0), mean(0) { }
+
+    std::string name;
+    u64 iterations, items; // Items processed by each iteration, if any
+    u64 peakrss;           // KB, peak RSS of the process that ran it (pages a forked worker inherited included), if measured
+    double best, mean;     // Milliseconds
+};
+
+class BenchmarkRunner // Repeats a body until 'mintime' has elapsed, the best run is the least noisy one
+{
+    public:
+        typedef std::function<void()> Body;
+
+    public:
+        BenchmarkRunner(const std::vector<std::string>& filters, double mintime, u32 scale = 1);
+        bool enabled(const std::string& name) const;
+        double minTime() const;
+        u32 scale() const;
+        const std::vector<std::string>& corpora() const;
+        void addCorpus(const std::string& filename);
+        void run(const std::string& name, const Body& body, u64 items = 0);
+        void record(const BenchmarkResult& result); // Suites that time themselves
+        const std::vector<BenchmarkResult>& results() const;
+        bool writeJson(const std::string& filename) const;
+        bool compare(const std::string& filename, double threshold, size_t& regressions) const; // Against a previous writeJson()
+
+    private:
+        std::vector<std::string> _filters, _corpora;
+        std::vector<BenchmarkResult> _results;
+        double _mintime;
+        u32 _scale; // Synthetic inputs' size multiplier
+};
+
+typedef void (*BenchmarkSuite)(BenchmarkRunner&);
+
+#endif // BENCHMARKRUNNER_H
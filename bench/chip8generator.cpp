@@ -0,0 +1,30 @@
+#include "chip8generator.h"
+
+static const u16 STRAIGHT_LINE[] = { 0x6000, 0x7000, 0x8001, 0x8002, 0x8003, 0x8004,
+                                     0x8005, 0x8006, 0x800E, 0xA000, 0xF033 };
+
+CHIP8Generator::CHIP8Generator() { }
+
+std::vector<u8> CHIP8Generator::straightLine(u32 instructions)
+{
+    std::vector<u8> program;
+    program.reserve(instructions * sizeof(u16));
+
+    for(u32 i = 0; i < instructions; i++)
+    {
+        u16 opcode = STRAIGHT_LINE[i % (sizeof(STRAIGHT_LINE) / sizeof(u16))];
+        u16 x = i % 0xF, y = (i + 1) % 0xF; // VF is the flag register, leave it alone
+
+        if((opcode & 0xF000) == 0x8000)
+            opcode |= (x << 8) | (y << 4);
+        else if((opcode & 0xF000) == 0xA000)
+            opcode |= CHIP8GEN_BASE_ADDRESS + (i & 0xFF);
+        else
+            opcode |= (x << 8) | ((opcode & 0xF000) == 0xF000 ? 0 : (i & 0xFF));
+
+        program.push_back(opcode >> 8); // Big endian
+        program.push_back(opcode & 0xFF);
+    }
+
+    return program;
+}
@@ -0,0 +1,18 @@
+#ifndef CHIP8GENERATOR_H
+#define CHIP8GENERATOR_H
+
+#include <vector>
+#include "../redasm/redasm.h"
+
+#define CHIP8GEN_BASE_ADDRESS 0x200
+
+class CHIP8Generator // Synthetic CHIP-8 programs, loaded at CHIP8GEN_BASE_ADDRESS
+{
+    private:
+        CHIP8Generator();
+
+    public:
+        static std::vector<u8> straightLine(u32 instructions); // No branches: ALU, register transfers and BCD
+};
+
+#endif // CHIP8GENERATOR_H
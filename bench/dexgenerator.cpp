@@ -0,0 +1,170 @@
+#include "dexgenerator.h"
+#include "../redasm/formats/dex/dex_header.h"
+#include <cstring>
+
+#define DEXGEN_VERSION      "035"
+#define DEXGEN_ACC_PUBLIC   0x1
+#define DEXGEN_ACC_STATIC   0x8
+#define DEXGEN_CODE_UNITS   9
+
+using namespace REDasm;
+
+template<typename T> static T* at(std::vector<u8>& image, u32 offset) { return reinterpret_cast<T*>(image.data() + offset); }
+
+DEXGenerator::DEXGenerator() { }
+
+std::vector<u8> DEXGenerator::dex(u32 methods)
+{
+    methods = std::max<u32>(1, std::min<u32>(methods, DEXGEN_MAX_METHODS));
+
+    u32 classes = (methods + DEXGEN_CLASS_METHODS - 1) / DEXGEN_CLASS_METHODS;
+    u32 strings = 1 + classes + (methods * 2); // "V", class descriptors, method names and literals
+    u32 types = 1 + classes;                   // void, classes
+
+    // Strings: [0] "V", [1, classes] descriptors, then names and literals interleaved
+    auto classstring = [](u32 c) -> u32 { return 1 + c; };
+    auto namestring = [classes](u32 m) -> u32 { return 1 + classes + (m * 2); };
+    auto literalstring = [classes](u32 m) -> u32 { return 2 + classes + (m * 2); };
+
+    u32 offset = sizeof(DEXHeader);
+    u32 stringidsoff = offset;
+    offset += strings * sizeof(DEXStringIdItem);
+    u32 typeidsoff = offset;
+    offset += types * sizeof(DEXTypeIdItem);
+    u32 protoidsoff = offset;
+    offset += sizeof(DEXProtoIdItem);
+    u32 methodidsoff = offset;
+    offset += methods * sizeof(DEXMethodIdItem);
+    u32 classdefsoff = offset;
+    offset += classes * sizeof(DEXClassIdItem);
+
+    u32 dataoff = offset;
+    std::vector<u8> data;
+    std::vector<u32> stringoffsets(strings), codeoffsets(methods), classdataoffsets(classes);
+
+    for(u32 m = 0; m < methods; m++) // Code items first: they are 4 byte aligned
+    {
+        codeoffsets[m] = dataoff + data.size();
+
+        u16 next = static_cast<u16>(std::min(m + 1, methods - 1));
+        u16 literal = static_cast<u16>(literalstring(m));
+        u16 code[] = { 1, 0, 1, 0, 0, 0, DEXGEN_CODE_UNITS, 0,                      // registers, ins, outs, tries, debug info, size
+                       0x001A, literal,                                              // const-string v0, literal
+                       0x1071, next, 0x0000,                                         // invoke-static {v0}, next method
+                       0x0038, 0x0003,                                               // if-eqz v0, +3
+                       0x0000,                                                       // nop
+                       0x000E };                                                     // return-void
+
+        data.insert(data.end(), reinterpret_cast<u8*>(code), reinterpret_cast<u8*>(code) + sizeof(code));
+        data.resize(REDasm::aligned(data.size(), sizeof(u32)), 0);
+    }
+
+    for(u32 c = 0; c < classes; c++)
+    {
+        u32 first = c * DEXGEN_CLASS_METHODS, last = std::min(methods, first + DEXGEN_CLASS_METHODS);
+        classdataoffsets[c] = dataoff + data.size();
+
+        DEXGenerator::uleb128(data, 0); // Static fields
+        DEXGenerator::uleb128(data, 0); // Instance fields
+        DEXGenerator::uleb128(data, last - first);
+        DEXGenerator::uleb128(data, 0); // Virtual methods
+
+        for(u32 m = first; m < last; m++)
+        {
+            DEXGenerator::uleb128(data, (m == first) ? m : 1); // Index difference
+            DEXGenerator::uleb128(data, DEXGEN_ACC_PUBLIC | DEXGEN_ACC_STATIC);
+            DEXGenerator::uleb128(data, codeoffsets[m]);
+        }
+    }
+
+    stringoffsets[0] = dataoff + data.size();
+    DEXGenerator::string(data, "V");
+
+    for(u32 c = 0; c < classes; c++)
+    {
+        stringoffsets[classstring(c)] = dataoff + data.size();
+        DEXGenerator::string(data, "Lsynthetic/Class" + std::to_string(c) + ";");
+    }
+
+    for(u32 m = 0; m < methods; m++)
+    {
+        stringoffsets[namestring(m)] = dataoff + data.size();
+        DEXGenerator::string(data, "method" + std::to_string(m));
+        stringoffsets[literalstring(m)] = dataoff + data.size();
+        DEXGenerator::string(data, "Synthetic string #" + std::to_string(m));
+    }
+
+    std::vector<u8> image(dataoff, 0);
+    image.insert(image.end(), data.begin(), data.end());
+
+    DEXHeader* header = at<DEXHeader>(image, 0);
+    std::memcpy(header->magic, "dex\n" DEXGEN_VERSION, sizeof(header->magic));
+    header->file_size = image.size();
+    header->header_size = sizeof(DEXHeader);
+    header->endian_tag = DEX_ENDIAN_CONSTANT;
+    header->string_ids_size = strings;
+    header->string_ids_off = stringidsoff;
+    header->type_ids_size = types;
+    header->type_ids_off = typeidsoff;
+    header->proto_ids_size = 1;
+    header->proto_ids_off = protoidsoff;
+    header->method_ids_size = methods;
+    header->method_ids_off = methodidsoff;
+    header->class_defs_size = classes;
+    header->class_defs_off = classdefsoff;
+    header->data_size = data.size();
+    header->data_off = dataoff;
+
+    DEXStringIdItem* stringids = at<DEXStringIdItem>(image, stringidsoff);
+
+    for(u32 i = 0; i < strings; i++)
+        stringids[i].string_data_off = stringoffsets[i];
+
+    DEXTypeIdItem* typeids = at<DEXTypeIdItem>(image, typeidsoff);
+    typeids[0].descriptor_idx = 0;
+
+    for(u32 c = 0; c < classes; c++)
+        typeids[1 + c].descriptor_idx = classstring(c);
+
+    DEXProtoIdItem* protoid = at<DEXProtoIdItem>(image, protoidsoff); // ()V, shared by every method
+    protoid->shorty_idx = protoid->return_type_idx = 0;
+
+    DEXMethodIdItem* methodids = at<DEXMethodIdItem>(image, methodidsoff);
+
+    for(u32 m = 0; m < methods; m++)
+    {
+        methodids[m].class_idx = static_cast<u16>(1 + (m / DEXGEN_CLASS_METHODS));
+        methodids[m].proto_idx = 0;
+        methodids[m].name_idx = namestring(m);
+    }
+
+    DEXClassIdItem* classdefs = at<DEXClassIdItem>(image, classdefsoff);
+
+    for(u32 c = 0; c < classes; c++)
+    {
+        classdefs[c].class_idx = 1 + c;
+        classdefs[c].access_flags = DEXGEN_ACC_PUBLIC;
+        classdefs[c].superclass_idx = classdefs[c].source_file_idx = DEX_NO_INDEX_U;
+        classdefs[c].class_data_off = classdataoffsets[c];
+    }
+
+    return image;
+}
+
+void DEXGenerator::uleb128(std::vector<u8> &data, u32 value)
+{
+    do
+    {
+        u8 b = value & 0x7F;
+        value >>= 7;
+        data.push_back(value ? (b | 0x80) : b);
+    }
+    while(value);
+}
+
+void DEXGenerator::string(std::vector<u8> &data, const std::string &s)
+{
+    DEXGenerator::uleb128(data, s.size()); // ASCII only: UTF-16 length is the same
+    data.insert(data.end(), s.begin(), s.end());
+    data.push_back(0);
+}
@@ -0,0 +1,23 @@
+#ifndef DEXGENERATOR_H
+#define DEXGENERATOR_H
+
+#include <vector>
+#include "../redasm/redasm.h"
+
+#define DEXGEN_CLASS_METHODS 16
+#define DEXGEN_MAX_METHODS   0x7000 // String indices are 16 bit wide in 'const-string'
+
+class DEXGenerator // Synthetic DEX files: static methods with a string, a call and a branch each
+{
+    private:
+        DEXGenerator();
+
+    public:
+        static std::vector<u8> dex(u32 methods);
+
+    private:
+        static void uleb128(std::vector<u8>& data, u32 value);
+        static void string(std::vector<u8>& data, const std::string& s);
+};
+
+#endif // DEXGENERATOR_H
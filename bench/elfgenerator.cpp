@@ -0,0 +1,124 @@
+#include "elfgenerator.h"
+#include "x86generator.h"
+#include "../redasm/formats/elf/elf32_header.h"
+#include <cstring>
+
+#define ELFGEN_BASE_ADDRESS  0x08048000
+#define ELFGEN_ALIGNMENT     0x1000
+#define ELFGEN_TEXT_OFFSET   ELFGEN_ALIGNMENT
+#define ELFGEN_ET_EXEC       2
+#define ELFGEN_SYMBOL_STRIDE 3
+
+using namespace REDasm;
+
+namespace ELFGenSections {
+    enum: u32 { Null = 0, Text, RoData, SymTab, StrTab, ShStrTab, Count };
+}
+
+static const char SECTION_NAMES[] = "\0.text\0.rodata\0.symtab\0.strtab\0.shstrtab";
+static const u32 SECTION_NAME_OFFSETS[] = { 0, 1, 7, 15, 23, 31 };
+
+template<typename T> static T* at(std::vector<u8>& image, u32 offset) { return reinterpret_cast<T*>(image.data() + offset); }
+
+ELFGenerator::ELFGenerator() { }
+
+std::vector<u8> ELFGenerator::executable(u32 functions)
+{
+    functions = std::max<u32>(functions, 1);
+
+    std::vector<Elf32_Sym> symbols(1); // Null symbol
+    std::string strtab(1, '\0');
+
+    for(u32 i = 1; i < functions; i += ELFGEN_SYMBOL_STRIDE) // Locals first, reachable or not
+    {
+        Elf32_Sym sym = { };
+        sym.st_name = strtab.size();
+        sym.st_value = ELFGEN_BASE_ADDRESS + ELFGEN_TEXT_OFFSET + (i * X86GEN_FUNCTION_SIZE);
+        sym.st_size = X86GEN_FUNCTION_SIZE;
+        sym.st_info = ELF_ST_INFO(STB_LOCAL, STT_FUNC);
+        sym.st_shndx = ELFGenSections::Text;
+        symbols.push_back(sym);
+
+        strtab += "function_" + std::to_string(i);
+        strtab.push_back('\0');
+    }
+
+    u32 firstglobal = symbols.size();
+    Elf32_Sym start = { };
+    start.st_name = strtab.size();
+    start.st_value = ELFGEN_BASE_ADDRESS + ELFGEN_TEXT_OFFSET;
+    start.st_size = X86GEN_FUNCTION_SIZE;
+    start.st_info = ELF_ST_INFO(STB_GLOBAL, STT_FUNC);
+    start.st_shndx = ELFGenSections::Text;
+    symbols.push_back(start);
+    strtab.append("_start", sizeof("_start"));
+
+    u32 textsize = functions * X86GEN_FUNCTION_SIZE;
+    u32 rodataoffset = REDasm::aligned(ELFGEN_TEXT_OFFSET + textsize, ELFGEN_ALIGNMENT);
+    u32 rodatasize = functions * X86GEN_STRING_SIZE;
+    u32 symtaboffset = REDasm::aligned(rodataoffset + rodatasize, sizeof(u32));
+    u32 symtabsize = symbols.size() * sizeof(Elf32_Sym);
+    u32 strtaboffset = symtaboffset + symtabsize;
+    u32 shstrtaboffset = strtaboffset + strtab.size();
+    u32 shoffset = REDasm::aligned(shstrtaboffset + sizeof(SECTION_NAMES), sizeof(u32));
+
+    std::vector<u8> image(shoffset + (ELFGenSections::Count * sizeof(Elf32_Shdr)), 0);
+    std::vector<u8> code = X86Generator::code(functions, ELFGEN_BASE_ADDRESS + ELFGEN_TEXT_OFFSET, ELFGEN_BASE_ADDRESS + rodataoffset);
+    std::vector<u8> strings = X86Generator::strings(functions);
+    std::copy(code.begin(), code.end(), image.begin() + ELFGEN_TEXT_OFFSET);
+    std::copy(strings.begin(), strings.end(), image.begin() + rodataoffset);
+    std::memcpy(image.data() + symtaboffset, symbols.data(), symtabsize);
+    std::memcpy(image.data() + strtaboffset, strtab.data(), strtab.size());
+    std::memcpy(image.data() + shstrtaboffset, SECTION_NAMES, sizeof(SECTION_NAMES));
+
+    Elf32_Ehdr* ehdr = at<Elf32_Ehdr>(image, 0);
+    ehdr->e_ident[EI_MAG0] = ELFMAG0;
+    ehdr->e_ident[EI_MAG1] = ELFMAG1;
+    ehdr->e_ident[EI_MAG2] = ELFMAG2;
+    ehdr->e_ident[EI_MAG3] = ELFMAG3;
+    ehdr->e_ident[EI_CLASS] = ELFCLASS32;
+    ehdr->e_ident[EI_DATA] = 1; // Little endian
+    ehdr->e_ident[EI_VERSION] = EV_CURRENT;
+    ehdr->e_type = ELFGEN_ET_EXEC;
+    ehdr->e_machine = EM_386;
+    ehdr->e_version = EV_CURRENT;
+    ehdr->e_entry = start.st_value;
+    ehdr->e_shoff = shoffset;
+    ehdr->e_ehsize = sizeof(Elf32_Ehdr);
+    ehdr->e_shentsize = sizeof(Elf32_Shdr);
+    ehdr->e_shnum = ELFGenSections::Count;
+    ehdr->e_shstrndx = ELFGenSections::ShStrTab;
+
+    Elf32_Shdr* shdr = at<Elf32_Shdr>(image, shoffset);
+
+    for(u32 i = 0; i < ELFGenSections::Count; i++)
+        shdr[i].sh_name = SECTION_NAME_OFFSETS[i];
+
+    shdr[ELFGenSections::Text].sh_type = SHT_PROGBITS;
+    shdr[ELFGenSections::Text].sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+    shdr[ELFGenSections::Text].sh_addr = ELFGEN_BASE_ADDRESS + ELFGEN_TEXT_OFFSET;
+    shdr[ELFGenSections::Text].sh_offset = ELFGEN_TEXT_OFFSET;
+    shdr[ELFGenSections::Text].sh_size = textsize;
+
+    shdr[ELFGenSections::RoData].sh_type = SHT_PROGBITS;
+    shdr[ELFGenSections::RoData].sh_flags = SHF_ALLOC;
+    shdr[ELFGenSections::RoData].sh_addr = ELFGEN_BASE_ADDRESS + rodataoffset;
+    shdr[ELFGenSections::RoData].sh_offset = rodataoffset;
+    shdr[ELFGenSections::RoData].sh_size = rodatasize;
+
+    shdr[ELFGenSections::SymTab].sh_type = SHT_SYMTAB;
+    shdr[ELFGenSections::SymTab].sh_offset = symtaboffset;
+    shdr[ELFGenSections::SymTab].sh_size = symtabsize;
+    shdr[ELFGenSections::SymTab].sh_link = ELFGenSections::StrTab;
+    shdr[ELFGenSections::SymTab].sh_info = firstglobal;
+    shdr[ELFGenSections::SymTab].sh_entsize = sizeof(Elf32_Sym);
+
+    shdr[ELFGenSections::StrTab].sh_type = SHT_STRTAB;
+    shdr[ELFGenSections::StrTab].sh_offset = strtaboffset;
+    shdr[ELFGenSections::StrTab].sh_size = strtab.size();
+
+    shdr[ELFGenSections::ShStrTab].sh_type = SHT_STRTAB;
+    shdr[ELFGenSections::ShStrTab].sh_offset = shstrtaboffset;
+    shdr[ELFGenSections::ShStrTab].sh_size = sizeof(SECTION_NAMES);
+    return image;
+}
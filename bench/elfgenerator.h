@@ -0,0 +1,16 @@
+#ifndef ELFGENERATOR_H
+#define ELFGENERATOR_H
+
+#include <vector>
+#include "../redasm/redasm.h"
+
+class ELFGenerator // Synthetic ELF32 executables: file offsets and addresses differ by a fixed base
+{
+    private:
+        ELFGenerator();
+
+    public:
+        static std::vector<u8> executable(u32 functions); // X86Generator's code and strings, every third function has a symbol
+};
+
+#endif // ELFGENERATOR_H
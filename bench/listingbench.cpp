@@ -0,0 +1,62 @@
+#include "listingbench.h"
+#include <iostream>
+#include "chip8generator.h"
+#include "../redasm/disassembler/disassembler.h"
+#include "../redasm/formats/binary/binary.h"
+#include "../redasm/assemblers/chip8/chip8.h"
+
+static void listingRun(BenchmarkRunner& runner, u32 instructions)
+{
+    std::string stringsname = "listing/export-strings/" + std::to_string(instructions);
+    std::string buffername = "listing/export/" + std::to_string(instructions);
+
+    if(!runner.enabled(stringsname) && !runner.enabled(buffername))
+        return;
+
+    std::vector<u8> program = CHIP8Generator::straightLine(instructions);
+    REDasm::BinaryFormat* format = REDasm::declareFormatPlugin<REDasm::BinaryFormat>(program.data(), program.size());
+    format->build("chip8", 16, 0, CHIP8GEN_BASE_ADDRESS, CHIP8GEN_BASE_ADDRESS, program.size());
+
+    REDasm::Disassembler disassembler(REDasm::Buffer(program.data(), program.size()), new REDasm::CHIP8Assembler(), format);
+    REDasm::PrinterPtr printer(disassembler.assembler()->createPrinter(&disassembler, disassembler.symbolTable()));
+    std::vector<REDasm::InstructionPtr> decoded;
+
+    for(u32 i = 0; i < instructions; i++)
+        decoded.push_back(disassembler.disassembleInstruction(CHIP8GEN_BASE_ADDRESS + (i * sizeof(u16))));
+
+    size_t sink = 0; // Keeps the optimizer from dropping the lines
+
+    runner.run(stringsname, [&printer, &decoded, &sink]() { // A fresh string for each piece: lines/s
+        printer->invalidate();
+
+        for(const REDasm::InstructionPtr& instruction : decoded)
+        {
+            std::string line = REDasm::hex(instruction->address, 16) + "  " + printer->out(instruction) + "\n";
+            sink += line.size();
+        }
+    }, decoded.size());
+
+    runner.run(buffername, [&printer, &decoded, &sink]() { // One reused buffer: lines/s
+        std::string line;
+        printer->invalidate();
+
+        for(const REDasm::InstructionPtr& instruction : decoded)
+        {
+            line.clear();
+            REDasm::appendhex(line, instruction->address, 16);
+            line += "  ";
+            printer->out(instruction, line);
+            line += '\n';
+            sink += line.size();
+        }
+    }, decoded.size());
+
+    if(!sink)
+        std::cerr << "Empty listing" << std::endl;
+}
+
+void listingBenchmarks(BenchmarkRunner &runner)
+{
+    listingRun(runner, 1000);
+    listingRun(runner, 10000);
+}
@@ -0,0 +1,8 @@
+#ifndef LISTINGBENCH_H
+#define LISTINGBENCH_H
+
+#include "benchmarkrunner.h"
+
+void listingBenchmarks(BenchmarkRunner& runner);
+
+#endif // LISTINGBENCH_H
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include "benchmarkrunner.h"
+#include "pebench.h"
+#include "vmilbench.h"
+#include "listingbench.h"
+#include "analysisbench.h"
+#include "../redasm/plugins/plugins.h"
+
+static const BenchmarkSuite SUITES[] = { &peBenchmarks, &vmilBenchmarks, &listingBenchmarks, &analysisBenchmarks };
+
+static void usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options] [filter...]" << std::endl
+              << "  -t, --time MS        Minimum running time of each benchmark (default: 500)" << std::endl
+              << "  -r, --runtime DIR    Runtime path, must contain 'database' (default: current directory)" << std::endl
+              << "  -s, --scale N        Size multiplier of synthetic analysis inputs (default: 1)" << std::endl
+              << "  -c, --corpus FILE    Real file for the analysis suite, can be repeated" << std::endl
+              << "  -j, --json FILE      Write results as JSON" << std::endl
+              << "  -b, --baseline FILE  Compare with a previous --json run, fail on regressions" << std::endl
+              << "  -d, --threshold PCT  Slowdown reported as regression (default: 10)" << std::endl
+              << std::endl
+              << "Benchmarks whose name contains one of the filters are run, all of them otherwise." << std::endl;
+}
+
+static bool isOption(const char* arg, const char* shortopt, const char* longopt) { return !std::strcmp(arg, shortopt) || !std::strcmp(arg, longopt); }
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> filters, corpora;
+    std::string runtimepath = ".", jsonfile, baselinefile;
+    double mintime = 500, threshold = 10;
+    u32 scale = 1;
+
+    for(int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        bool hasvalue = (i + 1) < argc;
+
+        if(isOption(arg, "-t", "--time") && hasvalue)
+            mintime = std::strtod(argv[++i], NULL);
+        else if(isOption(arg, "-r", "--runtime") && hasvalue)
+            runtimepath = argv[++i];
+        else if(isOption(arg, "-s", "--scale") && hasvalue)
+            scale = std::strtoul(argv[++i], NULL, 10);
+        else if(isOption(arg, "-c", "--corpus") && hasvalue)
+            corpora.push_back(argv[++i]);
+        else if(isOption(arg, "-j", "--json") && hasvalue)
+            jsonfile = argv[++i];
+        else if(isOption(arg, "-b", "--baseline") && hasvalue)
+            baselinefile = argv[++i];
+        else if(isOption(arg, "-d", "--threshold") && hasvalue)
+            threshold = std::strtod(argv[++i], NULL);
+        else if(isOption(arg, "-h", "--help") || (arg[0] == '-'))
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        else
+            filters.push_back(arg);
+    }
+
+    REDasm::setLoggerCallback([](const std::string&) { });
+    REDasm::init(runtimepath);
+
+    BenchmarkRunner runner(filters, mintime, scale);
+
+    for(const std::string& corpus : corpora)
+        runner.addCorpus(corpus);
+
+    for(BenchmarkSuite suite : SUITES)
+        suite(runner);
+
+    if(runner.results().empty())
+        return 1;
+
+    if(!jsonfile.empty() && !runner.writeJson(jsonfile))
+    {
+        std::cerr << "Cannot write '" << jsonfile << "'" << std::endl;
+        return 1;
+    }
+
+    size_t regressions = 0;
+
+    if(!baselinefile.empty() && !runner.compare(baselinefile, threshold, regressions))
+        return 1;
+
+    return regressions ? 2 : 0;
+}
@@ -0,0 +1,28 @@
+#include "pebench.h"
+#include "pegenerator.h"
+#include "../redasm/formats/pe/pe.h"
+
+static void peLoad(BenchmarkRunner& runner, u32 exports, u32 names)
+{
+    std::string name = "pe/exports/" + std::to_string(exports) + "/" + std::to_string(names);
+
+    if(!runner.enabled(name))
+        return;
+
+    std::vector<u8> image = PEGenerator::dll(exports, names);
+
+    runner.run(name, [&image]() {
+        REDasm::FormatPlugin* format = REDasm::declareFormatPlugin<REDasm::PeFormat>(image.data(), image.size());
+
+        if(format)
+            delete format;
+    });
+}
+
+void peBenchmarks(BenchmarkRunner &runner)
+{
+    peLoad(runner, 1000, 1000);
+    peLoad(runner, 10000, 10000);
+    peLoad(runner, 10000, 5000); // Half of them are exported by ordinal
+    peLoad(runner, 60000, 60000);
+}
@@ -0,0 +1,8 @@
+#ifndef PEBENCH_H
+#define PEBENCH_H
+
+#include "benchmarkrunner.h"
+
+void peBenchmarks(BenchmarkRunner& runner);
+
+#endif // PEBENCH_H
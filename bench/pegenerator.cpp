@@ -0,0 +1,129 @@
+#include "pegenerator.h"
+#include "../redasm/formats/pe/pe_headers.h"
+#include "../redasm/formats/pe/pe_constants.h"
+#include "x86generator.h"
+#include <cstring>
+
+#define PEGEN_IMAGEBASE 0x10000000
+#define PEGEN_EXEBASE   0x00400000
+#define PEGEN_ALIGNMENT 0x1000
+#define PEGEN_TEXT_RVA  PEGEN_ALIGNMENT
+#define PEGEN_DLL_NAME  "synthetic.dll"
+
+using namespace REDasm;
+
+template<typename T> static T* at(std::vector<u8>& image, u32 offset) { return reinterpret_cast<T*>(image.data() + offset); }
+
+PEGenerator::PEGenerator() { }
+
+std::vector<u8> PEGenerator::dll(u32 exports, u32 names)
+{
+    names = std::min(names, exports);
+
+    std::vector<std::string> exportnames(names);
+    u32 stringssize = sizeof(PEGEN_DLL_NAME);
+
+    for(u32 i = 0; i < names; i++)
+    {
+        exportnames[i] = "Export_" + std::to_string(i);
+        stringssize += exportnames[i].size() + 1;
+    }
+
+    u32 textsize = REDasm::aligned(std::max<u32>(exports, 1) * sizeof(u32), PEGEN_ALIGNMENT);
+    u32 edatarva = PEGEN_TEXT_RVA + textsize;
+    u32 edatasize = sizeof(ImageExportDirectory) + (exports * sizeof(u32)) + (names * (sizeof(u32) + sizeof(u16))) + stringssize;
+    edatasize = REDasm::aligned(edatasize, PEGEN_ALIGNMENT);
+
+    std::vector<u8> image(edatarva + edatasize, 0);
+    std::memset(image.data() + PEGEN_TEXT_RVA, 0xC3, textsize); // ret
+
+    ImageNtHeaders* ntheaders = PEGenerator::headers(image, PEGEN_IMAGEBASE, 2);
+    ImageOptionalHeader32& optheader = ntheaders->OptionalHeader32;
+    optheader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].VirtualAddress = edatarva;
+    optheader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].Size = edatasize;
+
+    ImageSectionHeader* sections = IMAGE_FIRST_SECTION(ntheaders);
+    PEGenerator::section(sections[0], ".text", PEGEN_TEXT_RVA, textsize, IMAGE_SCN_CNT_CODE | IMAGE_SCN_MEM_EXECUTE | IMAGE_SCN_MEM_READ);
+    PEGenerator::section(sections[1], ".edata", edatarva, edatasize, IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ);
+
+    u32 offset = edatarva;
+    ImageExportDirectory* exportdir = at<ImageExportDirectory>(image, offset);
+    offset += sizeof(ImageExportDirectory);
+
+    exportdir->Base = 1;
+    exportdir->NumberOfFunctions = exports;
+    exportdir->NumberOfNames = names;
+    exportdir->AddressOfFunctions = offset;
+    offset += exports * sizeof(u32);
+    exportdir->AddressOfNames = offset;
+    offset += names * sizeof(u32);
+    exportdir->AddressOfNameOrdinals = offset;
+    offset += names * sizeof(u16);
+
+    for(u32 i = 0; i < exports; i++)
+        at<u32>(image, exportdir->AddressOfFunctions)[i] = PEGEN_TEXT_RVA + (i * sizeof(u32));
+
+    exportdir->Name = offset;
+    std::memcpy(image.data() + offset, PEGEN_DLL_NAME, sizeof(PEGEN_DLL_NAME));
+    offset += sizeof(PEGEN_DLL_NAME);
+
+    for(u32 i = 0; i < names; i++) // Name the last exports first: worst case for a linear ordinal scan
+    {
+        at<u32>(image, exportdir->AddressOfNames)[i] = offset;
+        at<u16>(image, exportdir->AddressOfNameOrdinals)[i] = static_cast<u16>(exports - 1 - i);
+        std::memcpy(image.data() + offset, exportnames[i].c_str(), exportnames[i].size() + 1);
+        offset += exportnames[i].size() + 1;
+    }
+
+    return image;
+}
+
+std::vector<u8> PEGenerator::executable(u32 functions)
+{
+    u32 textsize = REDasm::aligned(std::max<u32>(functions, 1) * X86GEN_FUNCTION_SIZE, PEGEN_ALIGNMENT);
+    u32 rdatarva = PEGEN_TEXT_RVA + textsize;
+    u32 rdatasize = REDasm::aligned(std::max<u32>(functions, 1) * X86GEN_STRING_SIZE, PEGEN_ALIGNMENT);
+
+    std::vector<u8> image(rdatarva + rdatasize, 0);
+    std::vector<u8> code = X86Generator::code(functions, PEGEN_EXEBASE + PEGEN_TEXT_RVA, PEGEN_EXEBASE + rdatarva);
+    std::vector<u8> strings = X86Generator::strings(functions);
+    std::copy(code.begin(), code.end(), image.begin() + PEGEN_TEXT_RVA);
+    std::copy(strings.begin(), strings.end(), image.begin() + rdatarva);
+
+    ImageNtHeaders* ntheaders = PEGenerator::headers(image, PEGEN_EXEBASE, 2);
+    ImageSectionHeader* sections = IMAGE_FIRST_SECTION(ntheaders);
+    PEGenerator::section(sections[0], ".text", PEGEN_TEXT_RVA, textsize, IMAGE_SCN_CNT_CODE | IMAGE_SCN_MEM_EXECUTE | IMAGE_SCN_MEM_READ);
+    PEGenerator::section(sections[1], ".rdata", rdatarva, rdatasize, IMAGE_SCN_CNT_INITIALIZED_DATA | IMAGE_SCN_MEM_READ);
+    return image;
+}
+
+ImageNtHeaders *PEGenerator::headers(std::vector<u8> &image, u32 imagebase, u16 sections)
+{
+    ImageDosHeader* dosheader = at<ImageDosHeader>(image, 0);
+    dosheader->e_magic = IMAGE_DOS_SIGNATURE;
+    dosheader->e_lfanew = sizeof(ImageDosHeader);
+
+    ImageNtHeaders* ntheaders = at<ImageNtHeaders>(image, dosheader->e_lfanew);
+    ntheaders->Signature = IMAGE_NT_SIGNATURE;
+    ntheaders->FileHeader.Machine = IMAGE_FILE_MACHINE_I386;
+    ntheaders->FileHeader.NumberOfSections = sections;
+    ntheaders->FileHeader.SizeOfOptionalHeader = sizeof(ImageOptionalHeader32);
+
+    ImageOptionalHeader32& optheader = ntheaders->OptionalHeader32;
+    optheader.Magic = IMAGE_NT_OPTIONAL_HDR32_MAGIC;
+    optheader.AddressOfEntryPoint = PEGEN_TEXT_RVA;
+    optheader.ImageBase = imagebase;
+    optheader.SectionAlignment = optheader.FileAlignment = PEGEN_ALIGNMENT;
+    optheader.SizeOfImage = image.size();
+    optheader.SizeOfHeaders = PEGEN_ALIGNMENT;
+    optheader.NumberOfRvaAndSizes = IMAGE_NUMBEROF_DIRECTORY_ENTRIES;
+    return ntheaders;
+}
+
+void PEGenerator::section(ImageSectionHeader &section, const char *name, u32 rva, u32 size, u32 characteristics)
+{
+    std::strncpy(reinterpret_cast<char*>(section.Name), name, IMAGE_SIZEOF_SHORT_NAME);
+    section.Misc.VirtualSize = section.SizeOfRawData = size;
+    section.VirtualAddress = section.PointerToRawData = rva;
+    section.Characteristics = characteristics;
+}
@@ -0,0 +1,22 @@
+#ifndef PEGENERATOR_H
+#define PEGENERATOR_H
+
+#include <vector>
+#include "../redasm/redasm.h"
+#include "../redasm/formats/pe/pe_headers.h"
+
+class PEGenerator // Synthetic PE32 images: file offsets and RVAs are the same
+{
+    private:
+        PEGenerator();
+
+    public:
+        static std::vector<u8> dll(u32 exports, u32 names);
+        static std::vector<u8> executable(u32 functions); // X86Generator's code and strings
+
+    private:
+        static REDasm::ImageNtHeaders* headers(std::vector<u8>& image, u32 imagebase, u16 sections);
+        static void section(REDasm::ImageSectionHeader& section, const char* name, u32 rva, u32 size, u32 characteristics);
+};
+
+#endif // PEGENERATOR_H
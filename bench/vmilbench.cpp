@@ -0,0 +1,46 @@
+#include "vmilbench.h"
+#include "chip8generator.h"
+#include "../redasm/disassembler/disassembler.h"
+#include "../redasm/formats/binary/binary.h"
+#include "../redasm/assemblers/chip8/chip8.h"
+
+static void vmilRun(BenchmarkRunner& runner, u32 instructions)
+{
+    std::string executename = "vmil/execute/" + std::to_string(instructions);
+    std::string emulatename = "vmil/emulate/" + std::to_string(instructions);
+
+    if(!runner.enabled(executename) && !runner.enabled(emulatename))
+        return;
+
+    std::vector<u8> program = CHIP8Generator::straightLine(instructions);
+    REDasm::BinaryFormat* format = REDasm::declareFormatPlugin<REDasm::BinaryFormat>(program.data(), program.size());
+    format->build("chip8", 16, 0, CHIP8GEN_BASE_ADDRESS, CHIP8GEN_BASE_ADDRESS, program.size());
+
+    REDasm::Disassembler disassembler(REDasm::Buffer(program.data(), program.size()), new REDasm::CHIP8Assembler(), format);
+    REDasm::VMIL::Emulator* emulator = disassembler.emulator();
+    REDasm::VMIL::VMILInstructionList vminstructions, translated;
+    std::vector<REDasm::InstructionPtr> decoded;
+
+    for(u32 i = 0; i < instructions; i++)
+    {
+        REDasm::InstructionPtr instruction = disassembler.disassembleInstruction(CHIP8GEN_BASE_ADDRESS + (i * sizeof(u16)));
+        emulator->translate(instruction, translated);
+        vminstructions.insert(vminstructions.end(), translated.begin(), translated.end());
+        decoded.push_back(instruction);
+    }
+
+    runner.run(executename, [emulator, &vminstructions]() { // Interpreter only: IR ops/s
+        emulator->execute(vminstructions.data(), vminstructions.size());
+    }, vminstructions.size());
+
+    runner.run(emulatename, [emulator, &decoded]() { // Translation and interpreter, as analysis does
+        for(const REDasm::InstructionPtr& instruction : decoded)
+            emulator->emulate(instruction);
+    }, vminstructions.size());
+}
+
+void vmilBenchmarks(BenchmarkRunner &runner)
+{
+    vmilRun(runner, 1000);
+    vmilRun(runner, 100000);
+}
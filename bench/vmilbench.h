@@ -0,0 +1,8 @@
+#ifndef VMILBENCH_H
+#define VMILBENCH_H
+
+#include "benchmarkrunner.h"
+
+void vmilBenchmarks(BenchmarkRunner& runner);
+
+#endif // VMILBENCH_H
@@ -0,0 +1,57 @@
+#include "x86generator.h"
+#include <cstring>
+
+static const u8 FUNCTION_PROLOGUE[] = { 0x55, 0x89, 0xE5 };                // push ebp; mov ebp, esp
+static const u8 FUNCTION_EPILOGUE[] = { 0x83, 0xC4, 0x04, 0x85, 0xC0,      // add esp, 4; test eax, eax
+                                        0x74, 0x02, 0x31, 0xC0,            // je +2; xor eax, eax
+                                        0x5D, 0xC3 };                      // pop ebp; ret
+
+X86Generator::X86Generator() { }
+
+std::vector<u8> X86Generator::code(u32 functions, address_t codeaddress, address_t stringsaddress)
+{
+    std::vector<u8> code;
+    code.reserve(functions * X86GEN_FUNCTION_SIZE);
+
+    for(u32 i = 0; i < functions; i++)
+    {
+        size_t start = code.size();
+
+        code.insert(code.end(), std::begin(FUNCTION_PROLOGUE), std::end(FUNCTION_PROLOGUE));
+        X86Generator::emit(code, 0x68, stringsaddress + (i * X86GEN_STRING_SIZE)); // push offset string
+
+        if((i + 2) < functions) // call function + 2
+        {
+            address_t nextaddress = codeaddress + code.size() + 5;
+            X86Generator::emit(code, 0xE8, codeaddress + ((i + 2) * X86GEN_FUNCTION_SIZE) - nextaddress);
+        }
+        else
+            code.insert(code.end(), 5, 0x90);
+
+        code.insert(code.end(), std::begin(FUNCTION_EPILOGUE), std::end(FUNCTION_EPILOGUE));
+        code.resize(start + X86GEN_FUNCTION_SIZE, 0); // Zero padding, skipped by the unexplored code search
+    }
+
+    return code;
+}
+
+std::vector<u8> X86Generator::strings(u32 functions)
+{
+    std::vector<u8> strings(functions * X86GEN_STRING_SIZE, 0);
+
+    for(u32 i = 0; i < functions; i++)
+    {
+        std::string s = "Synthetic string #" + std::to_string(i);
+        std::memcpy(strings.data() + (i * X86GEN_STRING_SIZE), s.c_str(), std::min<size_t>(s.size(), X86GEN_STRING_SIZE - 1));
+    }
+
+    return strings;
+}
+
+void X86Generator::emit(std::vector<u8> &code, u8 opcode, u32 operand)
+{
+    code.push_back(opcode);
+
+    for(u32 i = 0; i < sizeof(u32); i++, operand >>= 8) // Little endian
+        code.push_back(operand & 0xFF);
+}
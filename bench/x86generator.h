@@ -0,0 +1,23 @@
+#ifndef X86GENERATOR_H
+#define X86GENERATOR_H
+
+#include <vector>
+#include "../redasm/redasm.h"
+
+#define X86GEN_FUNCTION_SIZE 0x20
+#define X86GEN_STRING_SIZE   0x20
+
+class X86Generator // Synthetic x86_32 code: even functions are reachable from the first one, odd ones are left to the unexplored code search
+{
+    private:
+        X86Generator();
+
+    public:
+        static std::vector<u8> code(u32 functions, address_t codeaddress, address_t stringsaddress);
+        static std::vector<u8> strings(u32 functions); // One string for each function
+
+    private:
+        static void emit(std::vector<u8>& code, u8 opcode, u32 operand);
+};
+
+#endif // X86GENERATOR_H
@@ -0,0 +1,185 @@
+#include "batchrunner.h"
+#include "../redasm/plugins/plugins.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#define OUTPUT_EXT_JSON   ".redasm.json"
+#define OUTPUT_EXT_BINARY ".redasm.cbor"
+
+BatchRunner::BatchRunner(size_t jobs, u32 output, const std::string &outputdir): _jobs(jobs ? jobs : 1), _output(output), _outputdir(outputdir) { }
+
+void BatchRunner::run(const std::vector<std::string> &files, const ResultCallback &cb) const
+{
+    std::vector<std::string> outputfiles = this->outputFiles(files);
+
+#ifdef _WIN32
+    this->runSequential(files, outputfiles, cb); // No fork(): analyze in-process, one file at time
+#else
+    this->runProcesses(files, outputfiles, cb);
+#endif
+}
+
+std::vector<std::string> BatchRunner::outputFiles(const std::vector<std::string> &files) const
+{
+    std::vector<std::string> outputfiles;
+    std::unordered_set<std::string> used;
+    outputfiles.reserve(files.size());
+
+    for(const std::string& file : files)
+    {
+        std::string outputfile = this->outputFile(file, 0);
+
+        // With an output directory, inputs with the same name in different directories would overwrite each other:
+        // the first one keeps its name, the others get the first free '-N' suffix
+        for(size_t suffix = 2; used.find(outputfile) != used.end(); suffix++)
+            outputfile = this->outputFile(file, suffix);
+
+        used.insert(outputfile);
+        outputfiles.push_back(outputfile);
+    }
+
+    return outputfiles;
+}
+
+std::string BatchRunner::outputFile(const std::string &filename, size_t suffix) const
+{
+    std::string outputfile = filename;
+
+    if(!this->_outputdir.empty())
+    {
+        size_t idx = filename.find_last_of("/\\");
+
+        if(idx != std::string::npos)
+            outputfile = filename.substr(idx + 1);
+
+        outputfile = REDasm::makePath(this->_outputdir, outputfile);
+    }
+
+    if(suffix)
+        outputfile += "-" + std::to_string(suffix);
+
+    return outputfile + ((this->_output == REDasm::BatchOutputs::Binary) ? OUTPUT_EXT_BINARY : OUTPUT_EXT_JSON);
+}
+
+void BatchRunner::runSequential(const std::vector<std::string> &files, const std::vector<std::string> &outputfiles, const ResultCallback &cb) const
+{
+    for(size_t i = 0; i < files.size(); i++)
+    {
+        REDasm::BatchResult result;
+        REDasm::Batch::analyze(files[i], outputfiles[i], this->_output, result);
+        cb(result, REDasm::Batch::toJson(result));
+    }
+}
+
+#ifndef _WIN32
+void BatchRunner::runProcesses(const std::vector<std::string> &files, const std::vector<std::string> &outputfiles, const ResultCallback &cb) const
+{
+    struct Worker { REDasm::BatchResult result; int fd; std::chrono::steady_clock::time_point start; };
+
+    std::unordered_map<pid_t, Worker> workers;
+    size_t next = 0;
+
+    while((next < files.size()) || !workers.empty())
+    {
+        while((next < files.size()) && (workers.size() < this->_jobs))
+        {
+            const std::string& file = files[next], &outputfile = outputfiles[next];
+            next++;
+            int fds[2];
+
+            if(pipe(fds) != 0)
+            {
+                REDasm::BatchResult result;
+                result.filename = file;
+                result.error = std::strerror(errno);
+                cb(result, REDasm::Batch::toJson(result));
+                continue;
+            }
+
+            pid_t pid = fork();
+
+            if(!pid) // Worker: report through the pipe, skip parent's atexit handlers
+            {
+                close(fds[0]);
+
+                REDasm::BatchResult result;
+                REDasm::Batch::analyze(file, outputfile, this->_output, result);
+                REDasm::deinit(); // _exit() below: save what this worker demangled
+                std::string report = REDasm::Batch::toJson(result);
+
+                if(write(fds[1], report.c_str(), report.size()) < 0)
+                    _exit(2);
+
+                close(fds[1]);
+                _exit(result.success ? 0 : 1);
+            }
+
+            close(fds[1]);
+
+            Worker worker;
+            worker.result.filename = file;
+            worker.fd = fds[0];
+            worker.start = std::chrono::steady_clock::now();
+
+            if(pid < 0)
+            {
+                close(fds[0]);
+                worker.result.error = std::strerror(errno);
+                cb(worker.result, REDasm::Batch::toJson(worker.result));
+                continue;
+            }
+
+            workers[pid] = worker;
+        }
+
+        int status = 0;
+        struct rusage usage;
+        pid_t pid = wait4(-1, &status, 0, &usage);
+
+        if(pid < 0)
+        {
+            if(errno == EINTR)
+                continue;
+
+            break;
+        }
+
+        auto it = workers.find(pid);
+
+        if(it == workers.end())
+            continue;
+
+        Worker& worker = it->second;
+        std::string report;
+        char buffer[4096];
+        ssize_t n = 0;
+
+        while((n = read(worker.fd, buffer, sizeof(buffer))) > 0) // Reports are small, they fit in the pipe's buffer
+            report.append(buffer, n);
+
+        close(worker.fd);
+
+        worker.result.elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - worker.start).count();
+        worker.result.peakrss = usage.ru_maxrss;
+        worker.result.success = WIFEXITED(status) && !WEXITSTATUS(status);
+
+        if(WIFSIGNALED(status))
+            worker.result.error = "Crashed with signal " + std::to_string(WTERMSIG(status));
+
+        if(report.empty())
+            report = REDasm::Batch::toJson(worker.result);
+
+        cb(worker.result, report);
+        workers.erase(it);
+    }
+}
+#endif
@@ -0,0 +1,32 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "../redasm/support/batch.h"
+
+class BatchRunner // One worker process per file: crashes are isolated and peak RSS is per file
+{
+    public:
+        typedef std::function<void(const REDasm::BatchResult&, const std::string&)> ResultCallback; // Result, JSON report
+
+    public:
+        BatchRunner(size_t jobs, u32 output, const std::string& outputdir);
+        void run(const std::vector<std::string>& files, const ResultCallback& cb) const;
+        std::vector<std::string> outputFiles(const std::vector<std::string>& files) const; // Same order of 'files', never the same name twice
+
+    private:
+        std::string outputFile(const std::string& filename, size_t suffix) const;
+        void runSequential(const std::vector<std::string>& files, const std::vector<std::string>& outputfiles, const ResultCallback& cb) const;
+#ifndef _WIN32
+        void runProcesses(const std::vector<std::string>& files, const std::vector<std::string>& outputfiles, const ResultCallback& cb) const;
+#endif
+
+    private:
+        size_t _jobs;
+        u32 _output;
+        std::string _outputdir;
+};
+
+#endif // BATCHRUNNER_H
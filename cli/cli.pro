@@ -0,0 +1,19 @@
+#-------------------------------------------------
+#
+# Headless batch analyzer, built on redasm/ only
+#
+#-------------------------------------------------
+
+CONFIG   += console c++11
+CONFIG   -= qt app_bundle
+
+TARGET = redasm-cli
+TEMPLATE = app
+
+include(../depends/depends.pri)
+include(../redasm/redasm.pri)
+
+SOURCES += main.cpp \
+    batchrunner.cpp
+
+HEADERS += batchrunner.h
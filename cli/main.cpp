@@ -0,0 +1,102 @@
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include "batchrunner.h"
+#include "../redasm/plugins/plugins.h"
+#include "../redasm/support/threadpool.h"
+
+static void usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options] file..." << std::endl
+              << "  -j, --jobs N         Concurrent worker processes (default: CPU count)" << std::endl
+              << "  -f, --format FORMAT  Output format: json, binary, none (default: json)" << std::endl
+              << "  -o, --output DIR     Output directory (default: next to each file)" << std::endl
+              << "  -r, --runtime DIR    Runtime path, must contain 'database' (default: current directory)" << std::endl
+              << "  -v, --verbose        Print analysis log on stderr" << std::endl
+              << std::endl
+              << "Each file produces a JSON report on stdout, one per line." << std::endl;
+}
+
+static bool isOption(const char* arg, const char* shortopt, const char* longopt) { return !std::strcmp(arg, shortopt) || !std::strcmp(arg, longopt); }
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> files;
+    std::string outputdir, runtimepath = ".";
+    size_t jobs = REDasm::thread_pool::concurrency();
+    u32 output = REDasm::BatchOutputs::Json;
+    bool verbose = false;
+
+    for(int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        bool hasvalue = (i + 1) < argc;
+
+        if(isOption(arg, "-j", "--jobs") && hasvalue)
+            jobs = std::strtoul(argv[++i], NULL, 10);
+        else if(isOption(arg, "-o", "--output") && hasvalue)
+            outputdir = argv[++i];
+        else if(isOption(arg, "-r", "--runtime") && hasvalue)
+            runtimepath = argv[++i];
+        else if(isOption(arg, "-v", "--verbose"))
+            verbose = true;
+        else if(isOption(arg, "-f", "--format") && hasvalue)
+        {
+            std::string format = argv[++i];
+
+            if(format == "json")
+                output = REDasm::BatchOutputs::Json;
+            else if(format == "binary")
+                output = REDasm::BatchOutputs::Binary;
+            else if(format == "none")
+                output = REDasm::BatchOutputs::None;
+            else
+            {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        else if(isOption(arg, "-h", "--help") || (arg[0] == '-'))
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        else
+            files.push_back(arg);
+    }
+
+    if(files.empty())
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if(verbose)
+        REDasm::setLoggerCallback([](const std::string& s) { std::cerr << s << std::endl; });
+    else
+        REDasm::setLoggerCallback([](const std::string&) { });
+
+    REDasm::init(runtimepath);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t succeeded = 0;
+
+    BatchRunner runner(jobs, output, outputdir);
+
+    runner.run(files, [&succeeded](const REDasm::BatchResult& result, const std::string& report) {
+        if(result.success)
+            succeeded++;
+
+        std::cout << report << std::endl;
+    });
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cerr << files.size() << " file(s), " << succeeded << " succeeded, "
+              << elapsed << " ms (" << (files.size() * 1000.0 / (elapsed ? elapsed : 1)) << " files/s)" << std::endl;
+
+    REDasm::deinit();
+
+    return (succeeded == files.size()) ? 0 : 1;
+}
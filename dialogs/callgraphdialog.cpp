@@ -8,7 +8,7 @@ CallGraphDialog::CallGraphDialog(address_t address, REDasm::Disassembler *disass
     REDasm::SymbolTable* symboltable = disassembler->symbolTable();
     REDasm::SymbolPtr symbol = symboltable->symbol(address);
 
-    this->setWindowTitle(QString("Callgraph of %1").arg(QString::fromStdString(symbol ? symbol->name : REDasm::hex(address))));
+    this->setWindowTitle(QString("Callgraph of %1").arg(QString::fromStdString(symbol ? symbol->displayName() : REDasm::hex(address))));
     ui->callGraphView->display(address, disassembler);
 }
 
@@ -4,7 +4,7 @@
 ReferencesDialog::ReferencesDialog(REDasm::Disassembler *disassembler, address_t currentaddress, const REDasm::SymbolPtr& symbol, QWidget *parent) : QDialog(parent), ui(new Ui::ReferencesDialog)
 {
     ui->setupUi(this);
-    this->setWindowTitle(QString("%1 References").arg(QString::fromStdString(symbol->name)));
+    this->setWindowTitle(QString("%1 References").arg(QString::fromStdString(symbol->displayName())));
 
     this->_referencesmodel = new ReferencesModel(ui->tvReferences);
     this->_referencesmodel->setDisassembler(disassembler);
@@ -36,6 +36,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
 
 MainWindow::~MainWindow()
 {
+    REDasm::deinit();
     delete ui;
 }
 
@@ -103,29 +104,26 @@ void MainWindow::applyTheme()
 
 void MainWindow::load(const QString& s)
 {
-    QFile f(s);
+    std::shared_ptr<REDasm::MappedFile> mappedfile = std::make_shared<REDasm::MappedFile>();
 
-    if(!f.open(QFile::ReadOnly))
+    if(!mappedfile->open(QFile::encodeName(s).toStdString()))
         return;
 
     QFileInfo fi(s);
     QDir::setCurrent(fi.path());
     this->setWindowTitle(fi.fileName());
 
-    this->_loadeddata = f.readAll();
-    f.close();
-
-    if(!this->_loadeddata.isEmpty())
-        this->initDisassembler();
+    this->_mappedfile = mappedfile; // A busy DisassemblerView keeps its own reference
+    this->initDisassembler();
 }
 
 bool MainWindow::checkPlugins(REDasm::FormatPlugin** format, REDasm::AssemblerPlugin** assembler)
 {
-    *format = REDasm::getFormat(reinterpret_cast<u8*>(this->_loadeddata.data()), this->_loadeddata.length());
+    *format = REDasm::getFormat(this->_mappedfile->buffer());
 
     if((*format)->isBinary()) // Use manual loader
     {
-        ManualLoadDialog dlgmanload(*format, this->_loadeddata.size(), this);
+        ManualLoadDialog dlgmanload(*format, this->_mappedfile->size(), this);
 
         if(dlgmanload.exec() != ManualLoadDialog::Accepted)
             return false;
@@ -144,7 +142,7 @@ bool MainWindow::checkPlugins(REDasm::FormatPlugin** format, REDasm::AssemblerPl
 
 void MainWindow::initDisassembler()
 {
-    REDasm::Buffer buffer(this->_loadeddata.data(), this->_loadeddata.length());
+    REDasm::Buffer buffer = this->_mappedfile->buffer();
     DisassemblerView *olddv = NULL, *dv = new DisassemblerView(this->_lblstatus, ui->stackView);
     REDasm::FormatPlugin* format = NULL;
     REDasm::AssemblerPlugin* assembler = NULL;
@@ -155,8 +153,10 @@ void MainWindow::initDisassembler()
         return;
     }
 
+    this->_mappedfile->advise(format->segments());
+
     REDasm::Disassembler* disassembler = new REDasm::Disassembler(buffer, assembler, format);
-    dv->setDisassembler(disassembler);
+    dv->setDisassembler(disassembler, this->_mappedfile);
     ui->stackView->addWidget(dv);
 
     QWidget* oldwidget = static_cast<DisassemblerView*>(ui->stackView->widget(0));
@@ -4,6 +4,7 @@
 #include <QMainWindow>
 #include <QLabel>
 #include "redasm/plugins/plugins.h"
+#include "redasm/support/mappedfile.h"
 
 namespace Ui {
 class MainWindow;
@@ -37,7 +38,7 @@ class MainWindow : public QMainWindow
     private:
         Ui::MainWindow *ui;
         QLabel* _lblstatus;
-        QByteArray _loadeddata;
+        std::shared_ptr<REDasm::MappedFile> _mappedfile;
 };
 
 #endif // MAINWINDOW_H
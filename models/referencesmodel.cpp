@@ -55,9 +55,9 @@ QVariant ReferencesModel::dataInstructionRefs(const QModelIndex &index, int role
                 address_t diff = instruction->address - symbol->address;
 
                 if(diff)
-                    return S_TO_QS(symbol->name + "+" + REDasm::hex(diff));
+                    return S_TO_QS(symbol->displayName() + "+" + REDasm::hex(diff));
                 else
-                    return S_TO_QS(symbol->name);
+                    return S_TO_QS(symbol->displayName());
             }
 
             return S_TO_QS(REDasm::hex(instruction->address, this->_disassembler->format()->bits()));
@@ -49,7 +49,7 @@ bool SymbolTableFilterModel::filterAcceptsRow(int source_row, const QModelIndex
         if(symbol->is(REDasm::SymbolTypes::StringMask))
             res &= this->sourceModel()->data(index).toString().indexOf(this->_filtername, 0, Qt::CaseInsensitive) != -1;
         else
-            res &= QString::fromStdString(symbol->name).indexOf(this->_filtername, 0, Qt::CaseInsensitive) != -1;
+            res &= QString::fromStdString(symbol->displayName()).indexOf(this->_filtername, 0, Qt::CaseInsensitive) != -1;
     }
 
     return res;
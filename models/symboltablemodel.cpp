@@ -1,16 +1,27 @@
 #include "symboltablemodel.h"
 #include <QFontDatabase>
 #include <QColor>
+#include <algorithm>
 
-SymbolTableModel::SymbolTableModel(QObject *parent) : DisassemblerModel(parent), _symboltable(NULL), _symbolflags(REDasm::SymbolTypes::None)
+SymbolTableModel::SymbolTableModel(QObject *parent) : DisassemblerModel(parent), _symboltable(NULL), _subscription(0), _symbolflags(REDasm::SymbolTypes::None)
 {
 
 }
 
+SymbolTableModel::~SymbolTableModel()
+{
+    if(this->_disassembler)
+        this->_disassembler->journal()->unsubscribe(this->_subscription);
+}
+
 void SymbolTableModel::setDisassembler(REDasm::Disassembler *disassembler)
 {
+    if(this->_disassembler)
+        this->_disassembler->journal()->unsubscribe(this->_subscription);
+
     DisassemblerModel::setDisassembler(disassembler);
     this->_symboltable = disassembler->symbolTable();
+    this->_subscription = disassembler->journal()->subscribe([this](const REDasm::Change& change) { this->applyChange(change); });
     this->loadSymbols();
 }
 
@@ -36,6 +47,72 @@ void SymbolTableModel::loadSymbols()
     this->endResetModel();
 }
 
+void SymbolTableModel::applyChange(const REDasm::Change &change)
+{
+    if(this->_symbolflags == REDasm::SymbolTypes::None)
+        return;
+
+    bool found = false;
+    int row = this->symbolRow(change.address, &found);
+
+    if(change.is(REDasm::ChangeTypes::ReferenceAdded))
+    {
+        if(found)
+            emit dataChanged(this->index(row, 2, QModelIndex()), this->index(row, 2, QModelIndex()));
+
+        return;
+    }
+
+    if(change.is(REDasm::ChangeTypes::SymbolErased))
+    {
+        if(found)
+            this->removeSymbol(row);
+
+        return;
+    }
+
+    if(!change.is(REDasm::ChangeTypes::SymbolCreated) && !change.is(REDasm::ChangeTypes::SymbolRenamed))
+        return;
+
+    REDasm::SymbolPtr symbol = this->_symboltable->symbol(change.address);
+    bool accepted = symbol && symbol->is(this->_symbolflags);
+
+    if(found && !accepted) // Symbol type has been changed, it doesn't belong here anymore
+        this->removeSymbol(row);
+    else if(!found && accepted)
+        this->insertSymbol(symbol, row);
+    else if(found)
+    {
+        this->_symbols[row] = symbol;
+        emit dataChanged(this->index(row, 0, QModelIndex()), this->index(row, this->columnCount(QModelIndex()) - 1, QModelIndex()));
+    }
+}
+
+void SymbolTableModel::insertSymbol(const REDasm::SymbolPtr &symbol, int row)
+{
+    this->beginInsertRows(QModelIndex(), row, row);
+    this->_symbols.insert(row, symbol);
+    this->endInsertRows();
+}
+
+void SymbolTableModel::removeSymbol(int row)
+{
+    this->beginRemoveRows(QModelIndex(), row, row);
+    this->_symbols.removeAt(row);
+    this->endRemoveRows();
+}
+
+int SymbolTableModel::symbolRow(address_t address, bool *found) const
+{
+    // Symbols are loaded in address order
+    auto it = std::lower_bound(this->_symbols.begin(), this->_symbols.end(), address, [](const REDasm::SymbolPtr& symbol, address_t address) -> bool {
+        return symbol->address < address;
+    });
+
+    *found = (it != this->_symbols.end()) && ((*it)->address == address);
+    return static_cast<int>(std::distance(this->_symbols.begin(), it));
+}
+
 QModelIndex SymbolTableModel::index(int row, int column, const QModelIndex &) const
 {
     return this->createIndex(row, column, this->_symbols.at(row).get());
@@ -60,7 +137,7 @@ QVariant SymbolTableModel::data(const QModelIndex &index, int role) const
             else if(symbol->is(REDasm::SymbolTypes::StringMask))
                 return QString::fromStdString(REDasm::quoted(this->_disassembler->readString(symbol)));
 
-            return QString::fromStdString(symbol->name);
+            return QString::fromStdString(symbol->displayName());
         }
 
         if(index.column() == 2)
@@ -9,11 +9,16 @@ class SymbolTableModel : public DisassemblerModel
 
     public:
         explicit SymbolTableModel(QObject *parent = 0);
+        ~SymbolTableModel();
         virtual void setDisassembler(REDasm::Disassembler* disassembler);
         void setSymbolFlags(u32 symbolflags);
 
     private:
         void loadSymbols();
+        void applyChange(const REDasm::Change& change);
+        void insertSymbol(const REDasm::SymbolPtr& symbol, int row);
+        void removeSymbol(int row);
+        int symbolRow(address_t address, bool* found) const;
 
     public:
         virtual QModelIndex index(int row, int column, const QModelIndex &) const;
@@ -24,6 +29,7 @@ class SymbolTableModel : public DisassemblerModel
 
     private:
         REDasm::SymbolTable* _symboltable;
+        REDasm::ChangeJournal::subscription_t _subscription;
         QList<REDasm::SymbolPtr> _symbols;
         u32 _symbolflags;
 
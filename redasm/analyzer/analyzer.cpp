@@ -3,9 +3,16 @@
 
 namespace REDasm {
 
-Analyzer::Analyzer(DisassemblerAPI *disassembler, const SignatureFiles &signaturefiles): _disassembler(disassembler), _signaturefiles(signaturefiles)
+Analyzer::Analyzer(DisassemblerAPI *disassembler, const SignatureFiles &signaturefiles): _disassembler(disassembler), _signaturefiles(signaturefiles), _pipeline(disassembler), _longestpattern(0)
 {
-
+    AnalyzerPass& signatures = this->_pipeline.add("signatures");
+    signatures.concurrent = true; // Matching is read only, symbols are renamed in 'finalize'
+    signatures.prepare = [this](Listing&) { this->loadSignatures(); };
+    signatures.visitfunction = [this](Listing&, const SymbolPtr& symbol) { this->findSignatures(symbol); };
+    signatures.finalize = [this](Listing& listing) { this->applySignatures(listing); };
+
+    AnalyzerPass& trampolines = this->_pipeline.add("trampolines", { "signatures" }); // Locked symbols are skipped
+    trampolines.visitfunction = [this](Listing& listing, const SymbolPtr& symbol) { this->findTrampolines(listing, symbol); };
 }
 
 Analyzer::~Analyzer()
@@ -13,15 +20,9 @@ Analyzer::~Analyzer()
 
 }
 
-void Analyzer::analyze(Listing &listing)
-{
-    this->loadSignatures(listing);
-
-    listing.symbolTable()->iterate(SymbolTypes::FunctionMask, [this, &listing](SymbolPtr symbol) -> bool {
-        this->findTrampolines(listing, symbol);
-        return true;
-    });
-}
+void Analyzer::analyze(Listing &listing) { this->_pipeline.run(listing); }
+bool Analyzer::analyzeStep(Listing &listing, size_t budget) { return this->_pipeline.step(listing, budget); }
+void Analyzer::setStepCallback(const AnalyzerPipeline::StepCallback &cb) { this->_pipeline.setStepCallback(cb); }
 
 bool Analyzer::checkCrc16(const SymbolPtr& symbol, const Signature& signature, const SignatureDB& signaturedb)
 {
@@ -42,29 +43,58 @@ bool Analyzer::checkCrc16(const SymbolPtr& symbol, const Signature& signature, c
     return false;
 }
 
-void Analyzer::loadSignatures(Listing& listing)
+void Analyzer::loadSignatures()
 {
-    std::for_each(this->_signaturefiles.begin(), this->_signaturefiles.end(), [this, &listing](const std::string& signaturefile) {
-        SignatureDB sigdb;
+    std::for_each(this->_signaturefiles.begin(), this->_signaturefiles.end(), [this](const std::string& signaturefile) {
+        this->_signaturedbs.emplace_back();
+
+        if(!this->_signaturedbs.back().readPath(signaturefile))
+        {
+            this->_signaturedbs.pop_back();
+            return;
+        }
 
-        if(sigdb.readPath(signaturefile))
-            this->findSignatures(sigdb, listing);
+        this->_longestpattern = std::max(this->_longestpattern, this->_signaturedbs.back().longestPattern());
     });
 }
 
-void Analyzer::findSignatures(SignatureDB &signaturedb, Listing& listing)
+void Analyzer::findSignatures(const SymbolPtr &symbol)
 {
-    listing.symbolTable()->iterate(SymbolTypes::FunctionMask, [this, &signaturedb, &listing](SymbolPtr symbol) -> bool {
-        Signature signature;
-        std::string pattern = this->_disassembler->readHex(symbol->address, signaturedb.longestPattern());
+    if(this->_signaturedbs.empty())
+        return;
 
-        if(signaturedb.match(pattern, signature) && this->checkCrc16(symbol, signature, signaturedb)) {
-            symbol->lock();
-            listing.symbolTable()->update(symbol, signature.name);
-        }
+    std::string hexbytes = this->_disassembler->readHex(symbol->address, this->_longestpattern); // Read once, shared by every database
+    Signature signature, lastsignature;
+    bool matched = false;
 
-        return true;
-    });
+    for(SignatureDB& signaturedb : this->_signaturedbs) // Later databases win, like sequential matching
+    {
+        std::string pattern = hexbytes.substr(0, signaturedb.longestPattern() * 2);
+
+        if(!signaturedb.match(pattern, signature) || !this->checkCrc16(symbol, signature, signaturedb))
+            continue;
+
+        lastsignature = signature;
+        matched = true;
+    }
+
+    if(!matched)
+        return;
+
+    std::lock_guard<std::mutex> lock(this->_signaturemutex);
+    this->_signaturematches.emplace_back(symbol, lastsignature);
+}
+
+void Analyzer::applySignatures(Listing &listing)
+{
+    for(auto& match : this->_signaturematches)
+    {
+        match.first->lock();
+        listing.symbolTable()->update(match.first, match.second.name);
+    }
+
+    this->_signaturematches.clear();
+    this->_signaturedbs.clear();
 }
 
 void Analyzer::findTrampolines(Listing &listing, SymbolPtr symbol)
@@ -3,11 +3,13 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include "../plugins/assembler/assembler.h"
 #include "../disassembler/types/listing.h"
 #include "../disassembler/types/symboltable.h"
 #include "../disassembler/disassemblerapi.h"
 #include "../signatures/signaturedb.h"
+#include "analyzerpass.h"
 
 namespace REDasm {
 
@@ -16,12 +18,15 @@ class Analyzer
     public:
         Analyzer(DisassemblerAPI* disassembler, const SignatureFiles& signaturefiles);
         virtual ~Analyzer();
-        virtual void analyze(Listing& listing);
+        void analyze(Listing& listing);                  // Runs the registered passes
+        bool analyzeStep(Listing& listing, size_t budget); // Resumable: returns false when every pass has finished
+        void setStepCallback(const AnalyzerPipeline::StepCallback& cb);
 
     private:
         bool checkCrc16(const SymbolPtr &symbol, const Signature &signature, const SignatureDB &signaturedb);
-        void loadSignatures(Listing &listing);
-        void findSignatures(SignatureDB &signaturedb, Listing& listing);
+        void loadSignatures();
+        void findSignatures(const SymbolPtr& symbol);
+        void applySignatures(Listing& listing);
         void findTrampolines(Listing& listing, SymbolPtr symbol);
         SymbolPtr findTrampolines_x86(Listing::iterator& it, SymbolTable *symboltable);
         SymbolPtr findTrampolines_arm(Listing::iterator& it, SymbolTable *symboltable);
@@ -29,6 +34,13 @@ class Analyzer
     protected:
         DisassemblerAPI* _disassembler;
         const SignatureFiles& _signaturefiles;
+        AnalyzerPipeline _pipeline; // Passes: "signatures", "trampolines"
+
+    private:
+        std::list<SignatureDB> _signaturedbs;
+        std::list< std::pair<SymbolPtr, Signature> > _signaturematches;
+        std::mutex _signaturemutex;
+        u32 _longestpattern;
 };
 
 }
@@ -0,0 +1,271 @@
+#include "analyzerpass.h"
+#include "../support/threadpool.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace REDasm {
+
+namespace AnalyzerStages {
+    enum: u32 { Prepare = 0, Functions, References, Finalize };
+}
+
+AnalyzerPipeline::AnalyzerPipeline(DisassemblerAPI *disassembler): _disassembler(disassembler), _level(0), _cursor(0), _stage(AnalyzerStages::Prepare), _scheduled(false)
+{
+
+}
+
+AnalyzerPass &AnalyzerPipeline::add(const std::string &name, const std::list<std::string> &dependencies)
+{
+    this->_passes.emplace_back(name);
+    this->_passes.back().dependencies = dependencies;
+    return this->_passes.back();
+}
+
+void AnalyzerPipeline::setStepCallback(const StepCallback &cb) { this->_stepcallback = cb; }
+
+void AnalyzerPipeline::run(Listing &listing)
+{
+    while(this->step(listing, std::numeric_limits<size_t>::max())) // Whole walks: concurrent passes use every worker
+        continue;
+}
+
+bool AnalyzerPipeline::step(Listing &listing, size_t budget)
+{
+    if(!this->_scheduled)
+    {
+        this->schedule();
+        this->_scheduled = true;
+    }
+
+    if(this->_level >= this->_levels.size())
+        return false;
+
+    if(!this->_stepcallback)
+        return this->stepLevel(listing, budget);
+
+    const std::vector<AnalyzerPass*>& level = this->_levels[this->_level]; // Finalize moves to the next one
+    auto start = std::chrono::steady_clock::now();
+    bool pending = this->stepLevel(listing, budget);
+
+    this->_stepcallback(level, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    return pending;
+}
+
+bool AnalyzerPipeline::stepLevel(Listing &listing, size_t budget)
+{
+    budget = std::max<size_t>(budget, 1);
+
+    if(this->_stage == AnalyzerStages::Prepare)
+    {
+        this->prepareLevel(listing);
+        this->_stage = AnalyzerStages::Functions;
+    }
+    else if(this->_stage == AnalyzerStages::Functions)
+    {
+        size_t end = this->_cursor + std::min(budget, this->_functions.size() - this->_cursor);
+        this->visitFunctions(listing, this->_cursor, end, true);
+        this->visitFunctions(listing, this->_cursor, end, false);
+        this->_cursor = end;
+
+        if(this->_cursor < this->_functions.size())
+            return true;
+
+        this->watchLevel(listing);
+        this->_stage = AnalyzerStages::References;
+    }
+    else if(this->_stage == AnalyzerStages::References)
+    {
+        size_t end = this->_cursor + std::min(budget, this->_watched.size() - this->_cursor);
+        this->visitReferences(listing, this->_cursor, end);
+        this->_cursor = end;
+
+        if(this->_cursor < this->_watched.size())
+            return true;
+
+        this->_stage = AnalyzerStages::Finalize;
+    }
+    else if(this->_stage == AnalyzerStages::Finalize)
+    {
+        for(AnalyzerPass* pass : this->_levels[this->_level])
+        {
+            if(pass->finalize)
+                pass->finalize(listing);
+        }
+
+        this->_functions.clear();
+        this->_watched.clear();
+        this->_watchers.clear();
+        this->_stage = AnalyzerStages::Prepare;
+        this->_level++;
+    }
+
+    return this->_level < this->_levels.size();
+}
+
+void AnalyzerPipeline::prepareLevel(Listing &listing)
+{
+    for(AnalyzerPass* pass : this->_levels[this->_level])
+    {
+        if(pass->prepare)
+            pass->prepare(listing);
+    }
+
+    this->_cursor = 0;
+
+    auto it = std::find_if(this->_levels[this->_level].begin(), this->_levels[this->_level].end(), [](const AnalyzerPass* pass) -> bool {
+        return static_cast<bool>(pass->visitfunction);
+    });
+
+    if(it == this->_levels[this->_level].end())
+        return;
+
+    // One symbol table walk for each level, shared by its passes: functions created by earlier levels are visited too
+    listing.symbolTable()->iterate(SymbolTypes::FunctionMask, [this](const SymbolPtr& symbol) -> bool {
+        this->_functions.push_back(symbol);
+        return true;
+    });
+}
+
+void AnalyzerPipeline::watchLevel(Listing &listing)
+{
+    this->_cursor = 0;
+
+    for(AnalyzerPass* pass : this->_levels[this->_level])
+    {
+        if(!pass->watch || !pass->visitreference)
+            continue;
+
+        std::list<SymbolPtr> symbols;
+        pass->watch(listing, symbols);
+
+        for(const SymbolPtr& symbol : symbols)
+        {
+            if(!symbol)
+                continue;
+
+            std::list<AnalyzerPass*>& symbolwatchers = this->_watchers[symbol->address];
+
+            if(symbolwatchers.empty())
+                this->_watched.push_back(symbol);
+
+            symbolwatchers.push_back(pass);
+        }
+    }
+}
+
+void AnalyzerPipeline::schedule()
+{
+    std::vector< std::vector<AnalyzerPass*> >& levels = this->_levels;
+    std::unordered_map<std::string, size_t> passlevels;
+    std::list<AnalyzerPass*> pending;
+    bool scheduled = true;
+
+    for(AnalyzerPass& pass : this->_passes)
+        pending.push_back(&pass);
+
+    while(scheduled && !pending.empty())
+    {
+        scheduled = false;
+
+        for(auto it = pending.begin(); it != pending.end(); )
+        {
+            AnalyzerPass* pass = *it;
+            size_t level = 0;
+            bool ready = true;
+
+            for(const std::string& dependency : pass->dependencies)
+            {
+                auto lit = passlevels.find(dependency);
+
+                if(lit == passlevels.end())
+                {
+                    ready = false;
+                    break;
+                }
+
+                level = std::max(level, lit->second + 1);
+            }
+
+            if(!ready)
+            {
+                it++;
+                continue;
+            }
+
+            if(levels.size() <= level)
+                levels.resize(level + 1);
+
+            levels[level].push_back(pass);
+            passlevels[pass->name] = level;
+            it = pending.erase(it);
+            scheduled = true;
+        }
+    }
+
+    for(AnalyzerPass* pass : pending) // Missing or circular dependencies
+        REDasm::log("Skipping analyzer pass " + REDasm::quoted(pass->name) + ": unresolved dependencies");
+}
+
+void AnalyzerPipeline::visitFunctions(Listing &listing, size_t start, size_t end, bool concurrent) const
+{
+    std::vector<AnalyzerPass*> visitors;
+
+    for(AnalyzerPass* pass : this->_levels[this->_level])
+    {
+        if(pass->visitfunction && (pass->concurrent == concurrent))
+            visitors.push_back(pass);
+    }
+
+    if(visitors.empty() || (start >= end))
+        return;
+
+    const std::vector<SymbolPtr>& functions = this->_functions;
+
+    auto visit = [&listing, &visitors, &functions](size_t start, size_t end) {
+        for(size_t i = start; i < end; i++)
+        {
+            for(AnalyzerPass* pass : visitors)
+                pass->visitfunction(listing, functions[i]);
+        }
+    };
+
+    if(!concurrent || ((end - start) < ANALYZER_CONCURRENCY_THRESHOLD))
+    {
+        visit(start, end);
+        return;
+    }
+
+    thread_pool pool(thread_pool::concurrency());
+    size_t chunk = ((end - start) + pool.size() - 1) / pool.size();
+
+    for(size_t i = start; i < end; i += chunk)
+        pool.enqueue([&visit, end, i, chunk](size_t) { visit(i, std::min(i + chunk, end)); });
+
+    pool.wait();
+}
+
+void AnalyzerPipeline::visitReferences(Listing &listing, size_t start, size_t end) const
+{
+    for(size_t i = start; i < end; i++) // References and instructions are fetched once for every watcher
+    {
+        const SymbolPtr& symbol = this->_watched[i];
+        const std::list<AnalyzerPass*>& symbolwatchers = this->_watchers.at(symbol->address);
+        ReferenceVector refs = this->_disassembler->getReferences(symbol);
+
+        for(address_t address : refs)
+        {
+            auto it = listing.find(address);
+
+            if(it == listing.end())
+                continue;
+
+            InstructionPtr instruction = *it;
+
+            for(AnalyzerPass* pass : symbolwatchers)
+                pass->visitreference(listing, symbol, instruction);
+        }
+    }
+}
+
+} // namespace REDasm
@@ -0,0 +1,67 @@
+#ifndef ANALYZERPASS_H
+#define ANALYZERPASS_H
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include "../disassembler/types/listing.h"
+#include "../disassembler/types/symboltable.h"
+#include "../disassembler/disassemblerapi.h"
+
+#define ANALYZER_CONCURRENCY_THRESHOLD 0x400 // Functions: smaller listings are visited in the caller's thread
+
+namespace REDasm {
+
+struct AnalyzerPass
+{
+    typedef std::function<void(Listing&)> StageCallback;
+    typedef std::function<void(Listing&, const SymbolPtr&)> FunctionVisitor;
+    typedef std::function<void(Listing&, std::list<SymbolPtr>&)> WatchCallback;
+    typedef std::function<void(Listing&, const SymbolPtr&, const InstructionPtr&)> ReferenceVisitor;
+
+    AnalyzerPass(const std::string& name): name(name), concurrent(false) { }
+
+    std::string name;
+    std::list<std::string> dependencies; // Passes that must be finalized before this one starts
+    bool concurrent;                     // 'visitfunction' is thread safe: functions are split between workers
+    StageCallback prepare, finalize;     // Before and after the walk
+    FunctionVisitor visitfunction;       // Every function, once
+    WatchCallback watch;                 // Symbols whose references 'visitreference' receives
+    ReferenceVisitor visitreference;     // Instruction referencing a watched symbol
+};
+
+class AnalyzerPipeline // Passes of the same level share a single walk, which can be split in resumable steps
+{
+    public:
+        typedef std::function<void(const std::vector<AnalyzerPass*>& level, double elapsed)> StepCallback; // Milliseconds
+
+    public:
+        AnalyzerPipeline(DisassemblerAPI* disassembler);
+        void setStepCallback(const StepCallback& cb);
+        AnalyzerPass& add(const std::string& name, const std::list<std::string>& dependencies = std::list<std::string>());
+        void run(Listing& listing);
+        bool step(Listing& listing, size_t budget); // A level's prepare/finalize, or up to 'budget' functions/watched symbols
+
+    private:
+        bool stepLevel(Listing& listing, size_t budget);
+        void schedule();
+        void prepareLevel(Listing& listing);
+        void watchLevel(Listing& listing);
+        void visitFunctions(Listing& listing, size_t start, size_t end, bool concurrent) const;
+        void visitReferences(Listing& listing, size_t start, size_t end) const;
+
+    private:
+        DisassemblerAPI* _disassembler;
+        std::list<AnalyzerPass> _passes;
+        std::vector< std::vector<AnalyzerPass*> > _levels;
+        std::vector<SymbolPtr> _functions, _watched;                             // Current level's snapshot, watched in registration order
+        std::unordered_map<address_t, std::list<AnalyzerPass*> > _watchers;
+        StepCallback _stepcallback;                                              // Profiling, reports every step
+        size_t _level, _cursor;
+        u32 _stage;
+        bool _scheduled;
+};
+
+} // namespace REDasm
+
+#endif // ANALYZERPASS_H
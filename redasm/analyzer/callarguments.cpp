@@ -0,0 +1,339 @@
+#include "callarguments.h"
+#include <capstone.h>
+
+namespace REDasm {
+
+CallArguments::CallArguments(Listing &listing): _listing(listing), _registercount(0), _stackregister(REGISTER_INVALID), _stackoffset(0), _slotsize(0)
+{
+
+}
+
+void CallArguments::setRegisters(const RegisterArguments &registers, const RegisterArguments &partials)
+{
+    this->_registercount = registers.size();
+    this->_registers.clear();
+    this->_partials.clear();
+    this->_calls.clear();
+
+    for(size_t i = 0; i < registers.size(); i++)
+    {
+        for(register_t reg : registers[i])
+            this->_registers[reg] = i;
+    }
+
+    for(size_t i = 0; i < partials.size(); i++)
+    {
+        for(register_t reg : partials[i])
+            this->_partials[reg] = i;
+    }
+}
+
+void CallArguments::setStackSlots(register_t stackregister, s64 offset, size_t slotsize)
+{
+    this->_stackregister = stackregister;
+    this->_stackoffset = offset;
+    this->_slotsize = slotsize;
+    this->_calls.clear();
+}
+
+bool CallArguments::argument(address_t address, size_t argidx, u64 *value)
+{
+    auto it = this->_calls.find(address);
+
+    if(it == this->_calls.end())
+    {
+        auto iit = this->_listing.find(address);
+
+        if(iit == this->_listing.end())
+            return false;
+
+        this->resolveBlock(iit);
+        it = this->_calls.find(address);
+
+        if(it == this->_calls.end())
+            return false;
+    }
+
+    const ArgumentList& arguments = it->second;
+
+    if(!argidx || (argidx > arguments.size()) || !arguments[argidx - 1].known)
+        return false;
+
+    *value = arguments[argidx - 1].value;
+    return true;
+}
+
+void CallArguments::resolveBlock(Listing::iterator it)
+{
+    address_t address = (*it)->address;
+
+    while(this->fallsInto(it)) // Back to the start of the fallthrough chain
+        it--;
+
+    ArgumentList pushes, registers(this->_registercount);
+    bool first = true;
+
+    for( ; it != this->_listing.end(); it++, first = false)
+    {
+        if(!first && !this->fallsInto(it))
+            break;
+
+        const InstructionPtr& instruction = *it;
+
+        if(instruction->is(InstructionTypes::Call))
+        {
+            ArgumentList& arguments = this->_calls[instruction->address];
+
+            if(this->_registers.empty()) // Last push is the first argument
+                arguments.assign(pushes.rbegin(), pushes.rend());
+            else
+                arguments = registers;
+
+            pushes.clear();
+            registers.assign(this->_registercount, Argument{ false, 0 }); // Volatile across calls, stack slots are rewritten
+        }
+        else if(this->_registers.empty())
+            this->trackPush(instruction, pushes);
+        else
+            this->trackRegisters(instruction, registers);
+    }
+
+    this->_calls.insert({ address, ArgumentList() }); // Unresolved: don't scan it again
+}
+
+void CallArguments::trackPush(const InstructionPtr &instruction, ArgumentList &pushes) const
+{
+    if(instruction->is(InstructionTypes::Push))
+    {
+        if(!instruction->operands.empty() && instruction->op(0).is(OperandTypes::Immediate))
+            pushes.push_back({ true, instruction->op(0).u_value });
+        else
+            pushes.push_back({ false, 0 }); // Registers and memory: the value isn't tracked
+    }
+    else if(instruction->is(InstructionTypes::Pop) && !pushes.empty())
+        pushes.pop_back();
+}
+
+void CallArguments::trackRegisters(const InstructionPtr &instruction, ArgumentList &registers) const
+{
+    this->clobberImplicit(instruction, registers);
+
+    if(instruction->operands.empty())
+        return;
+
+    switch(instruction->id)
+    {
+        case X86_INS_PUSH: // Read only
+        case X86_INS_CMP:
+        case X86_INS_TEST:
+        case X86_INS_BT:
+            return;
+
+        case X86_INS_XCHG: // Both operands are written
+        case X86_INS_XADD:
+            if((instruction->operands.size() == 2) && instruction->op(1).is(OperandTypes::Register))
+                this->clobber(instruction->op(1).reg.r, registers);
+
+            break;
+
+        default:
+            break;
+    }
+
+    if(instruction->op(0).is(OperandTypes::Displacement))
+    {
+        this->trackStackSlot(instruction, registers);
+        return;
+    }
+
+    if(!instruction->op(0).is(OperandTypes::Register))
+        return;
+
+    auto it = this->_registers.find(instruction->op(0).reg.r);
+
+    if(it == this->_registers.end())
+    {
+        this->clobber(instruction->op(0).reg.r, registers); // Sub-registers
+        return;
+    }
+
+    Argument& argument = registers[it->second];
+    argument = { false, 0 }; // Any other write clobbers it
+
+    if(instruction->operands.size() != 2)
+        return;
+
+    const Operand& source = instruction->op(1);
+
+    if(((instruction->id == X86_INS_MOV) && source.is(OperandTypes::Immediate)) || ((instruction->id == X86_INS_LEA) && source.is(OperandTypes::Memory)))
+        argument = { true, source.u_value };
+    else if((instruction->id == X86_INS_XOR) && source.is(OperandTypes::Register) && (source.reg.r == instruction->op(0).reg.r))
+        argument = { true, 0 };
+}
+
+void CallArguments::clobberImplicit(const InstructionPtr &instruction, ArgumentList &registers) const
+{
+    std::vector<register_t> implicits; // Full width registers, tracked ones are in setRegisters()'s sets
+
+    switch(instruction->id)
+    {
+        case X86_INS_CWD:
+        case X86_INS_CDQ:
+        case X86_INS_CQO:
+            implicits = { X86_REG_RDX };
+            break;
+
+        case X86_INS_IMUL: // Two and three operand forms write op0 only
+            if(instruction->operands.size() > 1)
+                return;
+
+            implicits = { X86_REG_RAX, X86_REG_RDX };
+            break;
+
+        case X86_INS_MUL:
+        case X86_INS_DIV:
+        case X86_INS_IDIV:
+        case X86_INS_RDTSC:
+        case X86_INS_RDMSR:
+        case X86_INS_RDPMC:
+        case X86_INS_XGETBV:
+        case X86_INS_CMPXCHG8B:
+        case X86_INS_CMPXCHG16B:
+            implicits = { X86_REG_RAX, X86_REG_RDX };
+            break;
+
+        case X86_INS_RDTSCP:
+            implicits = { X86_REG_RAX, X86_REG_RCX, X86_REG_RDX };
+            break;
+
+        case X86_INS_CPUID:
+            implicits = { X86_REG_RAX, X86_REG_RBX, X86_REG_RCX, X86_REG_RDX };
+            break;
+
+        case X86_INS_SYSCALL:
+            implicits = { X86_REG_RCX, X86_REG_R11 };
+            break;
+
+        case X86_INS_MOVSB: // String instructions, REP prefixes aren't stored: assume RCX is counted down
+        case X86_INS_MOVSW:
+        case X86_INS_MOVSD:
+        case X86_INS_MOVSQ:
+        case X86_INS_STOSB:
+        case X86_INS_STOSW:
+        case X86_INS_STOSD:
+        case X86_INS_STOSQ:
+        case X86_INS_LODSB:
+        case X86_INS_LODSW:
+        case X86_INS_LODSD:
+        case X86_INS_LODSQ:
+        case X86_INS_CMPSB:
+        case X86_INS_CMPSW:
+        case X86_INS_CMPSD:
+        case X86_INS_CMPSQ:
+        case X86_INS_SCASB:
+        case X86_INS_SCASW:
+        case X86_INS_SCASD:
+        case X86_INS_SCASQ:
+        case X86_INS_INSB:
+        case X86_INS_INSW:
+        case X86_INS_INSD:
+        case X86_INS_OUTSB:
+        case X86_INS_OUTSW:
+        case X86_INS_OUTSD:
+            implicits = { X86_REG_RAX, X86_REG_RCX, X86_REG_RSI, X86_REG_RDI };
+            break;
+
+        default:
+            return;
+    }
+
+    for(register_t reg : implicits)
+        this->clobber(reg, registers);
+}
+
+void CallArguments::clobber(register_t reg, ArgumentList &registers) const
+{
+    auto it = this->_registers.find(reg);
+
+    if(it != this->_registers.end())
+    {
+        registers[it->second] = { false, 0 };
+        return;
+    }
+
+    it = this->_partials.find(reg);
+
+    if(it != this->_partials.end())
+        registers[it->second] = { false, 0 };
+}
+
+void CallArguments::trackStackSlot(const InstructionPtr &instruction, ArgumentList &registers) const
+{
+    const Operand& destination = instruction->op(0);
+
+    if(!this->_slotsize || (destination.disp.base.r != this->_stackregister))
+        return;
+
+    if(!destination.is(OperandTypes::Local) && destination.disp.index.isValid()) // Locals keep their index there
+        return;
+
+    s64 offset = destination.disp.displacement - this->_stackoffset;
+
+    if((offset < 0) || (offset % this->_slotsize))
+        return;
+
+    size_t argidx = this->_registercount + (offset / this->_slotsize);
+
+    if(argidx >= registers.size())
+        registers.resize(argidx + 1, Argument{ false, 0 });
+
+    Argument& argument = registers[argidx];
+    argument = { false, 0 };
+
+    if((instruction->operands.size() != 2) || !instruction->op(1).is(OperandTypes::Immediate))
+        return;
+
+    if(instruction->id == X86_INS_MOV)
+        argument = { true, instruction->op(1).u_value };
+    else if((instruction->id == X86_INS_AND) && !instruction->op(1).u_value) // MSVC stores zeroes this way
+        argument = { true, 0 };
+}
+
+bool CallArguments::fallsInto(Listing::iterator it) const
+{
+    if(it == this->_listing.begin())
+        return false;
+
+    address_t address = (*it)->address;
+    SymbolPtr symbol = this->_listing.symbolTable()->symbol(address);
+
+    if(symbol && symbol->isFunction())
+        return false;
+
+    it--;
+    InstructionPtr previous = *it;
+
+    if(previous->is(InstructionTypes::Stop) || (previous->is(InstructionTypes::Jump) && !previous->is(InstructionTypes::Conditional)))
+        return false;
+
+    if(previous->endAddress() != address)
+        return false;
+
+    ReferenceTable* referencetable = this->_listing.referenceTable();
+    auto rit = referencetable->references(address);
+
+    if(rit == referencetable->end())
+        return true;
+
+    for(address_t refaddress : rit->second) // Jump destinations merge paths
+    {
+        auto iit = this->_listing.find(refaddress);
+
+        if((iit != this->_listing.end()) && (*iit)->is(InstructionTypes::Jump))
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace REDasm
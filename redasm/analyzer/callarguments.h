@@ -0,0 +1,48 @@
+#ifndef CALLARGUMENTS_H
+#define CALLARGUMENTS_H
+
+#include <unordered_map>
+#include <vector>
+#include <set>
+#include "../disassembler/types/listing.h"
+
+namespace REDasm {
+
+class CallArguments // x86 argument values at call sites, resolved once for every basic block
+{
+    public:
+        typedef std::vector< std::set<register_t> > RegisterArguments; // Argument -> registers holding it (aliases included)
+
+    private:
+        struct Argument { bool known; u64 value; };
+        typedef std::vector<Argument> ArgumentList;
+
+    public:
+        CallArguments(Listing& listing);
+        void setRegisters(const RegisterArguments& registers, const RegisterArguments& partials = RegisterArguments()); // Register arguments, pushes otherwise
+        void setStackSlots(register_t stackregister, s64 offset, size_t slotsize); // 'mov [sp + offset + n * slotsize]': arguments after the registers
+        bool argument(address_t address, size_t argidx, u64* value); // 'argidx' is 1-based
+
+    private:
+        void resolveBlock(Listing::iterator it);
+        void trackPush(const InstructionPtr& instruction, ArgumentList& pushes) const;
+        void trackRegisters(const InstructionPtr& instruction, ArgumentList& registers) const;
+        void clobberImplicit(const InstructionPtr& instruction, ArgumentList& registers) const;
+        void clobber(register_t reg, ArgumentList& registers) const;
+        void trackStackSlot(const InstructionPtr& instruction, ArgumentList& registers) const;
+        bool fallsInto(Listing::iterator it) const; // Single predecessor: the previous instruction
+
+    private:
+        Listing& _listing;
+        std::unordered_map<register_t, size_t> _registers;  // Register -> argument
+        std::unordered_map<register_t, size_t> _partials;   // Sub-register -> argument, writes only clobber it
+        std::unordered_map<address_t, ArgumentList> _calls; // Call's address -> arguments, first one at index 0
+        size_t _registercount;
+        register_t _stackregister;
+        s64 _stackoffset;
+        size_t _slotsize;
+};
+
+} // namespace REDasm
+
+#endif // CALLARGUMENTS_H
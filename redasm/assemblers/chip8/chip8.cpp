@@ -3,30 +3,20 @@
 #include "chip8_printer.h"
 #include "chip8_emulator.h"
 
-#define SET_DECODE_TO(opmask, cb) _opcodemap[opmask] = [this](u16 opcode, const InstructionPtr& instruction) -> bool { return cb(opcode, instruction); };
+#define DECODE_OPCODE(op) &CHIP8Assembler::decode##op##xxx
 
 namespace REDasm {
 
+const CHIP8Assembler::OpCodeCallback CHIP8Assembler::_opcodetable[0x10] = {
+    DECODE_OPCODE(0), DECODE_OPCODE(1), DECODE_OPCODE(2), DECODE_OPCODE(3),
+    DECODE_OPCODE(4), DECODE_OPCODE(5), DECODE_OPCODE(6), DECODE_OPCODE(7),
+    DECODE_OPCODE(8), DECODE_OPCODE(9), DECODE_OPCODE(A), DECODE_OPCODE(B),
+    DECODE_OPCODE(C), DECODE_OPCODE(D), DECODE_OPCODE(E), DECODE_OPCODE(F)
+};
+
 CHIP8Assembler::CHIP8Assembler(): AssemblerPlugin()
 {
     this->setEndianness(Endianness::BigEndian);
-
-    SET_DECODE_TO(0x0000, decode0xxx);
-    SET_DECODE_TO(0x1000, decode1xxx);
-    SET_DECODE_TO(0x2000, decode2xxx);
-    SET_DECODE_TO(0x3000, decode3xxx);
-    SET_DECODE_TO(0x4000, decode4xxx);
-    SET_DECODE_TO(0x5000, decode5xxx);
-    SET_DECODE_TO(0x6000, decode6xxx);
-    SET_DECODE_TO(0x7000, decode7xxx);
-    SET_DECODE_TO(0x8000, decode8xxx);
-    SET_DECODE_TO(0x9000, decode9xxx);
-    SET_DECODE_TO(0xA000, decodeAxxx);
-    SET_DECODE_TO(0xB000, decodeBxxx);
-    SET_DECODE_TO(0xC000, decodeCxxx);
-    SET_DECODE_TO(0xD000, decodeDxxx);
-    SET_DECODE_TO(0xE000, decodeExxx);
-    SET_DECODE_TO(0xF000, decodeFxxx);
 }
 
 const char *CHIP8Assembler::name() const
@@ -56,9 +46,7 @@ bool CHIP8Assembler::decode(Buffer buffer, const InstructionPtr &instruction)
     instruction->id = opcode;
     instruction->size = sizeof(u16);
 
-    auto it = this->_opcodemap.find(opcode & 0xF000);
-
-    if((it == this->_opcodemap.end()) || !it->second(opcode, instruction))
+    if(!(this->*CHIP8Assembler::_opcodetable[(opcode & 0xF000) >> 12])(opcode, instruction))
         return false;
 
     AssemblerPlugin::decode(buffer, instruction);
@@ -16,7 +16,7 @@ namespace REDasm {
 class CHIP8Assembler : public AssemblerPlugin
 {
     private:
-        typedef std::function<bool(u16, const InstructionPtr& instruction)> OpCodeCallback;
+        typedef bool (CHIP8Assembler::*OpCodeCallback)(u16, const InstructionPtr& instruction) const;
 
     public:
         CHIP8Assembler();
@@ -45,7 +45,7 @@ class CHIP8Assembler : public AssemblerPlugin
         bool decodeFxxx(u16 opcode, const InstructionPtr& instruction) const;
 
     private:
-        std::map<u16, OpCodeCallback> _opcodemap;
+        static const OpCodeCallback _opcodetable[0x10]; // Indexed by opcode's high nibble
 };
 
 DECLARE_ASSEMBLER_PLUGIN(CHIP8Assembler, chip8)
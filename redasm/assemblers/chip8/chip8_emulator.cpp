@@ -3,96 +3,94 @@
 
 namespace REDasm {
 
-CHIP8Emulator::CHIP8Emulator(DisassemblerAPI *disassembler): VMIL::Emulator(disassembler)
+static const char* BCD_COMMENTS[] = { "Write RAM[i]", "Write RAM[i + 1]", "Write RAM[i + 2]" }; // VMIL comments are static strings
+
+CHIP8Emulator::CHIP8Emulator(DisassemblerAPI *disassembler): VMIL::Emulator(disassembler, CHIP8_REG_COUNT)
 {
-    VMIL_TRANSLATE_OPCODE(0x1000, 1xxx);
-    VMIL_TRANSLATE_OPCODE(0x3000, 3xxx);
-    VMIL_TRANSLATE_OPCODE(0x4000, 4xxx);
-    VMIL_TRANSLATE_OPCODE(0x6000, 6xxx);
-    VMIL_TRANSLATE_OPCODE(0x7000, 7xxx);
-    VMIL_TRANSLATE_OPCODE(0x7000, 8xxx);
-    VMIL_TRANSLATE_OPCODE(0x9000, 9xxx);
-    VMIL_TRANSLATE_OPCODE(0xA000, Axxx);
-    VMIL_TRANSLATE_OPCODE(0xE000, Exxx);
-    VMIL_TRANSLATE_OPCODE(0xF000, Fxxx);
+    VMIL_TRANSLATE_OPCODE(0x1, 1xxx);
+    VMIL_TRANSLATE_OPCODE(0x3, 3xxx);
+    VMIL_TRANSLATE_OPCODE(0x4, 4xxx);
+    VMIL_TRANSLATE_OPCODE(0x5, 5xxx);
+    VMIL_TRANSLATE_OPCODE(0x6, 6xxx);
+    VMIL_TRANSLATE_OPCODE(0x7, 7xxx);
+    VMIL_TRANSLATE_OPCODE(0x8, 8xxx);
+    VMIL_TRANSLATE_OPCODE(0x9, 9xxx);
+    VMIL_TRANSLATE_OPCODE(0xA, Axxx);
+    VMIL_TRANSLATE_OPCODE(0xE, Exxx);
+    VMIL_TRANSLATE_OPCODE(0xF, Fxxx);
 }
 
 instruction_id_t CHIP8Emulator::getInstructionId(const InstructionPtr &instruction) const
 {
-    return instruction->id & 0xF000;
+    return (instruction->id & 0xF000) >> 12; // Dense: one slot per opcode's nibble
 }
 
-void CHIP8Emulator::translate1xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList& vminstructions)
+void CHIP8Emulator::translate1xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList& vminstructions) const
 {
-    vminstruction = VMIL::emitJcc(instruction);
+    vminstruction = VMIL::emitJcc(instruction, vminstructions);
     vminstruction->imm(VMIL_TRUE);
     vminstruction->imm(VMIL_ADDRESS(instruction->target()));
     vminstruction->target_idx = 1;
-    vminstructions.push_back(vminstruction);
 }
 
-void CHIP8Emulator::translate3xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translate3xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     this->emitEQ(instruction, 0, 1, vminstructions);
 
-    vminstruction = VMIL::emitJcc(instruction, VMIL_INSTRUCTION_I(vminstructions));
+    vminstruction = VMIL::emitJcc(instruction, vminstructions);
     vminstruction->reg(VMIL_DEFAULT_REGISTER);
     vminstruction->imm(VMIL_ADDRESS(instruction->target()));
     vminstruction->target_idx = 1;
-    vminstructions.push_back(vminstruction);
 }
 
-void CHIP8Emulator::translate4xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translate4xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     this->emitNEQ(instruction, 0, 1, vminstructions);
 
-    vminstruction = VMIL::emitJcc(instruction, VMIL_INSTRUCTION_I(vminstructions));
+    vminstruction = VMIL::emitJcc(instruction, vminstructions);
     vminstruction->reg(VMIL_DEFAULT_REGISTER);
     vminstruction->imm(VMIL_ADDRESS(instruction->target()));
     vminstruction->target_idx = 1;
-    vminstructions.push_back(vminstruction);
 }
 
-void CHIP8Emulator::translate5xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translate5xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     this->translate3xxx(instruction, vminstruction, vminstructions);
 }
 
-void CHIP8Emulator::translate6xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translate6xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
-    vminstruction = VMIL::emitStr(instruction);
+    vminstruction = VMIL::emitStr(instruction, vminstructions);
     vminstruction->op(instruction->operands[0]);
     vminstruction->op(instruction->operands[1]);
-    vminstructions.push_back(vminstruction);
 }
 
-void CHIP8Emulator::translate7xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translate7xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
-    vminstruction = VMIL::emitAdd(instruction);
+    vminstruction = VMIL::emitAdd(instruction, vminstructions);
     vminstruction->op(instruction->operands[0]);
     vminstruction->op(instruction->operands[0]);
     vminstruction->imm(instruction->operands[1].u_value);
-    vminstructions.push_back(vminstruction);
 }
 
-void CHIP8Emulator::translate8xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translate8xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     u8 t = instruction->id & 0x000F;
 
     if(t == 0x1)
-        vminstruction = VMIL::emitOr(instruction);
+        vminstruction = VMIL::emitOr(instruction, vminstructions);
     else if(t == 0x2)
-        vminstruction = VMIL::emitAnd(instruction);
+        vminstruction = VMIL::emitAnd(instruction, vminstructions);
     else if(t == 0x3)
-        vminstruction = VMIL::emitXor(instruction);
+        vminstruction = VMIL::emitXor(instruction, vminstructions);
     else if(t == 0x4)
-        vminstruction = VMIL::emitAdd(instruction);
+        vminstruction = VMIL::emitAdd(instruction, vminstructions);
     else if(t == 0x5)
-        vminstruction = VMIL::emitSub(instruction);
+        vminstruction = VMIL::emitSub(instruction, vminstructions);
     else if(t == 0x6)
-        vminstruction = VMIL::emitRsh(instruction);
+        vminstruction = VMIL::emitRsh(instruction, vminstructions);
     else if(t == 0xE)
-        vminstruction = VMIL::emitLsh(instruction);
+        vminstruction = VMIL::emitLsh(instruction, vminstructions);
     else
         return;
 
@@ -107,11 +105,9 @@ void CHIP8Emulator::translate8xxx(const InstructionPtr &instruction, VMIL::VMILI
         vminstruction->op(instruction->operands[0]);
         vminstruction->op(instruction->operands[1]);
     }
-
-    vminstructions.push_back(vminstruction);
 }
 
-void CHIP8Emulator::translate9xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translate9xxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     if((instruction->id & 0x000F) != 0)
         return;
@@ -119,15 +115,14 @@ void CHIP8Emulator::translate9xxx(const InstructionPtr &instruction, VMIL::VMILI
     this->translate4xxx(instruction, vminstruction, vminstructions);
 }
 
-void CHIP8Emulator::translateAxxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translateAxxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
-    vminstruction = VMIL::emitStr(instruction);
+    vminstruction = VMIL::emitStr(instruction, vminstructions);
     vminstruction->op(instruction->op(0));
     vminstruction->op(instruction->op(1));
-    vminstructions.push_back(vminstruction);
 }
 
-void CHIP8Emulator::translateExxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translateExxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     u16 op = instruction->id & 0xFF;
 
@@ -136,13 +131,12 @@ void CHIP8Emulator::translateExxx(const InstructionPtr &instruction, VMIL::VMILI
 
     if(op == 0xA1)
     {
-        vminstruction = VMIL::emitBisz(instruction);
+        vminstruction = VMIL::emitBisz(instruction, vminstructions);
         vminstruction->reg(VMIL_REGISTER(0));
         vminstruction->op(instruction->op(0));
-        vminstructions.push_back(vminstruction);
     }
 
-    vminstruction = VMIL::emitJcc(instruction, VMIL_INSTRUCTION_I(vminstructions));
+    vminstruction = VMIL::emitJcc(instruction, vminstructions);
 
     if(op == 0xA1)
     {
@@ -157,10 +151,9 @@ void CHIP8Emulator::translateExxx(const InstructionPtr &instruction, VMIL::VMILI
 
     vminstruction->imm(VMIL_ADDRESS(instruction->target()));
     vminstruction->target_idx = 0;
-    vminstructions.push_back(vminstruction);
 }
 
-void CHIP8Emulator::translateFxxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translateFxxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     u16 op = instruction->id & 0xFF;
 
@@ -170,7 +163,7 @@ void CHIP8Emulator::translateFxxx(const InstructionPtr &instruction, VMIL::VMILI
         this->translatexxRA(instruction, vminstruction, vminstructions);
 }
 
-void CHIP8Emulator::translateBCD(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translateBCD(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     /*
      * BCD instruction:
@@ -179,71 +172,62 @@ void CHIP8Emulator::translateBCD(const InstructionPtr &instruction, VMIL::VMILIn
      * RAM[I + 2] = (vr % 100) % 10
      */
 
-    vminstruction = VMIL::emitStr(instruction);
+    vminstruction = VMIL::emitStr(instruction, vminstructions);
     vminstruction->reg(VMIL_REGISTER(0)); // i
     vminstruction->reg(CHIP8_REG_I_ID, CHIP8_REG_I);
     vminstruction->cmt("Load i").cmt("*** Begin BCD ***");
-    vminstructions.push_back(vminstruction);
 
     for(size_t i = 0; i < 3; i++)
     {
         if(i)
         {
-            vminstruction = VMIL::emitAdd(instruction, VMIL_INSTRUCTION_I(vminstructions));
+            vminstruction = VMIL::emitAdd(instruction, vminstructions);
             vminstruction->reg(VMIL_REGISTER(0));
             vminstruction->reg(VMIL_REGISTER(0));
             vminstruction->imm(1);
             vminstruction->cmt("i++");
-            vminstructions.push_back(vminstruction);
         }
 
         if(i < 2)
         {
-            vminstruction = VMIL::emitDiv(instruction, VMIL_INSTRUCTION_I(vminstructions));
+            vminstruction = VMIL::emitDiv(instruction, vminstructions);
             vminstruction->reg(VMIL_REGISTER(2));
             vminstruction->op(instruction->op(0));
             vminstruction->imm((i == 0) ? 100 : 10);
-            vminstructions.push_back(vminstruction);
         }
         else
         {
-            vminstruction = VMIL::emitMod(instruction, VMIL_INSTRUCTION_I(vminstructions));
+            vminstruction = VMIL::emitMod(instruction, vminstructions);
             vminstruction->reg(VMIL_REGISTER(2));
             vminstruction->op(instruction->op(0));
             vminstruction->imm(100);
-            vminstructions.push_back(vminstruction);
         }
 
         if(i)
         {
-            vminstruction = VMIL::emitMod(instruction, VMIL_INSTRUCTION_I(vminstructions));
+            vminstruction = VMIL::emitMod(instruction, vminstructions);
             vminstruction->reg(VMIL_REGISTER(2));
             vminstruction->reg(VMIL_REGISTER(2));
             vminstruction->imm(10);
-            vminstructions.push_back(vminstruction);
         }
 
-        vminstruction = VMIL::emitStm(instruction, VMIL_INSTRUCTION_I(vminstructions));
+        vminstruction = VMIL::emitStm(instruction, vminstructions);
         vminstruction->reg(VMIL_REGISTER(0));
         vminstruction->reg(VMIL_REGISTER(2));
+        vminstruction->op_size(1, OperandSizes::Byte); // CHIP-8's RAM is byte addressed
 
-        if(i)
-            vminstruction->cmt("Write RAM[i + " + std::to_string(i) + "]");
-        else
-            vminstruction->cmt("Write RAM[i]");
-
-        vminstructions.push_back(vminstruction);
+        vminstruction->cmt(BCD_COMMENTS[i]);
     }
 
     vminstruction->cmt("*** End BCD ***");
 }
 
-void CHIP8Emulator::translatexxRA(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions)
+void CHIP8Emulator::translatexxRA(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     if(!instruction->is(InstructionTypes::Load) && !instruction->is(InstructionTypes::Store))
         return;
 
-    vminstruction = VMIL::emitStr(instruction);
+    vminstruction = VMIL::emitStr(instruction, vminstructions);
     vminstruction->reg(VMIL_REGISTER(0)); // i
     vminstruction->reg(CHIP8_REG_I_ID, CHIP8_REG_I);
 
@@ -253,26 +237,24 @@ void CHIP8Emulator::translatexxRA(const InstructionPtr &instruction, VMIL::VMILI
         vminstruction->cmt("*** Begin Store ***");
 
     vminstruction->cmt("Load i");
-    vminstructions.push_back(vminstruction);
 
     VMIL::vmilopcode_t opcode = instruction->is(InstructionTypes::Load) ? VMIL::Opcodes::Ldm : VMIL::Opcodes::Stm;
     const Operand& op = instruction->op(0);
 
     for(register_t r = op.reg.r; r >= 0; r--)
     {
-        vminstruction = VMIL::emitInstruction(instruction, opcode, VMIL_INSTRUCTION_I(vminstructions));
+        vminstruction = VMIL::emitInstruction(instruction, opcode, vminstructions);
         vminstruction->reg(VMIL_REGISTER(0));
         vminstruction->reg(r, op.reg.extra_type);
-        vminstructions.push_back(vminstruction);
+        vminstruction->op_size(1, OperandSizes::Byte);
 
         if(r)
         {
-            vminstruction = VMIL::emitSub(instruction, VMIL_INSTRUCTION_I(vminstructions));
+            vminstruction = VMIL::emitSub(instruction, vminstructions);
             vminstruction->reg(VMIL_REGISTER(0));
             vminstruction->reg(VMIL_REGISTER(0));
             vminstruction->imm(1);
             vminstruction->cmt("i--");
-            vminstructions.push_back(vminstruction);
         }
     }
 
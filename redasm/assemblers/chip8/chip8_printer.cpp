@@ -1,6 +1,5 @@
 #include "chip8_printer.h"
 #include "chip8_registers.h"
-#include <sstream>
 
 namespace REDasm {
 
@@ -20,9 +19,10 @@ std::string CHIP8Printer::reg(const RegisterOperand &regop) const
     if(regop.extra_type == CHIP8_REG_ST)
         return "st";
 
-    std::stringstream ss;
-    ss << ((regop.extra_type == CHIP8_REG_K) ? "k" : "v") << std::hex << regop.r;
-    return ss.str();
+    char buffer[HEX_BUFFER_SIZE];
+    std::string s((regop.extra_type == CHIP8_REG_K) ? "k" : "v");
+    s.append(buffer, REDasm::hexstring(buffer, regop.r, 0, false, false));
+    return s;
 }
 
 } // namespace REDasm
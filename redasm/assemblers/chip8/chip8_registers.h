@@ -21,6 +21,7 @@
 #define CHIP8_REG_I_ID  static_cast<register_t>('i')
 #define CHIP8_REG_DT_ID static_cast<register_t>('d')
 #define CHIP8_REG_ST_ID static_cast<register_t>('s')
+#define CHIP8_REG_COUNT (CHIP8_REG_ST_ID + 1) // Ids are sparse, 's' is the highest one
 
 #define CHIP8_REG_K   1
 #define CHIP8_REG_I   2
@@ -4,21 +4,25 @@
 #include "dalvik_opcodes.h"
 #include "dalvik_metadata.h"
 
-#define SET_DECODE_OPCODE_TO(opcode) _opcodemap[0x##opcode] = [this](Buffer& buffer, const InstructionPtr& instruction) -> bool { return decode##opcode(buffer, instruction); }
+#define DECODE_OPCODE(opcode) &DalvikAssembler::decode##opcode
 
-#define SET_DECODE_TO(op) SET_DECODE_OPCODE_TO(op##0); SET_DECODE_OPCODE_TO(op##1); SET_DECODE_OPCODE_TO(op##2); SET_DECODE_OPCODE_TO(op##3); \
-                          SET_DECODE_OPCODE_TO(op##4); SET_DECODE_OPCODE_TO(op##5); SET_DECODE_OPCODE_TO(op##6); SET_DECODE_OPCODE_TO(op##7); \
-                          SET_DECODE_OPCODE_TO(op##8); SET_DECODE_OPCODE_TO(op##9); SET_DECODE_OPCODE_TO(op##A); SET_DECODE_OPCODE_TO(op##B); \
-                          SET_DECODE_OPCODE_TO(op##C); SET_DECODE_OPCODE_TO(op##D); SET_DECODE_OPCODE_TO(op##E); SET_DECODE_OPCODE_TO(op##F)
+#define DECODE_OPCODES(op) DECODE_OPCODE(op##0), DECODE_OPCODE(op##1), DECODE_OPCODE(op##2), DECODE_OPCODE(op##3), \
+                           DECODE_OPCODE(op##4), DECODE_OPCODE(op##5), DECODE_OPCODE(op##6), DECODE_OPCODE(op##7), \
+                           DECODE_OPCODE(op##8), DECODE_OPCODE(op##9), DECODE_OPCODE(op##A), DECODE_OPCODE(op##B), \
+                           DECODE_OPCODE(op##C), DECODE_OPCODE(op##D), DECODE_OPCODE(op##E), DECODE_OPCODE(op##F)
 
 namespace REDasm {
 
+const DalvikAssembler::DecodeCallback DalvikAssembler::_opcodetable[0x100] = {
+    DECODE_OPCODES(0), DECODE_OPCODES(1), DECODE_OPCODES(2), DECODE_OPCODES(3),
+    DECODE_OPCODES(4), DECODE_OPCODES(5), DECODE_OPCODES(6), DECODE_OPCODES(7),
+    DECODE_OPCODES(8), DECODE_OPCODES(9), DECODE_OPCODES(A), DECODE_OPCODES(B),
+    DECODE_OPCODES(C), DECODE_OPCODES(D), DECODE_OPCODES(E), DECODE_OPCODES(F)
+};
+
 DalvikAssembler::DalvikAssembler(): AssemblerPlugin()
 {
-    SET_DECODE_TO(0); SET_DECODE_TO(1); SET_DECODE_TO(2); SET_DECODE_TO(3);
-    SET_DECODE_TO(4); SET_DECODE_TO(5); SET_DECODE_TO(6); SET_DECODE_TO(7);
-    SET_DECODE_TO(8); SET_DECODE_TO(9); SET_DECODE_TO(A); SET_DECODE_TO(B);
-    SET_DECODE_TO(C); SET_DECODE_TO(D); SET_DECODE_TO(E); SET_DECODE_TO(F);
+
 }
 
 const char *DalvikAssembler::name() const
@@ -64,13 +68,8 @@ bool DalvikAssembler::decode(Buffer buffer, const InstructionPtr &instruction)
 {
     instruction->id = *buffer;
 
-    auto it = this->_opcodemap.find(instruction->id);
-
-    if(it == this->_opcodemap.end())
-        return false;
-
     Buffer bwords = buffer + 1;
-    bool res = it->second(bwords, instruction);
+    bool res = (this->*DalvikAssembler::_opcodetable[instruction->id])(bwords, instruction); // Every opcode has a slot
 
     if(!res)
         instruction->size = sizeof(u16); // Dalvik uses always 16-bit aligned instructions
@@ -16,7 +16,7 @@ namespace REDasm {
 class DalvikAssembler : public AssemblerPlugin
 {
     private:
-        typedef std::function<bool(Buffer&, const InstructionPtr&)> DecodeCallback;
+        typedef bool (DalvikAssembler::*DecodeCallback)(Buffer&, const InstructionPtr&) const;
 
     public:
         DalvikAssembler();
@@ -64,8 +64,7 @@ class DalvikAssembler : public AssemblerPlugin
         DEX_DECLARE_DECODES(F);
 
     private:
-        std::unordered_map<u8, DecodeCallback> _opcodemap;
-
+        static const DecodeCallback _opcodetable[0x100]; // One slot per opcode, built at compile time
 };
 
 DECLARE_ASSEMBLER_PLUGIN(DalvikAssembler, dalvik)
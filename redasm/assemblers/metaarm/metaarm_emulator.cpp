@@ -3,7 +3,7 @@
 
 namespace REDasm {
 
-MetaARMEmulator::MetaARMEmulator(DisassemblerAPI *disassembler): VMIL::Emulator(disassembler)
+MetaARMEmulator::MetaARMEmulator(DisassemblerAPI *disassembler): VMIL::Emulator(disassembler, ARM_REG_ENDING)
 {
     VMIL_TRANSLATE_OPCODE(ARM_INS_LDR, Ldr);
     VMIL_TRANSLATE_OPCODE(ARM_INS_B, Branch);
@@ -12,24 +12,21 @@ MetaARMEmulator::MetaARMEmulator(DisassemblerAPI *disassembler): VMIL::Emulator(
 
 void MetaARMEmulator::translateLdr(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
-    vminstruction = VMIL::emitDef(instruction, VMIL_INSTRUCTION_I(vminstructions));
+    vminstruction = VMIL::emitDef(instruction, vminstructions);
     vminstruction->op(instruction->op(0));
-    vminstructions.push_back(vminstruction);
 
-    vminstruction = VMIL::emitLdm(instruction, VMIL_INSTRUCTION_I(vminstructions));
+    vminstruction = VMIL::emitLdm(instruction, vminstructions);
     vminstruction->op(instruction->op(0));
     vminstruction->op(instruction->op(1));
     vminstruction->op_size(1, OperandSizes::Dword);
-    vminstructions.push_back(vminstruction);
 }
 
 void MetaARMEmulator::translateBranch(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
-    vminstruction = VMIL::emitJcc(instruction, VMIL_INSTRUCTION_I(vminstructions));
+    vminstruction = VMIL::emitJcc(instruction, vminstructions);
     vminstruction->imm(VMIL_TRUE);
     vminstruction->op(instruction->op(0));
     vminstruction->target_idx = 0;
-    vminstructions.push_back(vminstruction);
 }
 
 } // namespace REDasm
@@ -3,7 +3,7 @@
 
 namespace REDasm {
 
-MIPSEmulator::MIPSEmulator(DisassemblerAPI *disassembler): VMIL::Emulator(disassembler)
+MIPSEmulator::MIPSEmulator(DisassemblerAPI *disassembler): VMIL::Emulator(disassembler, MIPS_REG_ENDING)
 {
     VMIL_TRANSLATE_OPCODE(MIPS_INS_LB,  Lxx);
     VMIL_TRANSLATE_OPCODE(MIPS_INS_LH,  Lxx);
@@ -44,17 +44,19 @@ MIPSEmulator::MIPSEmulator(DisassemblerAPI *disassembler): VMIL::Emulator(disass
     VMIL_TRANSLATE_OPCODE(MIPS_INS_SRL, SRL);
 }
 
-bool MIPSEmulator::emulate(const InstructionPtr &instruction)
+bool MIPSEmulator::entryValue(VMIL::vmilregister_t reg, u64 *value) const
 {
-    this->write(MIPS_REG_ZERO, 0); // Initialize $zero
+    if(reg != MIPS_REG_ZERO)
+        return false;
 
-    return VMIL::Emulator::emulate(instruction);
+    *value = 0; // $zero is hardwired
+    return true;
 }
 
 void MIPSEmulator::translateLxx(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
     this->emitDisplacement(instruction, 1, vminstructions);
-    vminstruction = VMIL::emitLdm(instruction, VMIL_INSTRUCTION_I(vminstructions));
+    vminstruction = VMIL::emitLdm(instruction, vminstructions);
 
     if((instruction->id == MIPS_INS_LWL) || (instruction->id == MIPS_INS_LWR))
         vminstruction->reg(VMIL_REGISTER(1)); // Temporary register for HI/LO part management
@@ -62,7 +64,6 @@ void MIPSEmulator::translateLxx(const InstructionPtr &instruction, VMIL::VMILIns
         vminstruction->op(instruction->op(0));
 
     vminstruction->reg(VMIL_DEFAULT_REGISTER);
-    vminstructions.push_back(vminstruction);
 
     switch(instruction->id)
     {
@@ -88,17 +89,15 @@ void MIPSEmulator::translateLxx(const InstructionPtr &instruction, VMIL::VMILIns
 
     if((instruction->id == MIPS_INS_LWL) || (instruction->id == MIPS_INS_LWR))
     {
-        vminstruction = VMIL::emitAnd(instruction, VMIL_INSTRUCTION_I(vminstructions));
+        vminstruction = VMIL::emitAnd(instruction, vminstructions);
         vminstruction->reg(VMIL_REGISTER(1));
         vminstruction->reg(VMIL_REGISTER(1));
         vminstruction->imm((instruction->id == MIPS_INS_LWL) ? 0x0000FFFF : 0xFFFF0000);
-        vminstructions.push_back(vminstruction);
 
-        vminstruction = VMIL::emitOr(instruction, VMIL_INSTRUCTION_I(vminstructions));
+        vminstruction = VMIL::emitOr(instruction, vminstructions);
         vminstruction->op(instruction->op(0));
         vminstruction->op(instruction->op(0));
         vminstruction->reg(VMIL_REGISTER(1));
-        vminstructions.push_back(vminstruction);
     }
 }
 
@@ -106,20 +105,18 @@ void MIPSEmulator::translateSxx(const InstructionPtr &instruction, VMIL::VMILIns
 {
     if((instruction->id == MIPS_INS_SWL) || (instruction->id == MIPS_INS_SWR))
     {
-        vminstruction = VMIL::emitStr(instruction, VMIL_INSTRUCTION_I(vminstructions));
+        vminstruction = VMIL::emitStr(instruction, vminstructions);
         vminstruction->reg(VMIL_REGISTER(1));
         vminstruction->op(instruction->op(0));
-        vminstructions.push_back(vminstruction);
 
-        vminstruction = VMIL::emitAnd(instruction, VMIL_INSTRUCTION_I(vminstructions));
+        vminstruction = VMIL::emitAnd(instruction, vminstructions);
         vminstruction->reg(VMIL_REGISTER(1));
         vminstruction->reg(VMIL_REGISTER(1));
         vminstruction->imm((instruction->id == MIPS_INS_LWL) ? 0x0000FFFF : 0xFFFF0000);
-        vminstructions.push_back(vminstruction);
     }
 
     this->emitDisplacement(instruction, 1, vminstructions);
-    vminstruction = VMIL::emitStm(instruction, VMIL_INSTRUCTION_I(vminstructions));
+    vminstruction = VMIL::emitStm(instruction, vminstructions);
     vminstruction->reg(VMIL_DEFAULT_REGISTER);
 
     if((instruction->id == MIPS_INS_SWL) || (instruction->id == MIPS_INS_SWR))
@@ -127,7 +124,6 @@ void MIPSEmulator::translateSxx(const InstructionPtr &instruction, VMIL::VMILIns
     else
         vminstruction->op(instruction->op(0));
 
-    vminstructions.push_back(vminstruction);
 
     switch(instruction->id)
     {
@@ -152,40 +148,35 @@ void MIPSEmulator::translateSxx(const InstructionPtr &instruction, VMIL::VMILIns
 
 void MIPSEmulator::translateLUI(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
-    vminstruction = VMIL::emitStr(instruction);
+    vminstruction = VMIL::emitStr(instruction, vminstructions);
     vminstruction->op(instruction->op(0));
     vminstruction->op(instruction->op(1));
-    vminstructions.push_back(vminstruction);
 
-    vminstruction = VMIL::emitLsh(instruction, VMIL_INSTRUCTION_I(vminstructions));
+    vminstruction = VMIL::emitLsh(instruction, vminstructions);
     vminstruction->op(instruction->op(0));
     vminstruction->op(instruction->op(0));
     vminstruction->imm(16);
-    vminstructions.push_back(vminstruction);
 }
 
 void MIPSEmulator::translateNOP(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
-    vminstruction = VMIL::emitNop(instruction);
-    vminstructions.push_back(vminstruction);
+    vminstruction = VMIL::emitNop(instruction, vminstructions);
 }
 
 void MIPSEmulator::translateSLL(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
-    vminstruction = VMIL::emitLsh(instruction);
+    vminstruction = VMIL::emitLsh(instruction, vminstructions);
     vminstruction->op(instruction->op(0));
     vminstruction->op(instruction->op(1));
     vminstruction->op(instruction->op(2));
-    vminstructions.push_back(vminstruction);
 }
 
 void MIPSEmulator::translateSRL(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
 {
-    vminstruction = VMIL::emitRsh(instruction);
+    vminstruction = VMIL::emitRsh(instruction, vminstructions);
     vminstruction->op(instruction->op(0));
     vminstruction->op(instruction->op(1));
     vminstruction->op(instruction->op(2));
-    vminstructions.push_back(vminstruction);
 }
 
 void MIPSEmulator::translateMath(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
@@ -196,23 +187,23 @@ void MIPSEmulator::translateMath(const InstructionPtr &instruction, VMIL::VMILIn
         case MIPS_INS_ADDI:
         case MIPS_INS_ADDU:
         case MIPS_INS_ADDIU:
-            vminstruction = VMIL::emitAdd(instruction);
+            vminstruction = VMIL::emitAdd(instruction, vminstructions);
             break;
 
         case MIPS_INS_SUB:
         case MIPS_INS_SUBU:
-            vminstruction = VMIL::emitSub(instruction);
+            vminstruction = VMIL::emitSub(instruction, vminstructions);
             break;
 
         case MIPS_INS_MUL:
         case MIPS_INS_MULT:
         case MIPS_INS_MULTU:
-            vminstruction = VMIL::emitMul(instruction);
+            vminstruction = VMIL::emitMul(instruction, vminstructions);
             break;
 
         case MIPS_INS_DIV:
         case MIPS_INS_DIVU:
-            vminstruction = VMIL::emitDiv(instruction);
+            vminstruction = VMIL::emitDiv(instruction, vminstructions);
             break;
 
         default:
@@ -232,8 +223,6 @@ void MIPSEmulator::translateMath(const InstructionPtr &instruction, VMIL::VMILIn
         vminstruction->op(instruction->op(1));
         vminstruction->op(instruction->op(2));
     }
-
-    vminstructions.push_back(vminstruction);
 }
 
 void MIPSEmulator::translateBitwise(const InstructionPtr &instruction, VMIL::VMILInstructionPtr &vminstruction, VMIL::VMILInstructionList &vminstructions) const
@@ -242,17 +231,17 @@ void MIPSEmulator::translateBitwise(const InstructionPtr &instruction, VMIL::VMI
     {
         case MIPS_INS_AND:
         case MIPS_INS_ANDI:
-            vminstruction = VMIL::emitAnd(instruction);
+            vminstruction = VMIL::emitAnd(instruction, vminstructions);
             break;
 
         case MIPS_INS_OR:
         case MIPS_INS_ORI:
-            vminstruction = VMIL::emitOr(instruction);
+            vminstruction = VMIL::emitOr(instruction, vminstructions);
             break;
 
         case MIPS_INS_XOR:
         case MIPS_INS_XORI:
-            vminstruction = VMIL::emitXor(instruction);
+            vminstruction = VMIL::emitXor(instruction, vminstructions);
             break;
 
         default:
@@ -272,8 +261,6 @@ void MIPSEmulator::translateBitwise(const InstructionPtr &instruction, VMIL::VMI
         vminstruction->op(instruction->op(1));
         vminstruction->op(instruction->op(2));
     }
-
-    vminstructions.push_back(vminstruction);
 }
 
 } // namespace REDasm
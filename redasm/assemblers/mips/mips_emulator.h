@@ -9,7 +9,7 @@ class MIPSEmulator : public VMIL::Emulator
 {
     public:
         MIPSEmulator(DisassemblerAPI* disassembler);
-        virtual bool emulate(const InstructionPtr &instruction);
+        virtual bool entryValue(VMIL::vmilregister_t reg, u64* value) const;
 
     private:
         void translateLxx(const InstructionPtr& instruction, VMIL::VMILInstructionPtr& vminstruction, VMIL::VMILInstructionList& vminstructions) const;
@@ -1,17 +1,25 @@
 #include "disassembler.h"
 #include <algorithm>
 #include <memory>
+#include <thread>
+#include <chrono>
+#include <limits>
+#include <sstream>
 
 #define INVALID_MNEMONIC      "db"
 #define INSTRUCTION_THRESHOLD 10
+#define PASSES_BUDGET         4096
+#define PASSES_PAUSE_INTERVAL 50 // ms
+#define ANALYZER_LAZY_BUDGET  1  // Functions or watched symbols for each step, like a single instruction in the other passes
 
 namespace REDasm {
 
-Disassembler::Disassembler(Buffer buffer, AssemblerPlugin *assembler, FormatPlugin *format): DisassemblerBase(buffer, format), _assembler(assembler)
+Disassembler::Disassembler(Buffer buffer, AssemblerPlugin *assembler, FormatPlugin *format): DisassemblerBase(buffer, format), _assembler(assembler), _dataflowchanged(false), _pass(PassTypes::None), _passsegment(0), _passaddress(0), _passpaused(false), _passcancelled(false), _lazy(false)
 {
     if(!format->isBinary())
         assembler->setEndianness(format->endianness());
 
+    this->_printercache = std::make_unique<PrinterCache>(&this->_journal);
     this->_printer = PrinterPtr(this->_assembler->createPrinter(this, this->_symboltable));
     this->_emulator = assembler->hasVMIL() ? assembler->createEmulator(this) : NULL;
 
@@ -19,10 +27,15 @@ Disassembler::Disassembler(Buffer buffer, AssemblerPlugin *assembler, FormatPlug
     this->_listing.setAssembler(this->_assembler);
     this->_listing.setSymbolTable(this->_symboltable);
     this->_listing.setReferenceTable(&this->_referencetable);
+    this->_listing.setJournal(&this->_journal);
+    this->_vmilcache = this->_emulator ? new VMIL::VMILCache(this->_emulator, &this->_listing, &this->_journal) : NULL;
 }
 
 Disassembler::~Disassembler()
 {
+    if(this->_vmilcache)
+        delete this->_vmilcache;
+
     if(this->_emulator)
         delete this->_emulator;
 
@@ -100,93 +113,145 @@ std::string Disassembler::comment(const InstructionPtr &instruction) const
      return "# " + res;
 }
 
+VMIL::VMILCache *Disassembler::vmilCache()
+{
+    return this->_vmilcache;
+}
+
 bool Disassembler::iterateVMIL(address_t address, Listing::InstructionCallback cbinstruction, Listing::SymbolCallback cbstart, Listing::InstructionCallback cbend, Listing::SymbolCallback cblabel)
 {
-    std::unique_ptr<VMIL::Emulator> emulator(this->_assembler->createEmulator(this));
+    if(!this->_vmilcache)
+        return false;
+
+    VMIL::VMILFunctionPtr vmilfunction = this->_vmilcache->function(address);
 
-    if(!emulator)
+    if(!vmilfunction)
         return false;
 
-    return this->_listing.iterateFunction(address, [this, &emulator, &cbinstruction](const InstructionPtr& instruction) {
-        VMIL::VMILInstructionList vminstructions;
-        emulator->translate(instruction, vminstructions);
+    return this->_listing.iterateFunction(address, [&vmilfunction, &cbinstruction](const InstructionPtr& instruction) {
+        const VMIL::VMILInstruction* vminstructions = NULL;
+        size_t count = 0;
 
-        std::for_each(vminstructions.begin(), vminstructions.end(), [cbinstruction](const VMIL::VMILInstructionPtr& vminstruction) {
-           cbinstruction(vminstruction);
-        });
+        if(!vmilfunction->range(instruction->address, &vminstructions, &count))
+            return;
+
+        for(size_t i = 0; i < count; i++) // Printers work on full instructions
+            cbinstruction(VMIL::toInstruction(vminstructions[i]));
 
     }, cbstart, cbend, cblabel);
 }
 
-void Disassembler::disassembleUnexploredCode()
+void Disassembler::disassembleReachable()
 {
-    for(auto it = this->_format->segments().begin(); it != this->_format->segments().end(); it++)
+    SymbolPtr entrypoint = this->_symboltable->entryPoint();
+    this->_progress.begin(ProgressPhases::Disassembling, this->codeSize());
+
+    if(entrypoint)
     {
-        const Segment& segment = *it;
+        this->_progress.functionFound();
+        this->disassemble(entrypoint->address); // Disassemble entry point (1)
+        this->_listing.checkBounds(entrypoint->address);
+    }
 
-        if(!segment.is(SegmentTypes::Code))
-            continue;
+    // Preload format functions for analysis, exports included (2)
+    this->_symboltable->iterate(SymbolTypes::FunctionMask, [this, &entrypoint](SymbolPtr symbol) -> bool {
+        if(!entrypoint || (symbol->address != entrypoint->address))
+            this->_progress.functionFound();
 
-        this->searchStrings(segment);
-        this->searchCode(segment);
-    }
+        this->disassemble(symbol->address);
+        this->_listing.checkBounds(symbol->address);
+        return true;
+    });
 }
 
-void Disassembler::searchCode(const Segment &segment)
+void Disassembler::schedulePasses()
 {
-    address_t address = segment.address;
+    this->_passcancelled = false;
+    this->_passsegment = 0;
+    this->_pass = PassTypes::Dataflow;
+    this->resetDataflow();
+    this->_dataflowchanged = true; // Seeds the worklist
+
+    // Analyze and disassemble unexplored bytes in code sections (3), resolve registers (4), then run the analyzer (5)
+    if(!(this->_format->flags() & FormatFlags::IgnoreUnexploredCode) && this->nextCodeSegment())
+        this->_progress.begin(ProgressPhases::Exploring, this->codeSize() * 2); // Strings + Code
+}
+
+u64 Disassembler::codeSize() const
+{
+    u64 size = 0;
+    const SegmentList& segments = this->_format->segments();
 
-    while(address < segment.endaddress)
+    for(auto it = segments.begin(); it != segments.end(); it++)
     {
-        REDasm::status("Searching code @ " + REDasm::hex(address));
+        if(it->is(SegmentTypes::Code))
+            size += it->size();
+    }
 
-        if(this->skipExploredData(address))
-            continue;
+    return size;
+}
 
-        if(this->skipPadding(address))
-            continue;
+bool Disassembler::nextCodeSegment()
+{
+    const SegmentList& segments = this->_format->segments();
+
+    for( ; this->_passsegment < segments.size(); this->_passsegment++)
+    {
+        const Segment& segment = segments[this->_passsegment];
 
-        if(!this->maybeValidCode(address))
+        if(!segment.is(SegmentTypes::Code))
             continue;
 
-        this->disassembleFunction(address);
+        this->_pass = PassTypes::Strings;
+        this->_passaddress = segment.address;
+        return true;
     }
+
+    return false;
 }
 
-void Disassembler::searchStrings(const Segment &segment)
+void Disassembler::searchCode(address_t &address)
 {
-    address_t address = segment.address;
-    u64 value = 0;
-    bool wide = false;
+    if(this->skipExploredData(address))
+        return;
 
-    while(address < segment.endaddress)
-    {
-        REDasm::status("Searching strings @ " + REDasm::hex(address));
+    if(this->skipPadding(address))
+        return;
 
-        if(this->skipExploredData(address))
-            continue;
+    if(!this->maybeValidCode(address))
+        return;
 
-        if(this->locationIsString(address, &wide) >= MIN_STRING)
-        {
-            if(wide)
-            {
-                this->_symboltable->createWString(address);
-                address += this->readWString(address).size() * sizeof(u16);
-            }
-            else
-            {
-                this->_symboltable->createString(address);
-                address += this->readString(address).size();
-            }
+    this->disassembleFunction(address);
+}
 
-            if(this->readAddress(address, wide ? sizeof(u16) : sizeof(char), &value) && !value) // Check for null terminator
-                address += (wide ? sizeof(u16) : sizeof(char));
+void Disassembler::searchStrings(address_t &address)
+{
+    u64 value = 0;
+    bool wide = false;
 
-            continue;
+    if(this->skipExploredData(address))
+        return;
+
+    if(this->locationIsString(address, &wide) >= MIN_STRING)
+    {
+        if(wide)
+        {
+            this->_symboltable->createWString(address);
+            address += this->readWString(address).size() * sizeof(u16);
+        }
+        else
+        {
+            this->_symboltable->createString(address);
+            address += this->readString(address).size();
         }
 
-        address++;
+        if(this->readAddress(address, wide ? sizeof(u16) : sizeof(char), &value) && !value) // Check for null terminator
+            address += (wide ? sizeof(u16) : sizeof(char));
+
+        return;
     }
+
+    address++;
 }
 
 bool Disassembler::skipExploredData(address_t &address)
@@ -329,6 +394,7 @@ bool Disassembler::disassembleFunction(address_t address, const std::string &nam
     else
         this->_symboltable->createFunction(address, name);
 
+    this->_progress.functionFound();
     this->disassemble(address);
     this->_listing.checkBounds(address);
     return true;
@@ -336,43 +402,165 @@ bool Disassembler::disassembleFunction(address_t address, const std::string &nam
 
 void Disassembler::disassemble()
 {
-    SymbolPtr entrypoint = this->_symboltable->entryPoint();
+    this->disassembleReachable();
+    this->schedulePasses();
 
-    if(entrypoint)
+    while(this->runPendingPasses(PASSES_BUDGET))
     {
-        this->disassemble(entrypoint->address); // Disassemble entry point (1)
-        this->_listing.checkBounds(entrypoint->address);
+        if(this->_passpaused)
+            std::this_thread::sleep_for(std::chrono::milliseconds(PASSES_PAUSE_INTERVAL));
     }
 
-    // Preload format functions for analysis (2)
-    this->_symboltable->iterate(SymbolTypes::FunctionMask, [this](SymbolPtr symbol) -> bool {
-        this->disassemble(symbol->address);
-        this->_listing.checkBounds(symbol->address);
-        return true;
-    });
+    this->_listing.markEntryPoint();
+}
 
-    // Analyze and disassemble unexplored bytes in code sections (3)
-    if(!(this->_format->flags() & FormatFlags::IgnoreUnexploredCode))
-    {
-        REDasm::status("Looking for missing code...");
-        this->disassembleUnexploredCode();
-    }
+void Disassembler::disassembleLazy()
+{
+    this->_lazy = true;
+    this->disassembleReachable();
+    this->_symboltable->sort();
+    this->_listing.markEntryPoint();
+
+    this->schedulePasses(); // Everything else is left to runPendingPasses()
+}
 
-    std::unique_ptr<Analyzer> a(this->_format->createAnalyzer(this, this->_format->signatures()));
+bool Disassembler::disassembleOnDemand(address_t address)
+{
+    if(!this->_lazy || (this->_listing.find(address) != this->_listing.end()))
+        return false;
+
+    Segment* segment = this->_format->segment(address);
+
+    if(!segment || !segment->is(SegmentTypes::Code))
+        return false;
+
+    SymbolPtr symbol = this->_symboltable->symbol(address);
+
+    if(symbol && !symbol->is(SymbolTypes::Code)) // Don't turn known data into code
+        return false;
+
+    return this->disassembleFunction(address);
+}
+
+bool Disassembler::hasPendingPasses() const
+{
+    return this->_pass != PassTypes::None;
+}
+
+u32 Disassembler::currentPass() const
+{
+    return this->_pass;
+}
+
+bool Disassembler::passesPaused() const
+{
+    return this->_passpaused;
+}
+
+bool Disassembler::runPendingPasses(size_t budget)
+{
+    const SegmentList& segments = this->_format->segments();
 
-    if(a)
+    for( ; budget && !this->_passpaused && this->hasPendingPasses(); budget--)
     {
-        REDasm::status("Analyzing...");
-        a->analyze(this->_listing);
+        if(this->_passcancelled)
+        {
+            REDasm::log("Background passes cancelled");
+            this->_progress.begin(ProgressPhases::Done);
+            this->_analyzer.reset();
+            this->resetDataflow();
+            this->_pass = PassTypes::None;
+            break;
+        }
+
+        address_t address = this->_passaddress;
+
+        if(this->_pass == PassTypes::Strings)
+        {
+            const Segment& segment = segments[this->_passsegment];
+
+            if(this->_passaddress < segment.endaddress)
+            {
+                this->searchStrings(this->_passaddress);
+                this->_progress.advance(this->_passaddress - address);
+            }
+            else
+            {
+                this->_pass = PassTypes::Code;
+                this->_passaddress = segment.address;
+            }
+        }
+        else if(this->_pass == PassTypes::Code)
+        {
+            const Segment& segment = segments[this->_passsegment];
+
+            if(this->_passaddress < segment.endaddress)
+            {
+                this->searchCode(this->_passaddress);
+                this->_progress.advance(this->_passaddress - address);
+            }
+            else
+            {
+                this->_passsegment++;
+
+                if(!this->nextCodeSegment())
+                    this->_pass = PassTypes::Dataflow;
+            }
+        }
+        else if(this->_pass == PassTypes::Dataflow)
+        {
+            if(!this->propagateConstants()) // A single function for each step
+                this->_pass = PassTypes::Analyzer;
+        }
+        else if(this->_pass == PassTypes::Analyzer)
+        {
+            if(!this->_analyzer)
+            {
+                this->_analyzer.reset(this->_format->createAnalyzer(this, this->_format->signatures()));
+
+                if(this->_analyzer)
+                {
+                    this->_analyzer->setStepCallback(this->_analyzercallback);
+                    this->_progress.begin(ProgressPhases::Analyzing);
+                }
+            }
+
+            if(!this->_analyzer || !this->_analyzer->analyzeStep(this->_listing, this->_lazy ? ANALYZER_LAZY_BUDGET : std::numeric_limits<size_t>::max()))
+            {
+                this->_analyzer.reset();
+                this->_pass = PassTypes::Sort;
+            }
+        }
+        else if(this->_pass == PassTypes::Sort)
+        {
+            this->_progress.begin(ProgressPhases::Sorting);
+            this->_symboltable->sort();
+            this->_progress.begin(ProgressPhases::Done);
+            this->_pass = PassTypes::None;
+        }
     }
 
-    REDasm::status("Sorting symbols...");
-    this->_symboltable->sort();
+    return this->hasPendingPasses();
+}
 
-    REDasm::status("Marking Entry Point...");
-    this->_listing.markEntryPoint();
+void Disassembler::pausePasses()
+{
+    this->_passpaused = true;
+}
+
+void Disassembler::resumePasses()
+{
+    this->_passpaused = false;
 }
 
+void Disassembler::cancelPasses()
+{
+    this->_passcancelled = true;
+    this->_passpaused = false;
+}
+
+void Disassembler::setAnalyzerCallback(const AnalyzerPipeline::StepCallback &cb) { this->_analyzercallback = cb; }
+
 AssemblerPlugin *Disassembler::assembler()
 {
     return this->_assembler;
@@ -383,6 +571,11 @@ VMIL::Emulator *Disassembler::emulator()
     return this->_emulator;
 }
 
+PrinterCache *Disassembler::printerCache()
+{
+    return this->_printercache.get();
+}
+
 void Disassembler::updateInstruction(const InstructionPtr &instruction)
 {
     this->_listing.update(instruction);
@@ -452,11 +645,10 @@ bool Disassembler::disassemble(address_t address)
         if(this->_listing.find(address) != this->_listing.end())
             break;
 
-        REDasm::status("Disassembling @ " + REDasm::hex(address, this->_format->bits(), false));
-
         instruction = this->disassembleInstruction(address);    // Disassemble single instruction
         this->_listing.commit(address, instruction);            // Mark address as decoded
         this->analyzeInstruction(instruction);                  // Analyze instruction operands
+        this->_progress.advance(instruction->size);
 
         if(this->_assembler->done(instruction))
             break;
@@ -488,9 +680,6 @@ void Disassembler::analyzeInstruction(const InstructionPtr &instruction)
     if(instruction->isInvalid())
         return;
 
-    if(this->_emulator)
-        this->_emulator->emulate(instruction);
-
     const OperandList& operands = instruction->operands;
 
     std::for_each(operands.begin(), operands.end(), [this, instruction](const Operand& operand) {
@@ -510,6 +699,128 @@ void Disassembler::analyzeInstruction(const InstructionPtr &instruction)
     }
 }
 
+void Disassembler::resetDataflow()
+{
+    this->_constprop.reset();
+    this->_dataflowqueue.clear();
+    this->_dataflowsizes.clear();
+    this->_dataflowapplied.clear();
+}
+
+bool Disassembler::propagateConstants()
+{
+    if(!this->_vmilcache)
+        return false;
+
+    if(!this->_constprop)
+        this->_constprop = std::make_unique<VMIL::ConstantPropagation>(this, this->_listing, this->_emulator);
+
+    while(!this->_dataflowqueue.empty())
+    {
+        address_t address = this->_dataflowqueue.front();
+        this->_dataflowqueue.pop_front();
+
+        VMIL::VMILFunctionPtr vmilfunction = this->_vmilcache->function(address);
+
+        if(!vmilfunction)
+            continue;
+
+        auto it = this->_dataflowsizes.find(address);
+
+        if((it != this->_dataflowsizes.end()) && (it->second == vmilfunction->ranges.size())) // Same code, same result
+            continue;
+
+        this->propagateConstants(address, vmilfunction);
+        return true;
+    }
+
+    if(!this->_dataflowchanged) // Fixpoint: no function grew and no new function was found
+    {
+        this->resetDataflow();
+        return false;
+    }
+
+    this->_dataflowchanged = false;
+
+    this->_symboltable->iterate(SymbolTypes::FunctionMask, [this](const SymbolPtr& symbol) -> bool {
+        this->_dataflowqueue.push_back(symbol->address);
+        return true;
+    });
+
+    return true;
+}
+
+void Disassembler::propagateConstants(address_t address, const VMIL::VMILFunctionPtr &vmilfunction)
+{
+    VMIL::ConstantPropagation::ConstantList constants, pending;
+    this->_constprop->run(vmilfunction, constants);
+
+    for(const VMIL::ConstantPropagation::Constant& constant : constants)
+    {
+        auto key = std::make_pair(constant.address, constant.index);
+
+        if(this->_dataflowapplied.find(key) != this->_dataflowapplied.end())
+            continue;
+
+        auto it = this->_listing.find(constant.address);
+
+        if(it == this->_listing.end())
+            continue;
+
+        if(!(*it)->is(InstructionTypes::Jump))
+        {
+            pending.push_back(constant);
+            continue;
+        }
+
+        // A resolved jump can grow the function and turn the other values into Bottom:
+        // apply it alone and run the function again over its new CFG
+        this->_dataflowapplied.insert(key);
+        this->applyConstant(constant);
+        this->_dataflowsizes.erase(address);
+        this->_dataflowqueue.push_front(address);
+        this->_dataflowchanged = true;
+        return;
+    }
+
+    this->_dataflowsizes[address] = vmilfunction->ranges.size(); // The CFG is final, its values are too
+
+    for(const VMIL::ConstantPropagation::Constant& constant : pending)
+    {
+        this->_dataflowapplied.insert(std::make_pair(constant.address, constant.index));
+        this->applyConstant(constant);
+        this->_dataflowchanged = true;
+    }
+}
+
+void Disassembler::applyConstant(const VMIL::ConstantPropagation::Constant &constant)
+{
+    auto it = this->_listing.find(constant.address);
+
+    if(it == this->_listing.end())
+        return;
+
+    InstructionPtr instruction = *it;
+    const Operand& operand = instruction->op(constant.index);
+
+    if(operand.is(OperandTypes::Displacement))
+    {
+        if(!this->_format->segment(constant.value))
+            return;
+
+        if(instruction->is(InstructionTypes::Jump)) // Jump table's base
+            this->checkJumpTable(instruction, Operand(OperandTypes::Memory, 0, constant.value, constant.index));
+        else
+            this->checkLocation(instruction, constant.value); // Updates instruction
+    }
+    else
+        this->_assembler->analyzeRegister(this, instruction, operand, constant.value);
+
+    std::for_each(instruction->targets.begin(), instruction->targets.end(), [this](address_t target) {
+        this->disassemble(target); // Disassemble resolved targets
+    });
+}
+
 void Disassembler::makeInvalidInstruction(const InstructionPtr &instruction, Buffer& b)
 {
     if(!instruction->size)
@@ -1,12 +1,20 @@
 #ifndef DISASSEMBLER_H
 #define DISASSEMBLER_H
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include "../plugins/plugins.h"
 #include "types/listing.h"
+#include "../vmil/vmil_constprop.h"
 #include "disassemblerbase.h"
 
 namespace REDasm {
 
+namespace PassTypes {
+    enum: u32 { None = 0, Strings, Code, Dataflow, Analyzer, Sort };
+}
+
 class Disassembler: public DisassemblerBase
 {
     public:
@@ -16,10 +24,23 @@ class Disassembler: public DisassemblerBase
         bool canBeJumpTable(address_t address) const;
         size_t walkJumpTable(const InstructionPtr &instruction, address_t address);
         void disassemble();
+        void disassembleLazy();
+        bool disassembleOnDemand(address_t address);
+
+    public: // Background passes
+        bool hasPendingPasses() const;
+        u32 currentPass() const;
+        bool passesPaused() const;
+        bool runPendingPasses(size_t budget);
+        void pausePasses();
+        void resumePasses();
+        void cancelPasses();
+        void setAnalyzerCallback(const AnalyzerPipeline::StepCallback& cb); // Steps of the analyzer pass, for profiling
 
     public: // Primitive functions
         virtual AssemblerPlugin* assembler();
         virtual VMIL::Emulator* emulator();
+        virtual PrinterCache* printerCache();
         virtual void checkJumpTable(const InstructionPtr& instruction, const Operand &operand);
         virtual void updateInstruction(const InstructionPtr& instruction);
         virtual bool dataToString(address_t address);
@@ -29,23 +50,45 @@ class Disassembler: public DisassemblerBase
 
     public:
         std::string comment(const InstructionPtr& instruction) const;
+        VMIL::VMILCache* vmilCache();
         bool iterateVMIL(address_t address, Listing::InstructionCallback cbinstruction, Listing::SymbolCallback cbstart, Listing::InstructionCallback cbend, Listing::SymbolCallback cblabel);
 
     private:
-        void disassembleUnexploredCode();
-        void searchCode(const Segment &segment);
-        void searchStrings(const Segment& segment);
+        void disassembleReachable();
+        void schedulePasses();
+        u64 codeSize() const;
+        bool nextCodeSegment();
+        void searchCode(address_t& address);
+        void searchStrings(address_t& address);
         bool skipExploredData(address_t& address);
         bool skipPadding(address_t& address);
         bool maybeValidCode(address_t& address);
         void analyzeInstruction(const InstructionPtr& instruction);
+        void resetDataflow();
+        bool propagateConstants();
+        void propagateConstants(address_t address, const VMIL::VMILFunctionPtr& vmilfunction);
+        void applyConstant(const VMIL::ConstantPropagation::Constant& constant);
         void makeInvalidInstruction(const InstructionPtr& instruction, Buffer &b);
 
     private:
         AssemblerPlugin* _assembler;
         VMIL::Emulator* _emulator;
+        VMIL::VMILCache* _vmilcache;
+        std::unique_ptr<VMIL::ConstantPropagation> _constprop; // Alive while the dataflow pass is running
+        std::unique_ptr<Analyzer> _analyzer;                   // Alive while the analyzer pass is running
+        AnalyzerPipeline::StepCallback _analyzercallback;
+        std::deque<address_t> _dataflowqueue;                  // Functions waiting for constant propagation
+        std::unordered_map<address_t, size_t> _dataflowsizes;  // Function -> ranges count of its last complete run
+        std::set< std::pair<address_t, s32> > _dataflowapplied; // Instruction, operand index
+        bool _dataflowchanged;
+        std::unique_ptr<PrinterCache> _printercache; // Shared by the printers of every view
         PrinterPtr _printer;
         Listing _listing;
+        u32 _pass;
+        size_t _passsegment;
+        address_t _passaddress;
+        std::atomic<bool> _passpaused, _passcancelled;
+        bool _lazy;
 };
 
 }
@@ -7,11 +7,14 @@
 #include "../redasm.h"
 #include "types/symboltable.h"
 #include "types/referencetable.h"
+#include "types/changejournal.h"
+#include "types/progress.h"
 
 namespace REDasm {
 
 class FormatPlugin;
 class AssemblerPlugin;
+class PrinterCache;
 
 namespace VMIL {
 class Emulator;
@@ -24,7 +27,10 @@ class DisassemblerAPI
         virtual FormatPlugin* format() = 0;
         virtual AssemblerPlugin* assembler() = 0;
         virtual SymbolTable* symbolTable() = 0;
+        virtual ChangeJournal* journal() = 0;
+        virtual Progress* progress() = 0;
         virtual VMIL::Emulator* emulator() = 0;
+        virtual PrinterCache* printerCache() = 0;
         virtual ReferenceVector getReferences(address_t address) = 0;
         virtual ReferenceVector getReferences(const SymbolPtr &symbol) = 0;
         virtual u64 getReferencesCount(address_t address) = 0;
@@ -6,6 +6,8 @@ namespace REDasm {
 DisassemblerBase::DisassemblerBase(Buffer buffer, FormatPlugin *format): DisassemblerAPI(), _format(format), _buffer(buffer)
 {
     this->_symboltable = format->symbols();
+    this->_symboltable->setJournal(&this->_journal);
+    this->_referencetable.setJournal(&this->_journal);
 }
 
 DisassemblerBase::~DisassemblerBase()
@@ -23,6 +25,16 @@ SymbolTable *DisassemblerBase::symbolTable()
     return this->_symboltable;
 }
 
+ChangeJournal *DisassemblerBase::journal()
+{
+    return &this->_journal;
+}
+
+Progress *DisassemblerBase::progress()
+{
+    return &this->_progress;
+}
+
 ReferenceVector DisassemblerBase::getReferences(address_t address)
 {
     return this->_referencetable.referencesToVector(address);
@@ -192,13 +204,14 @@ std::string DisassemblerBase::readHex(address_t address, u32 count) const
 
     count = std::min(static_cast<s64>(count), this->_buffer.length);
 
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
+    char hexbyte[HEX_BUFFER_SIZE];
+    std::string s;
+    s.reserve(count * 2);
 
     for(u64 i = 0; i < count; i++)
-        ss << std::uppercase << std::setw(2) << static_cast<size_t>(data[i]);
+        s.append(hexbyte, REDasm::hexstring(hexbyte, static_cast<u8>(data[i]), 8, false));
 
-    return ss.str();
+    return s;
 }
 
 bool DisassemblerBase::dereferenceOperand(const Operand &operand, u64 *value) const
@@ -18,6 +18,8 @@ class DisassemblerBase: public DisassemblerAPI
     public: // Primitive functions
         virtual FormatPlugin* format();
         virtual SymbolTable* symbolTable();
+        virtual ChangeJournal* journal();
+        virtual Progress* progress();
         virtual ReferenceVector getReferences(address_t address);
         virtual ReferenceVector getReferences(const SymbolPtr &symbol);
         virtual u64 getReferencesCount(address_t address);
@@ -45,6 +47,8 @@ class DisassemblerBase: public DisassemblerAPI
         template<typename T> u64 locationIsStringT(address_t address, std::function<bool(T)> isp, std::function<bool(T)> isa) const;
 
    protected:
+        ChangeJournal _journal;
+        Progress _progress;
         ReferenceTable _referencetable;
         SymbolTable* _symboltable;
         FormatPlugin* _format;
@@ -25,27 +25,32 @@ Listing &FunctionGraph::listing()
 
 void FunctionGraph::build(address_t address)
 {
-    if(!this->_listing.getFunctionBounds(address, &this->_startaddress, &this->_endaddress))
+    if(!this->buildBlocks(address))
         return;
 
+    this->layout();
+}
+
+bool FunctionGraph::buildBlocks(address_t address)
+{
+    if(!this->_listing.getFunctionBounds(address, &this->_startaddress, &this->_endaddress))
+        return false;
+
     this->buildBlocksPass1(); // Build nodes
     this->buildBlocksPass2(); // Check overlapping nodes
     this->buildBlocksPass3(); // Elaborate node's edges
     this->setRootVertex(this->vertexFromAddress(this->_startaddress));
-    this->layout();
+    return true;
 }
 
 FunctionGraphVertex *FunctionGraph::vertexFromAddress(address_t address)
 {
-    for(auto& item : this->_vertexmap)
-    {
-       FunctionGraphVertex* v = static_cast<FunctionGraphVertex*>(this->getVertex(item.first));
+    auto it = this->_vertexaddresses.find(address);
 
-        if(v->start == address)
-            return v;
-    }
+    if(it == this->_vertexaddresses.end())
+        return NULL;
 
-    return NULL;
+    return it->second;
 }
 
 void FunctionGraph::buildBlocksPass1()
@@ -85,6 +90,7 @@ void FunctionGraph::buildBlocksPass1()
 
                 v->end = instruction->address;
                 this->pushVertex(v);
+                this->_vertexaddresses[start] = v;
                 break;
             }
 
@@ -92,6 +98,7 @@ void FunctionGraph::buildBlocksPass1()
             {
                 v->end = instruction->address;
                 this->pushVertex(v);
+                this->_vertexaddresses[start] = v;
                 break;
             }
 
@@ -107,7 +114,7 @@ void FunctionGraph::buildBlocksPass2()
         FunctionGraphVertex* v1 = static_cast<FunctionGraphVertex*>(*vit);
         auto it = this->_listing.find(v1->start);
 
-        while(it.key < v1->end)
+        while((it != this->_listing.end()) && (it.key < v1->end))
         {
             InstructionPtr instruction = *it;
             FunctionGraphVertex* v2 = this->vertexFromAddress(instruction->endAddress());
@@ -132,7 +139,7 @@ void FunctionGraph::buildBlocksPass3()
         FunctionGraphVertex* v1 = static_cast<FunctionGraphVertex*>(*vit);
         auto it = this->_listing.find(v1->start);
 
-        while(it.key <= v1->end)
+        while((it != this->_listing.end()) && (it.key <= v1->end))
         {
             InstructionPtr instruction = *it;
 
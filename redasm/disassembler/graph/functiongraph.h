@@ -24,6 +24,8 @@ class FunctionGraph: public Graphing::Graph
         address_t endAddress() const;
         Listing& listing();
         void build(address_t address);
+        bool buildBlocks(address_t address); // Blocks and edges only, no layout
+        using Graph::layout;                 // After buildBlocks()
 
     private:
         FunctionGraphVertex* vertexFromAddress(address_t address);
@@ -32,6 +34,7 @@ class FunctionGraph: public Graphing::Graph
         void buildBlocksPass3();
 
     private:
+        std::unordered_map<address_t, FunctionGraphVertex*> _vertexaddresses; // Block's start -> vertex
         address_t _startaddress, _endaddress;
         Listing& _listing;
 };
@@ -0,0 +1,49 @@
+#include "changejournal.h"
+#include <algorithm>
+
+namespace REDasm {
+
+ChangeJournal::ChangeJournal(): _subscribers(std::make_shared<SubscriberList>()), _lastid(0), _version(0)
+{
+
+}
+
+u64 ChangeJournal::version() const
+{
+    return this->_version;
+}
+
+ChangeJournal::subscription_t ChangeJournal::subscribe(const ChangeJournal::ChangeCallback &cb)
+{
+    auto subscribers = std::make_shared<SubscriberList>(*this->_subscribers);
+    subscribers->emplace_back(++this->_lastid, cb);
+    this->_subscribers = subscribers;
+    return this->_lastid;
+}
+
+void ChangeJournal::unsubscribe(ChangeJournal::subscription_t id)
+{
+    auto subscribers = std::make_shared<SubscriberList>(*this->_subscribers);
+
+    subscribers->erase(std::remove_if(subscribers->begin(), subscribers->end(), [id](const SubscriberList::value_type& subscriber) -> bool {
+        return subscriber.first == id;
+    }), subscribers->end());
+
+    this->_subscribers = subscribers;
+}
+
+void ChangeJournal::push(u32 type, address_t address, address_t extra)
+{
+    this->_version++;
+
+    if(this->_subscribers->empty())
+        return;
+
+    Change change(type, address, extra);
+    std::shared_ptr<const SubscriberList> subscribers = this->_subscribers; // Callbacks are allowed to (un)subscribe: keep this snapshot alive
+
+    for(const auto& subscriber : *subscribers)
+        subscriber.second(change);
+}
+
+} // namespace REDasm
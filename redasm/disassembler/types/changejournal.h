@@ -0,0 +1,55 @@
+#ifndef CHANGEJOURNAL_H
+#define CHANGEJOURNAL_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "../../redasm.h"
+
+namespace REDasm {
+
+namespace ChangeTypes {
+    enum: u32 {
+        None = 0,
+        SymbolCreated, SymbolRenamed, SymbolErased,   // 'address': symbol's address
+        InstructionUpdated,                           // 'address': instruction's address
+        FunctionBoundsChanged,                        // 'address': function's address
+        ReferenceAdded,                               // 'address': referenced address, 'extra': referenced by
+    };
+}
+
+struct Change
+{
+    Change(): type(ChangeTypes::None), address(0), extra(0) { }
+    Change(u32 type, address_t address, address_t extra = 0): type(type), address(address), extra(extra) { }
+    bool is(u32 t) const { return type == t; }
+
+    u32 type;
+    address_t address, extra;
+};
+
+class ChangeJournal // Fine grained deltas for views: apply the change, don't rebuild everything (single threaded, no locking)
+{
+    public:
+        typedef std::function<void(const Change&)> ChangeCallback;
+        typedef u64 subscription_t;
+
+    private:
+        typedef std::vector< std::pair<subscription_t, ChangeCallback> > SubscriberList;
+
+    public:
+        ChangeJournal();
+        u64 version() const;
+        subscription_t subscribe(const ChangeCallback& cb);
+        void unsubscribe(subscription_t id);
+        void push(u32 type, address_t address, address_t extra = 0);
+
+    private:
+        std::shared_ptr<const SubscriberList> _subscribers; // Copy on write: (un)subscribing is rare, pushing is not
+        subscription_t _lastid;
+        u64 _version;
+};
+
+} // namespace REDasm
+
+#endif // CHANGEJOURNAL_H
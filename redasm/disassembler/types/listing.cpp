@@ -4,7 +4,7 @@
 
 namespace REDasm {
 
-Listing::Listing(): cache_map<address_t, InstructionPtr>("instructions"), _assembler(NULL), _referencetable(NULL), _symboltable(NULL)
+Listing::Listing(): cache_map<address_t, InstructionPtr>("instructions"), _assembler(NULL), _referencetable(NULL), _symboltable(NULL), _journal(NULL)
 {
 
 }
@@ -54,6 +54,11 @@ void Listing::setReferenceTable(ReferenceTable *referencetable)
     this->_referencetable = referencetable;
 }
 
+void Listing::setJournal(ChangeJournal *journal)
+{
+    this->_journal = journal;
+}
+
 void Listing::checkBounds(address_t address)
 {
     if(!this->_assembler)
@@ -70,8 +75,11 @@ void Listing::checkBounds(address_t address)
     if(path.empty())
         return;
 
-    this->updateBlockInfo(path);
+    this->updateBlockInfo(path); // Block info changes are covered by FunctionBoundsChanged
     this->_paths[address] = path;
+
+    if(this->_journal)
+        this->_journal->push(ChangeTypes::FunctionBoundsChanged, address);
 }
 
 void Listing::updateBlockInfo(Listing::FunctionPath &path)
@@ -92,7 +100,7 @@ void Listing::updateBlockInfo(Listing::FunctionPath &path)
             if(lastinstruction)
             {
                 lastinstruction->blocktype |= BlockTypes::GraphEnd | (IS_LABEL(lastsymbol) ? BlockTypes::Ignore : BlockTypes::BlockEnd);
-                this->update(lastinstruction);
+                this->commit(lastinstruction->address, lastinstruction);
             }
 
             instruction->blocktype |= BlockTypes::BlockStart | BlockTypes::GraphStart;
@@ -101,10 +109,10 @@ void Listing::updateBlockInfo(Listing::FunctionPath &path)
         {
             lastinstruction->blocktype |= BlockTypes::GraphEnd;
             instruction->blocktype |= BlockTypes::GraphStart;
-            this->update(lastinstruction);
+            this->commit(lastinstruction->address, lastinstruction);
         }
 
-        this->update(instruction);
+        this->commit(instruction->address, instruction);
         lastinstruction = instruction;
         lastsymbol = symbol;
         it++;
@@ -114,13 +122,13 @@ void Listing::updateBlockInfo(Listing::FunctionPath &path)
     lastinstruction = (*this)[*path.rbegin()];
 
     firstinstruction->blocktype = BlockTypes::BlockStart | BlockTypes::GraphStart;
-    this->update(firstinstruction);
+    this->commit(firstinstruction->address, firstinstruction);
 
     if(firstinstruction == lastinstruction)
         return;
 
     lastinstruction->blocktype = BlockTypes::BlockEnd | BlockTypes::GraphEnd;
-    this->update(lastinstruction);
+    this->commit(lastinstruction->address, lastinstruction);
 }
 
 std::string Listing::getSignature(const SymbolPtr& symbol)
@@ -220,6 +228,9 @@ void Listing::iterateAll(InstructionCallback cbinstruction, SymbolCallback cbsta
 void Listing::update(const InstructionPtr &instruction)
 {
     this->commit(instruction->address, instruction);
+
+    if(this->_journal)
+        this->_journal->push(ChangeTypes::InstructionUpdated, instruction->address);
 }
 
 void Listing::splitFunctionAt(const InstructionPtr &instruction)
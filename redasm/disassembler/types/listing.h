@@ -35,6 +35,7 @@ class Listing: public cache_map<address_t, InstructionPtr>
         void setAssembler(AssemblerPlugin *assembler);
         void setSymbolTable(SymbolTable* symboltable);
         void setReferenceTable(ReferenceTable* referencetable);
+        void setJournal(ChangeJournal* journal);
         bool iterateFunction(address_t address, InstructionCallback cbinstruction);
         bool iterateFunction(address_t address, InstructionCallback cbinstruction, SymbolCallback cbstart, InstructionCallback cbend, SymbolCallback cblabel);
         void iterateAll(InstructionCallback cbinstruction, SymbolCallback cbstart, InstructionCallback cbend, SymbolCallback cblabel);
@@ -60,6 +61,7 @@ class Listing: public cache_map<address_t, InstructionPtr>
         AssemblerPlugin* _assembler;
         ReferenceTable* _referencetable;
         SymbolTable* _symboltable;
+        ChangeJournal* _journal;
 };
 
 }
@@ -0,0 +1,151 @@
+#include "listingindex.h"
+#include <algorithm>
+#include <iterator>
+
+namespace REDasm {
+
+ListingIndex::ListingIndex()
+{
+
+}
+
+void ListingIndex::build(Listing &listing, const PrinterPtr &printer)
+{
+    this->_items.clear();
+
+    listing.symbolTable()->iterate(SymbolTypes::FunctionMask, [this, &listing, &printer](const SymbolPtr& symbol) -> bool {
+        this->collectFunction(listing, symbol->address, printer, this->_items);
+        return true;
+    });
+
+    listing.symbolTable()->iterate(SymbolTypes::Data | SymbolTypes::String, [this](const SymbolPtr& symbol) -> bool {
+        if(!symbol->is(SymbolTypes::Code))
+            this->_items.emplace_back(symbol->address, ListingItemTypes::SymbolItem);
+
+        return true;
+    });
+
+    std::sort(this->_items.begin(), this->_items.end());
+    this->_items.erase(std::unique(this->_items.begin(), this->_items.end()), this->_items.end());
+    this->_items.shrink_to_fit();
+}
+
+void ListingIndex::updateFunction(Listing &listing, address_t address, const PrinterPtr &printer)
+{
+    address_t startaddress = 0, endaddress = 0;
+
+    if(listing.getFunctionBounds(address, &startaddress, &endaddress)) // Drop stale code rows in function's range
+    {
+        auto begin = std::lower_bound(this->_items.begin(), this->_items.end(), ListingItem(startaddress, ListingItemTypes::None));
+        auto end = std::lower_bound(begin, this->_items.end(), ListingItem(endaddress, ListingItemTypes::None));
+
+        auto newend = std::remove_if(begin, end, [](const ListingItem& item) { return !item.is(ListingItemTypes::SymbolItem); });
+        this->_items.erase(newend, end);
+    }
+
+    std::vector<ListingItem> items;
+    this->collectFunction(listing, address, printer, items);
+    this->merge(items);
+}
+
+void ListingIndex::insert(address_t address, u32 type)
+{
+    ListingItem item(address, type);
+    auto it = std::lower_bound(this->_items.begin(), this->_items.end(), item);
+
+    if((it != this->_items.end()) && (*it == item))
+        return;
+
+    this->_items.insert(it, item);
+}
+
+void ListingIndex::remove(address_t address)
+{
+    auto begin = std::lower_bound(this->_items.begin(), this->_items.end(), ListingItem(address, ListingItemTypes::None));
+    auto end = begin;
+
+    while((end != this->_items.end()) && (end->address == address))
+        end++;
+
+    // Instruction rows are owned by functions, they go away with FunctionBoundsChanged
+    auto newend = std::remove_if(begin, end, [](const ListingItem& item) { return !item.is(ListingItemTypes::InstructionItem) && !item.is(ListingItemTypes::InfoItem); });
+    this->_items.erase(newend, end);
+}
+
+void ListingIndex::clear()
+{
+    this->_items.clear();
+    this->_items.shrink_to_fit();
+}
+
+bool ListingIndex::empty() const { return this->_items.empty(); }
+size_t ListingIndex::size() const { return this->_items.size(); }
+const ListingItem &ListingIndex::at(size_t row) const { return this->_items.at(row); }
+
+bool ListingIndex::indexOf(address_t address, size_t *row) const
+{
+    auto it = std::lower_bound(this->_items.begin(), this->_items.end(), ListingItem(address, ListingItemTypes::None));
+
+    // Prefer the instruction/symbol line over the function header and labels
+    for( ; (it != this->_items.end()) && (it->address == address); it++)
+    {
+        if(!it->is(ListingItemTypes::InstructionItem) && !it->is(ListingItemTypes::SymbolItem))
+            continue;
+
+        if(row)
+            *row = std::distance(this->_items.begin(), it);
+
+        return true;
+    }
+
+    return false;
+}
+
+size_t ListingIndex::rowOf(address_t address) const
+{
+    size_t row = 0;
+
+    if(this->indexOf(address, &row))
+        return row;
+
+    auto it = std::lower_bound(this->_items.begin(), this->_items.end(), ListingItem(address, ListingItemTypes::None));
+
+    if(it == this->_items.end())
+        return this->_items.empty() ? 0 : this->_items.size() - 1;
+
+    return std::distance(this->_items.begin(), it);
+}
+
+void ListingIndex::collectFunction(Listing &listing, address_t address, const PrinterPtr &printer, std::vector<ListingItem> &items)
+{
+    listing.iterateFunction(address, [&items, &printer](const InstructionPtr& i) {
+                                         u32 index = 0;
+
+                                         if(printer)
+                                             printer->info(i, [&items, i, &index](const std::string&) { items.emplace_back(i->address, ListingItemTypes::InfoItem, index++); });
+
+                                         items.emplace_back(i->address, ListingItemTypes::InstructionItem);
+                                     },
+                                     [&items, &printer](const SymbolPtr& s) {
+                                         u32 index = 0;
+                                         items.emplace_back(s->address, ListingItemTypes::FunctionItem);
+
+                                         if(printer)
+                                             printer->prologue(s, [&items, s, &index](const std::string&) { items.emplace_back(s->address, ListingItemTypes::PrologueItem, index++); });
+                                     },
+                                     [&items](const InstructionPtr& i) { items.emplace_back(i->address, ListingItemTypes::EmptyItem); },
+                                     [&items](const SymbolPtr& s) { items.emplace_back(s->address, ListingItemTypes::LabelItem); });
+}
+
+void ListingIndex::merge(std::vector<ListingItem> &items)
+{
+    std::sort(items.begin(), items.end());
+
+    std::vector<ListingItem> merged;
+    merged.reserve(this->_items.size() + items.size());
+    std::merge(this->_items.begin(), this->_items.end(), items.begin(), items.end(), std::back_inserter(merged));
+    merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+    this->_items.swap(merged);
+}
+
+} // namespace REDasm
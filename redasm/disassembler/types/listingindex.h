@@ -0,0 +1,51 @@
+#ifndef LISTINGINDEX_H
+#define LISTINGINDEX_H
+
+#include <vector>
+#include <tuple>
+#include "listing.h"
+
+namespace REDasm {
+
+namespace ListingItemTypes {
+    enum: u32 { None = 0, FunctionItem, PrologueItem, LabelItem, InfoItem, InstructionItem, EmptyItem, SymbolItem }; // Sorted by display order
+}
+
+struct ListingItem
+{
+    ListingItem(): address(0), type(ListingItemTypes::None), index(0) { }
+    ListingItem(address_t address, u32 type, u32 index = 0): address(address), type(type), index(index) { }
+    bool is(u32 t) const { return type == t; }
+    bool operator <(const ListingItem& rhs) const { return std::tie(address, type, index) < std::tie(rhs.address, rhs.type, rhs.index); }
+    bool operator ==(const ListingItem& rhs) const { return std::tie(address, type, index) == std::tie(rhs.address, rhs.type, rhs.index); }
+
+    address_t address;
+    u32 type, index; // 'index' is the n-th line of multiline items (prologue & info)
+};
+
+class ListingIndex // Maps listing rows <-> addresses, one item per rendered line
+{
+    public:
+        ListingIndex();
+        void build(Listing& listing, const PrinterPtr& printer = PrinterPtr());
+        void updateFunction(Listing& listing, address_t address, const PrinterPtr& printer = PrinterPtr());
+        void insert(address_t address, u32 type);
+        void remove(address_t address);
+        void clear();
+        bool empty() const;
+        size_t size() const;
+        const ListingItem& at(size_t row) const;
+        bool indexOf(address_t address, size_t* row) const;
+        size_t rowOf(address_t address) const;
+
+    private:
+        void collectFunction(Listing& listing, address_t address, const PrinterPtr& printer, std::vector<ListingItem>& items);
+        void merge(std::vector<ListingItem>& items);
+
+    private:
+        std::vector<ListingItem> _items;
+};
+
+} // namespace REDasm
+
+#endif // LISTINGINDEX_H
@@ -0,0 +1,61 @@
+#include "progress.h"
+
+namespace REDasm {
+
+Progress::Progress(): _phase(ProgressPhases::None), _processed(0), _total(0), _functions(0), _lastprocessed(0), _lastphase(ProgressPhases::None)
+{
+    this->_lastsample = std::chrono::steady_clock::now();
+}
+
+void Progress::begin(u32 phase, u64 total)
+{
+    this->_processed.store(0, std::memory_order_relaxed);
+    this->_total.store(total, std::memory_order_relaxed);
+    this->_phase.store(phase, std::memory_order_release);
+}
+
+ProgressInfo Progress::sample()
+{
+    ProgressInfo info;
+    auto now = std::chrono::steady_clock::now();
+
+    info.phase = this->_phase.load(std::memory_order_acquire);
+    info.processed = this->_processed.load(std::memory_order_relaxed);
+    info.total = this->_total.load(std::memory_order_relaxed);
+    info.functions = this->_functions.load(std::memory_order_relaxed);
+
+    if(info.total && (info.processed > info.total)) // Fields are sampled independently
+        info.processed = info.total;
+
+    double elapsed = std::chrono::duration<double>(now - this->_lastsample).count();
+
+    if((info.phase == this->_lastphase) && (info.processed >= this->_lastprocessed) && (elapsed > 0))
+        info.throughput = (info.processed - this->_lastprocessed) / elapsed;
+
+    this->_lastsample = now;
+    this->_lastprocessed = info.processed;
+    this->_lastphase = info.phase;
+    return info;
+}
+
+std::string Progress::phaseName(u32 phase)
+{
+    if(phase == ProgressPhases::Disassembling)
+        return "Disassembling";
+
+    if(phase == ProgressPhases::Exploring)
+        return "Looking for missing code";
+
+    if(phase == ProgressPhases::Analyzing)
+        return "Analyzing";
+
+    if(phase == ProgressPhases::Sorting)
+        return "Sorting symbols";
+
+    if(phase == ProgressPhases::Done)
+        return "Done";
+
+    return std::string();
+}
+
+} // namespace REDasm
@@ -0,0 +1,55 @@
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+#include <atomic>
+#include <chrono>
+#include "../../redasm.h"
+
+namespace REDasm {
+
+namespace ProgressPhases {
+    enum: u32 {
+        None = 0,
+        Disassembling,  // Entry point and format's functions
+        Exploring,      // Unexplored strings and code
+        Analyzing, Sorting,
+        Done,
+    };
+}
+
+struct ProgressInfo
+{
+    ProgressInfo(): phase(ProgressPhases::None), processed(0), total(0), functions(0), throughput(0) { }
+    bool is(u32 p) const { return phase == p; }
+
+    u32 phase;
+    u64 processed, total, functions; // 'processed' and 'total' are in bytes
+    double throughput;               // Bytes per second since the previous sample
+};
+
+class Progress // Producers only touch relaxed atomics, a single consumer samples them at its own pace
+{
+    public:
+        Progress();
+        void begin(u32 phase, u64 total = 0);
+        void advance(u64 bytes);
+        void functionFound();
+        ProgressInfo sample();
+
+    public:
+        static std::string phaseName(u32 phase);
+
+    private:
+        std::atomic<u32> _phase;
+        std::atomic<u64> _processed, _total, _functions;
+        std::chrono::steady_clock::time_point _lastsample;
+        u64 _lastprocessed;
+        u32 _lastphase;
+};
+
+inline void Progress::advance(u64 bytes) { this->_processed.fetch_add(bytes, std::memory_order_relaxed); }
+inline void Progress::functionFound() { this->_functions.fetch_add(1, std::memory_order_relaxed); }
+
+} // namespace REDasm
+
+#endif // PROGRESS_H
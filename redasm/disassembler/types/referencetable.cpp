@@ -3,7 +3,7 @@
 
 namespace REDasm {
 
-ReferenceTable::ReferenceTable()
+ReferenceTable::ReferenceTable(): _journal(NULL)
 {
 
 }
@@ -17,10 +17,12 @@ void ReferenceTable::push(address_t address, address_t refbyaddress)
         ReferenceSet rs;
         rs.insert(refbyaddress);
         this->_references[address] = rs;
-        return;
     }
+    else if(!it->second.insert(refbyaddress).second)
+        return;
 
-    it->second.insert(refbyaddress);
+    if(this->_journal)
+        this->_journal->push(ChangeTypes::ReferenceAdded, address, refbyaddress);
 }
 
 bool ReferenceTable::hasReferences(address_t address) const
@@ -63,6 +65,11 @@ ReferenceVector ReferenceTable::referencesToVector(address_t address) const
     return ReferenceTable::toVector(it->second);
 }
 
+void ReferenceTable::setJournal(ChangeJournal *journal)
+{
+    this->_journal = journal;
+}
+
 ReferenceVector ReferenceTable::toVector(const ReferenceSet &refset)
 {
     ReferenceVector rv;
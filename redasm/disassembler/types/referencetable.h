@@ -2,6 +2,7 @@
 #define REFERENCETABLE_H
 
 #include "../../redasm.h"
+#include "changejournal.h"
 
 namespace REDasm {
 
@@ -22,12 +23,14 @@ class ReferenceTable
         ReferenceMap::const_iterator references(address_t address) const;
         u64 referencesCount(address_t address) const;
         ReferenceVector referencesToVector(address_t address) const;
+        void setJournal(ChangeJournal* journal);
 
     public:
         static ReferenceVector toVector(const ReferenceSet& refset);
 
     private:
         ReferenceMap _references;
+        ChangeJournal* _journal;
 };
 
 }
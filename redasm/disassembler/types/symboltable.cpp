@@ -24,7 +24,7 @@ void SymbolCache::deserialize(SymbolPtr &value, std::fstream &fs)
 }
 
 // SymbolTable
-SymbolTable::SymbolTable(): _epaddress(0), _isepvalid(false)
+SymbolTable::SymbolTable(): _journal(NULL), _epaddress(0), _isepvalid(false)
 {
 
 }
@@ -58,9 +58,59 @@ bool SymbolTable::create(address_t address, const std::string &name, u32 type, u
     this->_addresses.push_back(address);
     this->_byaddress.commit(address, std::make_shared<Symbol>(type, extratype, address, name));
     this->_byname[name] = address;
+
+    if(this->_journal)
+        this->_journal->push(ChangeTypes::SymbolCreated, address);
+
     return true;
 }
 
+u64 SymbolTable::create(SymbolVector &symbols)
+{
+    std::stable_sort(symbols.begin(), symbols.end(), [](const Symbol& s1, const Symbol& s2) -> bool {
+        return s1.address < s2.address;
+    });
+
+    std::vector< std::pair<address_t, SymbolPtr> > created;
+    SymbolVector duplicates;
+    created.reserve(symbols.size());
+
+    for(const Symbol& symbol : symbols)
+    {
+        if((!created.empty() && (created.back().first == symbol.address)) || this->contains(symbol.address))
+        {
+            duplicates.push_back(symbol); // Same rules of create(): promote them one by one
+            continue;
+        }
+
+        if(symbol.type & SymbolTypes::EntryPointMask)
+        {
+            this->_isepvalid = true;
+            this->_epaddress = symbol.address;
+        }
+
+        created.emplace_back(symbol.address, std::make_shared<Symbol>(symbol));
+    }
+
+    this->_addresses.reserve(this->_addresses.size() + created.size());
+    this->_byname.reserve(this->_byname.size() + created.size());
+    this->_byaddress.commit(created.begin(), created.end()); // One seek, sorted inserts
+
+    for(const auto& item : created)
+    {
+        this->_addresses.push_back(item.first);
+        this->_byname[item.second->name] = item.first;
+
+        if(this->_journal)
+            this->_journal->push(ChangeTypes::SymbolCreated, item.first);
+    }
+
+    for(const Symbol& symbol : duplicates)
+        this->create(symbol.address, symbol.name, symbol.type, symbol.extra_type);
+
+    return created.size();
+}
+
 SymbolPtr SymbolTable::entryPoint()
 {
     if(!this->_isepvalid)
@@ -139,6 +189,10 @@ bool SymbolTable::erase(address_t address)
     this->eraseInVector(address);
     this->_byaddress.erase(it);
     this->_byname.erase(symbol->name);
+
+    if(this->_journal)
+        this->_journal->push(ChangeTypes::SymbolErased, address);
+
     return true;
 }
 
@@ -155,6 +209,10 @@ bool SymbolTable::update(SymbolPtr symbol, const std::string& name)
     symbol->name = name;
     this->_byname[name] = symbol->address;
     this->_byaddress.commit(symbol->address, symbol);
+
+    if(this->_journal)
+        this->_journal->push(ChangeTypes::SymbolRenamed, symbol->address);
+
     return true;
 }
 
@@ -175,6 +233,11 @@ void SymbolTable::sort()
     std::sort(this->_addresses.begin(), this->_addresses.end(), std::less<address_t>());
 }
 
+void SymbolTable::setJournal(ChangeJournal *journal)
+{
+    this->_journal = journal;
+}
+
 bool SymbolTable::createFunction(address_t address, Segment *segment)
 {
     return this->createFunction(address, REDasm::symbol("sub", address, segment ? segment->name :
@@ -210,6 +273,9 @@ void SymbolTable::promoteSymbol(SymbolPtr symbol, const std::string &name, u32 t
     {
         symbol->name = name;
         symbol->type = type;
+
+        if(this->_journal)
+            this->_journal->push(ChangeTypes::SymbolRenamed, symbol->address);
     }
 
     this->_byaddress.commit(symbol->address, symbol);
@@ -6,6 +6,7 @@
 #include <map>
 #include "../../support/cachemap.h"
 #include "../../redasm.h"
+#include "changejournal.h"
 
 #define IS_LABEL(symbol)      (symbol && !symbol->isFunction() && symbol->is(REDasm::SymbolTypes::Code))
 
@@ -48,9 +49,11 @@ struct Symbol
     bool is(u32 t) const { return type & t; }
     bool isFunction() const { return type & SymbolTypes::FunctionMask; }
     bool isLocked() const { return type & SymbolTypes::Locked; }
+    std::string displayName() const { return REDasm::demangle(name); } // Names are stored mangled, demangle them on demand
 };
 
 typedef std::shared_ptr<Symbol> SymbolPtr;
+typedef std::vector<Symbol> SymbolVector;
 
 class SymbolCache: public cache_map<address_t, SymbolPtr>
 {
@@ -73,6 +76,7 @@ class SymbolTable
         u64 size() const;
         bool contains(address_t address);
         bool create(address_t address, const std::string& name, u32 type, u32 extratype = 0);
+        u64 create(SymbolVector& symbols);
         SymbolPtr entryPoint();
         SymbolPtr symbol(address_t address);
         SymbolPtr symbol(const std::string& name);
@@ -83,6 +87,7 @@ class SymbolTable
         bool update(SymbolPtr symbol, const std::string &name);
         void lock(address_t address);
         void sort();
+        void setJournal(ChangeJournal* journal);
 
     public:
         bool createFunction(address_t address, Segment* segment = NULL);
@@ -99,6 +104,7 @@ class SymbolTable
         AddressList _addresses;
         SymbolsByName _byname;
         SymbolCache _byaddress;
+        ChangeJournal* _journal;
         address_t _epaddress;
         bool _isepvalid;
 };
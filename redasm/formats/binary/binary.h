@@ -16,6 +16,9 @@ class BinaryFormat : public FormatPluginB
         virtual bool load(u8 *rawformat, u64);
         void build(const std::string& assembler, u32 bits, offset_t offset, address_t baseaddress, address_t entry, u64 size);
 
+    public:
+        static u32 probe(const u8*, u64) { return FormatConfidence::Fallback; }
+
     private:
         std::string _assembler;
         u32 _bits;
@@ -2,6 +2,10 @@
 #include "dex_statemachine.h"
 #include "dex_constants.h"
 #include "dex_utils.h"
+#include "../../support/threadpool.h"
+
+#define DEX_SHARDS_PER_THREAD 4 // Classes vary a lot in size, oversplit to balance workers
+#define DEX_MIN_SHARD_SIZE    256
 
 namespace REDasm {
 
@@ -38,6 +42,22 @@ endianness_t DEXFormat::endianness() const
     return Endianness::BigEndian;
 }
 
+u32 DEXFormat::probe(const u8 *data, u64 length)
+{
+    if(length < sizeof(DEXHeader))
+        return FormatConfidence::None;
+
+    const DEXHeader* format = reinterpret_cast<const DEXHeader*>(data);
+
+    if(!DEXFormat::validateSignature(const_cast<DEXHeader*>(format)))
+        return FormatConfidence::None;
+
+    if((static_cast<u64>(format->data_off) + format->data_size) > length)
+        return FormatConfidence::High;
+
+    return FormatConfidence::Certain;
+}
+
 bool DEXFormat::load(u8 *rawformat, u64)
 {
     DEXHeader* format = convert(rawformat);
@@ -62,10 +82,8 @@ bool DEXFormat::load(u8 *rawformat, u64)
         this->_fields = pointer<DEXFieldIdItem>(format->field_ids_off);
 
     this->defineSegment("DATA", format->data_off, format->data_off, format->data_size, SegmentTypes::Code);
-    DEXClassIdItem* dexclasses = pointer<DEXClassIdItem>(format->class_defs_off);
-
-    for(u32 i = 0; i < format->class_defs_size; i++)
-        this->loadClass(dexclasses[i]);
+    this->buildIndex();
+    this->loadClasses(pointer<DEXClassIdItem>(format->class_defs_off), format->class_defs_size);
 
     FormatPluginT<DEXHeader>::load(rawformat);
     return true;
@@ -96,22 +114,19 @@ bool DEXFormat::getStringOffset(u32 idx, offset_t& offset) const
 
 std::string DEXFormat::getString(u32 idx) const
 {
-    if(!this->_strings)
+    if(idx >= this->_stringindex.size())
         return std::string();
 
-    u8* pstringdata = pointer<u8>(this->_strings[idx].string_data_off);
-    u32 len = DEXUtils::getULeb128(&pstringdata);
-
-    return std::string(reinterpret_cast<const char*>(pstringdata), len);
+    const DEXStringEntry& entry = this->_stringindex[idx];
+    return std::string(entry.data, entry.length);
 }
 
 std::string DEXFormat::getType(u32 idx) const
 {
-    if(idx >= this->_format->type_ids_size)
+    if(idx >= this->_typeindex.size())
         return "type_" + std::to_string(idx);
 
-    const DEXTypeIdItem& dextype = this->_types[idx];
-    return this->getNormalizedString(dextype.descriptor_idx);
+    return this->_typeindex[idx];
 }
 
 std::string DEXFormat::getMethod(u32 idx) const
@@ -147,9 +162,11 @@ std::string DEXFormat::getReturnType(u32 methodidx) const
         return std::string();
 
     const DEXMethodIdItem& dexmethod = this->_methods[methodidx];
-    const DEXProtoIdItem& dexproto = this->_protos[dexmethod.proto_idx];
 
-    return this->getNormalizedString(this->_types[dexproto.return_type_idx].descriptor_idx);
+    if(dexmethod.proto_idx >= this->_protoindex.size())
+        return std::string();
+
+    return this->_protoindex[dexmethod.proto_idx].returntype;
 }
 
 std::string DEXFormat::getParameters(u32 methodidx) const
@@ -158,12 +175,11 @@ std::string DEXFormat::getParameters(u32 methodidx) const
         return std::string();
 
     const DEXMethodIdItem& dexmethod = this->_methods[methodidx];
-    const DEXProtoIdItem& dexproto = this->_protos[dexmethod.proto_idx];
 
-    if(!dexproto.parameters_off)
+    if(dexmethod.proto_idx >= this->_protoindex.size())
         return "()";
 
-    return "(" + this->getTypeList(dexproto.parameters_off) + ")";
+    return this->_protoindex[dexmethod.proto_idx].parameters;
 }
 
 bool DEXFormat::getMethodInfo(u32 methodidx, DEXEncodedMethod &dexmethod)
@@ -208,7 +224,7 @@ bool DEXFormat::getDebugInfo(u32 methodidx, DEXDebugInfo &debuginfo)
     return true;
 }
 
-bool DEXFormat::getClassData(const DEXClassIdItem &dexclass, DEXClassData &dexclassdata)
+bool DEXFormat::getClassData(const DEXClassIdItem &dexclass, DEXClassData &dexclassdata) const
 {
     if(!dexclass.class_data_off)
         return false;
@@ -255,7 +271,7 @@ bool DEXFormat::getClassData(const DEXClassIdItem &dexclass, DEXClassData &dexcl
     return true;
 }
 
-void DEXFormat::loadMethod(const DEXEncodedMethod &dexmethod, u16& idx)
+void DEXFormat::loadMethod(const DEXEncodedMethod &dexmethod, u16& idx, DEXLoadedMethods& loadedmethods) const
 {
     if(!dexmethod.code_off)
         return;
@@ -265,15 +281,15 @@ void DEXFormat::loadMethod(const DEXEncodedMethod &dexmethod, u16& idx)
     else
         idx += dexmethod.method_idx_diff;
 
-    DEXCodeItem* dexcode = pointer<DEXCodeItem>(dexmethod.code_off);
-
-    this->_encmethods[idx] = dexmethod;
-    this->_codeitems[idx] = dexcode;
-
-    this->defineFunction(fileoffset(&dexcode->insns), this->getMethod(idx), idx);
+    DEXLoadedMethod loadedmethod;
+    loadedmethod.idx = idx;
+    loadedmethod.dexmethod = dexmethod;
+    loadedmethod.dexcode = pointer<DEXCodeItem>(dexmethod.code_off);
+    loadedmethod.name = this->getMethod(idx);
+    loadedmethods.push_back(std::move(loadedmethod));
 }
 
-void DEXFormat::loadClass(const DEXClassIdItem &dexclass)
+void DEXFormat::loadClass(const DEXClassIdItem &dexclass, DEXLoadedMethods &loadedmethods) const
 {
     DEXClassData dexclassdata;
 
@@ -282,15 +298,110 @@ void DEXFormat::loadClass(const DEXClassIdItem &dexclass)
 
     u16 idx = 0;
 
-    std::for_each(dexclassdata.direct_methods.begin(), dexclassdata.direct_methods.end(), [this, dexclass, &idx](const DEXEncodedMethod& dexmethod) {
-        this->loadMethod(dexmethod, idx);
+    std::for_each(dexclassdata.direct_methods.begin(), dexclassdata.direct_methods.end(), [this, &idx, &loadedmethods](const DEXEncodedMethod& dexmethod) {
+        this->loadMethod(dexmethod, idx, loadedmethods);
     });
 
     idx = 0;
 
-    std::for_each(dexclassdata.virtual_methods.begin(), dexclassdata.virtual_methods.end(), [this, dexclass, &idx](const DEXEncodedMethod& dexmethod) {
-        this->loadMethod(dexmethod, idx);
+    std::for_each(dexclassdata.virtual_methods.begin(), dexclassdata.virtual_methods.end(), [this, &idx, &loadedmethods](const DEXEncodedMethod& dexmethod) {
+        this->loadMethod(dexmethod, idx, loadedmethods);
+    });
+}
+
+void DEXFormat::loadClasses(const DEXClassIdItem *dexclasses, u32 count)
+{
+    std::vector<DEXLoadedMethods> shards(DEXFormat::shardCount(count)); // One buffer per shard, no locking
+
+    DEXFormat::parallelFor(count, [this, dexclasses, &shards](u32 start, u32 end, size_t shard) {
+        for(u32 i = start; i < end; i++)
+            this->loadClass(dexclasses[i], shards[shard]);
     });
+
+    size_t total = 0;
+
+    for(const DEXLoadedMethods& loadedmethods : shards)
+        total += loadedmethods.size();
+
+    SymbolVector symbols;
+    symbols.reserve(total);
+    this->_encmethods.reserve(total);
+    this->_codeitems.reserve(total);
+
+    for(const DEXLoadedMethods& loadedmethods : shards) // Merge in class order, symbols are the same of a serial load
+    {
+        for(const DEXLoadedMethod& loadedmethod : loadedmethods)
+        {
+            this->_encmethods[loadedmethod.idx] = loadedmethod.dexmethod;
+            this->_codeitems[loadedmethod.idx] = loadedmethod.dexcode;
+            symbols.emplace_back(SymbolTypes::Function, loadedmethod.idx, fileoffset(&loadedmethod.dexcode->insns), loadedmethod.name);
+        }
+    }
+
+    this->defineSymbols(symbols); // A single sorted commit
+
+    REDasm::log("Loaded " + std::to_string(total) + " method(s) from " + std::to_string(count) + " class(es)");
+}
+
+void DEXFormat::buildIndex()
+{
+    const DEXHeader* format = this->_format;
+
+    this->_stringindex.resize(format->string_ids_size);
+    this->_typeindex.resize(format->type_ids_size);
+    this->_protoindex.resize(format->proto_ids_size);
+
+    DEXFormat::parallelFor(format->string_ids_size, [this](u32 start, u32 end, size_t) {
+        for(u32 i = start; i < end; i++)
+        {
+            u8* pstringdata = pointer<u8>(this->_strings[i].string_data_off);
+            DEXStringEntry& entry = this->_stringindex[i];
+
+            entry.length = DEXUtils::getULeb128(&pstringdata);
+            entry.data = reinterpret_cast<const char*>(pstringdata);
+        }
+    });
+
+    // Types depend on strings and protos depend on types: keep the order
+    DEXFormat::parallelFor(format->type_ids_size, [this](u32 start, u32 end, size_t) {
+        for(u32 i = start; i < end; i++)
+            this->_typeindex[i] = this->getNormalizedString(this->_types[i].descriptor_idx);
+    });
+
+    DEXFormat::parallelFor(format->proto_ids_size, [this](u32 start, u32 end, size_t) {
+        for(u32 i = start; i < end; i++)
+        {
+            const DEXProtoIdItem& dexproto = this->_protos[i];
+            DEXProtoEntry& entry = this->_protoindex[i];
+
+            entry.parameters = dexproto.parameters_off ? ("(" + this->getTypeList(dexproto.parameters_off) + ")") : "()";
+            entry.returntype = this->getType(dexproto.return_type_idx);
+        }
+    });
+}
+
+size_t DEXFormat::shardCount(u32 count)
+{
+    size_t shards = thread_pool::concurrency() * DEX_SHARDS_PER_THREAD;
+    return std::max<size_t>(1, std::min<size_t>(shards, count / DEX_MIN_SHARD_SIZE));
+}
+
+void DEXFormat::parallelFor(u32 count, const ShardCallback &cb)
+{
+    size_t shards = DEXFormat::shardCount(count);
+    thread_pool pool((shards > 1) ? thread_pool::concurrency() : 0); // Small pools are loaded in the caller's thread
+    u32 shardsize = (count + shards - 1) / shards;
+
+    for(size_t i = 0; i < shards; i++)
+    {
+        u32 start = i * shardsize, end = std::min<u32>(count, start + shardsize);
+
+        pool.enqueue([&cb, start, end, i](size_t) {
+            cb(start, end, i);
+        });
+    }
+
+    pool.wait();
 }
 
 std::string DEXFormat::getNormalizedString(u32 idx) const
@@ -3,6 +3,7 @@
 
 // https://source.android.com/devices/tech/dalvik/dex-format
 
+#include <functional>
 #include "../../plugins/plugins.h"
 #include "../../assemblers/dalvik/dalvik_metadata.h"
 #include "dex_header.h"
@@ -20,6 +21,9 @@ class DEXFormat : public FormatPluginT<DEXHeader>
         virtual endianness_t endianness() const;
         virtual bool load(u8 *rawformat, u64);
 
+    public:
+        static u32 probe(const u8* data, u64 length);
+
     public:
         bool getMethodOffset(u32 idx, offset_t &offset) const;
         bool getStringOffset(u32 idx, offset_t &offset) const;
@@ -34,9 +38,20 @@ class DEXFormat : public FormatPluginT<DEXHeader>
         bool getDebugInfo(u32 methodidx, DEXDebugInfo& debuginfo);
 
     private:
-        bool getClassData(const DEXClassIdItem& dexclass, DEXClassData& dexclassdata);
-        void loadMethod(const DEXEncodedMethod& dexmethod, u16 &idx);
-        void loadClass(const DEXClassIdItem& dexclass);
+        struct DEXStringEntry { const char* data; u32 length; };
+        struct DEXProtoEntry { std::string parameters, returntype; };
+        struct DEXLoadedMethod { u16 idx; DEXEncodedMethod dexmethod; DEXCodeItem* dexcode; std::string name; };
+        typedef std::vector<DEXLoadedMethod> DEXLoadedMethods;
+        typedef std::function<void(u32, u32, size_t)> ShardCallback; // Start, end, shard index
+
+    private:
+        bool getClassData(const DEXClassIdItem& dexclass, DEXClassData& dexclassdata) const;
+        void loadMethod(const DEXEncodedMethod& dexmethod, u16 &idx, DEXLoadedMethods& loadedmethods) const;
+        void loadClass(const DEXClassIdItem& dexclass, DEXLoadedMethods& loadedmethods) const;
+        void loadClasses(const DEXClassIdItem* dexclasses, u32 count);
+        void buildIndex();
+        static size_t shardCount(u32 count);
+        static void parallelFor(u32 count, const ShardCallback& cb);
 
     private:
         std::string getNormalizedString(u32 idx) const;
@@ -52,6 +67,9 @@ class DEXFormat : public FormatPluginT<DEXHeader>
         DEXMethodIdItem* _methods;
         DEXFieldIdItem* _fields;
         DEXProtoIdItem* _protos;
+        std::vector<DEXStringEntry> _stringindex;
+        std::vector<std::string> _typeindex;
+        std::vector<DEXProtoEntry> _protoindex;
 };
 
 DECLARE_FORMAT_PLUGIN(DEXFormat, dex)
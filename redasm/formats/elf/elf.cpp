@@ -7,6 +7,8 @@ Elf32Format::Elf32Format(): ElfFormat<ELF_PARAMS(32)>()
 
 }
 
+u32 Elf32Format::probe(const u8 *data, u64 length) { return ElfFormat<ELF_PARAMS(32)>::probe(data, length, ELFCLASS32); }
+
 bool Elf32Format::validate() const
 {
     if(!ElfFormat<ELF_PARAMS(32)>::validate())
@@ -25,6 +27,8 @@ Elf64Format::Elf64Format(): ElfFormat<ELF_PARAMS(64)>()
 
 }
 
+u32 Elf64Format::probe(const u8 *data, u64 length) { return ElfFormat<ELF_PARAMS(64)>::probe(data, length, ELFCLASS64); }
+
 bool Elf64Format::validate() const
 {
     if(!ElfFormat<ELF_PARAMS(64)>::validate())
@@ -14,13 +14,16 @@
 #define POINTER(T, offset) FormatPluginT<EHDR>::template pointer<T>(offset)
 #define ELF_STRING_TABLE this->_shdr[this->_format->e_shstrndx];
 #define ELF_STRING(shdr, offset) POINTER(const char, (shdr)->sh_offset + offset)
+#define ELF_PLT_ENTRY_SIZE 16 // x86/x86_64 lazy binding stubs
 
 namespace REDasm {
 
+typedef std::unordered_map< u64, std::vector<address_t> > ElfRelocationMap; // Symbol index -> Relocation offsets
+
 template<ELF_PARAMS_T> class ElfFormat: public FormatPluginT<EHDR>
 {
     public:
-        ElfFormat(): FormatPluginT<EHDR>(), _shdr(NULL) { }
+        ElfFormat(): FormatPluginT<EHDR>(), _shdr(NULL), _plt(NULL), _pltsec(NULL), _pltsymtab(0) { }
         virtual const char* name() const { return "ELF Format"; }
         virtual u32 bits() const;
         virtual const char* assembler() const;
@@ -30,15 +33,21 @@ template<ELF_PARAMS_T> class ElfFormat: public FormatPluginT<EHDR>
     protected:
         virtual bool validate() const;
         virtual u64 relocationSymbol(const REL* rel) const = 0;
+        static u32 probe(const u8* data, u64 length, u8 elfclass);
 
     private:
-        bool relocate(u64 symidx, u64* value) const;
+        bool relocate(u64 symtabidx, u64 symidx, u64* value) const;
         void loadSegment(const SHDR& shdr);
         void loadSymbols(const SHDR& shdr);
+        void loadRelocations(u64 relidx);
         void parseSections();
 
     private:
         SHDR* _shdr;
+        const SHDR *_plt, *_pltsec;
+        std::unordered_map<u64, ElfRelocationMap> _relocations; // Symbol table's section -> Relocations
+        std::unordered_map<u64, address_t> _pltstubs;           // Symbol index -> PLT stub
+        u64 _pltsymtab;
 };
 
 template<ELF_PARAMS_T> u32 ElfFormat<ELF_PARAMS_D>::bits() const
@@ -95,33 +104,23 @@ template<ELF_PARAMS_T> Analyzer* ElfFormat<ELF_PARAMS_D>::createAnalyzer(Disasse
     return new ElfAnalyzer(disassembler, signatures);
 }
 
-template<ELF_PARAMS_T> bool ElfFormat<ELF_PARAMS_D>::relocate(u64 symidx, u64* value) const
+template<ELF_PARAMS_T> bool ElfFormat<ELF_PARAMS_D>::relocate(u64 symtabidx, u64 symidx, u64* value) const
 {
-    for(u64 i = 0; i < this->_format->e_shnum; i++)
-    {
-        const SHDR& shdr = this->_shdr[i];
-
-        if((shdr.sh_type != SHT_REL) && (shdr.sh_type != SHT_RELA))
-            continue;
+    auto it = this->_relocations.find(symtabidx);
 
-        offset_t offset = shdr.sh_offset, endoffset = offset + shdr.sh_size;
+    if(it == this->_relocations.end())
+        it = this->_relocations.find(0); // Relocations without a linked symbol table
 
-        while(offset < endoffset)
-        {
-            REL* rel = POINTER(REL, offset);
-            u64 sym = this->relocationSymbol(rel);
+    if(it == this->_relocations.end())
+        return false;
 
-            if(sym == symidx)
-            {
-                *value = rel->r_offset;
-                return true;
-            }
+    auto rit = it->second.find(symidx);
 
-            offset += (shdr.sh_type == SHT_REL) ? sizeof(REL) : sizeof(RELA);
-        }
-    }
+    if(rit == it->second.end())
+        return false;
 
-    return false;
+    *value = rit->second.front();
+    return true;
 }
 
 template<ELF_PARAMS_T> void ElfFormat<ELF_PARAMS_D>::loadSegment(const SHDR& shdr)
@@ -147,6 +146,7 @@ template<ELF_PARAMS_T> void ElfFormat<ELF_PARAMS_D>::loadSymbols(const SHDR& shd
 {
     offset_t offset = shdr.sh_offset, endoffset = offset + shdr.sh_size;
     const SHDR& shstr = shdr.sh_link ? this->_shdr[shdr.sh_link] : ELF_STRING_TABLE;
+    u64 symtabidx = &shdr - this->_shdr;
 
     for(u64 idx = 0; offset < endoffset; idx++)
     {
@@ -156,7 +156,7 @@ template<ELF_PARAMS_T> void ElfFormat<ELF_PARAMS_D>::loadSymbols(const SHDR& shd
         u64 symvalue = sym->st_value;
 
         if(!symvalue)
-            isrelocated = this->relocate(idx, &symvalue);
+            isrelocated = this->relocate(symtabidx, idx, &symvalue);
 
         if(!sym->st_name || !symvalue)
         {
@@ -164,7 +164,7 @@ template<ELF_PARAMS_T> void ElfFormat<ELF_PARAMS_D>::loadSymbols(const SHDR& shd
             continue;
         }
 
-        std::string symname = REDasm::demangle(ELF_STRING(&shstr, sym->st_name));
+        std::string symname = ELF_STRING(&shstr, sym->st_name); // Demangled on display
 
         if(!isrelocated)
         {
@@ -185,12 +185,38 @@ template<ELF_PARAMS_T> void ElfFormat<ELF_PARAMS_D>::loadSymbols(const SHDR& shd
                 this->defineSymbol(symvalue, symname, SymbolTypes::Data);
         }
         else
+        {
             this->defineSymbol(symvalue, symname, SymbolTypes::Import);
+            auto it = (symtabidx == this->_pltsymtab) ? this->_pltstubs.find(idx) : this->_pltstubs.end();
+
+            if(it != this->_pltstubs.end()) // Name import thunks too
+                this->defineFunction(it->second, symname + "@plt");
+        }
 
         offset += sizeof(SYM);
     }
 }
 
+template<ELF_PARAMS_T> u32 ElfFormat<ELF_PARAMS_D>::probe(const u8 *data, u64 length, u8 elfclass)
+{
+    if(length < sizeof(EHDR))
+        return FormatConfidence::None;
+
+    const EHDR* ehdr = reinterpret_cast<const EHDR*>(data);
+
+    if((ehdr->e_ident[EI_MAG0] != ELFMAG0) || (ehdr->e_ident[EI_MAG1] != ELFMAG1) ||
+       (ehdr->e_ident[EI_MAG2] != ELFMAG2) || (ehdr->e_ident[EI_MAG3] != ELFMAG3))
+        return FormatConfidence::None;
+
+    if((ehdr->e_ident[EI_VERSION] != EV_CURRENT) || (ehdr->e_ident[EI_CLASS] != elfclass))
+        return FormatConfidence::None;
+
+    if((static_cast<u64>(ehdr->e_shoff) + (static_cast<u64>(ehdr->e_shnum) * sizeof(SHDR))) > length)
+        return FormatConfidence::High; // Truncated section table
+
+    return FormatConfidence::Certain;
+}
+
 template<ELF_PARAMS_T> bool ElfFormat<ELF_PARAMS_D>::validate() const
 {
     if(this->_format->e_ident[EI_MAG0] != ELFMAG0)
@@ -211,15 +237,67 @@ template<ELF_PARAMS_T> bool ElfFormat<ELF_PARAMS_D>::validate() const
     return true;
 }
 
+template<ELF_PARAMS_T> void ElfFormat<ELF_PARAMS_D>::loadRelocations(u64 relidx)
+{
+    const SHDR& shdr = this->_shdr[relidx];
+    const SHDR& shstr = ELF_STRING_TABLE;
+    std::string name = ELF_STRING(&shstr, shdr.sh_name);
+    ElfRelocationMap& relocations = this->_relocations[shdr.sh_link];
+    offset_t offset = shdr.sh_offset, endoffset = offset + shdr.sh_size;
+    bool isplt = (name == ".rel.plt") || (name == ".rela.plt");
+    const SHDR* stubs = this->_pltsec ? this->_pltsec : this->_plt;
+    u64 stubidx = this->_pltsec ? 0 : 1; // Skip PLT0, if any
+
+    if((this->_format->e_machine != EM_386) && (this->_format->e_machine != EM_X86_64))
+        stubs = NULL;
+    else if(isplt)
+        this->_pltsymtab = shdr.sh_link;
+
+    for( ; offset < endoffset; offset += (shdr.sh_type == SHT_REL) ? sizeof(REL) : sizeof(RELA))
+    {
+        REL* rel = POINTER(REL, offset);
+        u64 sym = this->relocationSymbol(rel);
+        relocations[sym].push_back(rel->r_offset);
+
+        if(!isplt || !stubs)
+            continue;
+
+        address_t stubaddress = stubs->sh_addr + (stubidx++ * ELF_PLT_ENTRY_SIZE);
+
+        if(stubaddress < (stubs->sh_addr + stubs->sh_size))
+            this->_pltstubs.emplace(sym, stubaddress);
+    }
+}
+
 template<ELF_PARAMS_T> void ElfFormat<ELF_PARAMS_D>::parseSections()
 {
+    const SHDR& shstr = ELF_STRING_TABLE;
+
+    for(u64 i = 0; i < this->_format->e_shnum; i++) // PLT stubs are resolved through relocations
+    {
+        const SHDR& shdr = this->_shdr[i];
+        std::string name = ELF_STRING(&shstr, shdr.sh_name);
+
+        if(name == ".plt")
+            this->_plt = &shdr;
+        else if(name == ".plt.sec")
+            this->_pltsec = &shdr;
+    }
+
+    for(u64 i = 0; i < this->_format->e_shnum; i++) // Index relocations once: symbols are resolved in O(1)
+    {
+        const SHDR& shdr = this->_shdr[i];
+
+        if(shdr.sh_offset && ((shdr.sh_type == SHT_REL) || (shdr.sh_type == SHT_RELA)))
+            this->loadRelocations(i);
+    }
+
     for(u64 i = 0; i < this->_format->e_shnum; i++)
     {
         const SHDR& shdr = this->_shdr[i];
 
         if(shdr.sh_offset && ((shdr.sh_type == SHT_SYMTAB) || (shdr.sh_type == SHT_DYNSYM)))
         {
-            const SHDR& shstr = ELF_STRING_TABLE;
             REDasm::log("Section" + REDasm::quoted(ELF_STRING(&shstr, shdr.sh_name)) + " contains a "
                         "symbol table @ offset " + REDasm::hex(shdr.sh_offset, this->bits()));
 
@@ -235,6 +313,7 @@ class Elf32Format: public ElfFormat<ELF_PARAMS(32)>
 {
     public:
         Elf32Format();
+        static u32 probe(const u8* data, u64 length);
 
     protected:
         virtual bool validate() const;
@@ -245,6 +324,7 @@ class Elf64Format: public ElfFormat<ELF_PARAMS(64)>
 {
     public:
         Elf64Format();
+        static u32 probe(const u8* data, u64 length);
 
     protected:
         virtual bool validate() const;
@@ -4,12 +4,12 @@ namespace REDasm {
 
 ElfAnalyzer::ElfAnalyzer(DisassemblerAPI *disassembler, const SignatureFiles &signatures): Analyzer(disassembler, signatures)
 {
-
+    AnalyzerPass& main = this->_pipeline.add("main", { "trampolines" });
+    main.finalize = [this](Listing& listing) { this->findMain(listing); };
 }
 
-void ElfAnalyzer::analyze(Listing &listing)
+void ElfAnalyzer::findMain(Listing &listing)
 {
-    Analyzer::analyze(listing);
     SymbolTable* symbolable = listing.symbolTable();
     SymbolPtr symbol = symbolable->symbol("main");
 
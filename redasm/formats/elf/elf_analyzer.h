@@ -9,7 +9,9 @@ class ElfAnalyzer: public Analyzer
 {
     public:
         ElfAnalyzer(DisassemblerAPI* disassembler, const SignatureFiles &signatures);
-        virtual void analyze(Listing& listing);
+
+    private:
+        void findMain(Listing& listing);
 };
 
 } // namespace REDasm
@@ -80,6 +80,17 @@ bool GbaRomFormat::load(u8* rawformat, u64 length)
     return true;
 }
 
+u32 GbaRomFormat::probe(const u8 *data, u64 length)
+{
+    if(length < sizeof(GbaRomHeader))
+        return FormatConfidence::None;
+
+    if(!GbaRomFormat::validateRom(reinterpret_cast<const GbaRomHeader*>(data), length))
+        return FormatConfidence::None;
+
+    return FormatConfidence::High; // No magic number, header checksum only
+}
+
 bool GbaRomFormat::isUppercaseAscii(const char *s, size_t c)
 {
     for(size_t i = 0; i < c; i++)
@@ -96,9 +107,9 @@ bool GbaRomFormat::isUppercaseAscii(const char *s, size_t c)
     return true;
 }
 
-u8 GbaRomFormat::calculateChecksum(GbaRomHeader *gbaheader)
+u8 GbaRomFormat::calculateChecksum(const GbaRomHeader *gbaheader)
 {
-    u8* header = reinterpret_cast<u8*>(gbaheader);
+    const u8* header = reinterpret_cast<const u8*>(gbaheader);
     u8 checksum = 0;
 
     for(size_t i = 0xA0; i <= 0xBC; i++)
@@ -107,7 +118,7 @@ u8 GbaRomFormat::calculateChecksum(GbaRomHeader *gbaheader)
     return checksum - 0x19;
 }
 
-bool GbaRomFormat::validateRom(GbaRomHeader *gbaheader, u64 length)
+bool GbaRomFormat::validateRom(const GbaRomHeader *gbaheader, u64 length)
 {
     if((gbaheader->fixed_val != 0x96) || (length < GBA_ROM_HEADER_SIZE))
         return false;
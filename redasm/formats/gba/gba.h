@@ -43,10 +43,13 @@ class GbaRomFormat: public FormatPluginT<GbaRomHeader>
         virtual Analyzer* createAnalyzer(DisassemblerAPI *disassembler, const SignatureFiles &signatures) const;
         virtual bool load(u8 *rawformat, u64 length);
 
+    public:
+        static u32 probe(const u8* data, u64 length);
+
     private:
         static bool isUppercaseAscii(const char* s, size_t c);
-        static u8 calculateChecksum(GbaRomHeader* gbaheader);
-        bool validateRom(GbaRomHeader* gbaheader, u64 length);
+        static u8 calculateChecksum(const GbaRomHeader* gbaheader);
+        static bool validateRom(const GbaRomHeader* gbaheader, u64 length);
 };
 
 DECLARE_FORMAT_PLUGIN(GbaRomFormat, gbarom)
@@ -4,15 +4,8 @@ namespace REDasm {
 
 GbaAnalyzer::GbaAnalyzer(DisassemblerAPI* disassembler, const SignatureFiles& signaturefiles): Analyzer(disassembler, signaturefiles)
 {
-
-}
-
-void GbaAnalyzer::analyze(Listing &listing)
-{
-    Analyzer::analyze(listing);
-
-    SymbolTable* symboltable = listing.symbolTable();
-    this->renameEPBranch(listing, symboltable);
+    AnalyzerPass& entrypoint = this->_pipeline.add("entrypoint", { "trampolines" });
+    entrypoint.finalize = [this](Listing& listing) { this->renameEPBranch(listing, listing.symbolTable()); };
 }
 
 void GbaAnalyzer::renameEPBranch(Listing& listing, SymbolTable* symboltable)
@@ -9,7 +9,6 @@ class GbaAnalyzer : public Analyzer
 {
     public:
         GbaAnalyzer(DisassemblerAPI* disassembler, const SignatureFiles& signaturefiles);
-        virtual void analyze(Listing &listing);
 
     private:
         void renameEPBranch(Listing &listing, SymbolTable *symboltable);
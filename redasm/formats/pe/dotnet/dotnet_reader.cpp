@@ -5,7 +5,7 @@
 
 namespace REDasm {
 
-DotNetReader::DotNetReader(ImageCor20MetaData *cormetadata): _cormetadata(cormetadata), _cortablesheader(NULL)
+DotNetReader::DotNetReader(ImageCor20MetaData *cormetadata): _cormetadata(cormetadata), _cortablesheader(NULL), _corstrings(NULL), _corstringssize(0)
 {
     REDasm::log(".NET Version: " + PeDotNet::getVersion(cormetadata));
     ImageStreamHeader* streamheader = PeDotNet::getStream(cormetadata, "#~");
@@ -15,6 +15,7 @@ DotNetReader::DotNetReader(ImageCor20MetaData *cormetadata): _cormetadata(cormet
 
     this->_cortablesheader = REDasm::relpointer<ImageCor20TablesHeader>(cormetadata, streamheader->Offset);
     PeDotNet::getTables(this->_cortablesheader, this->_cortables);
+    this->buildMethodRanges();
 
     streamheader = PeDotNet::getStream(cormetadata, "#Strings");
 
@@ -22,21 +23,15 @@ DotNetReader::DotNetReader(ImageCor20MetaData *cormetadata): _cormetadata(cormet
         return;
 
     this->_corstrings = REDasm::relpointer<char>(cormetadata, streamheader->Offset);
+    this->_corstringssize = streamheader->Size;
 }
 
 void DotNetReader::iterateTypes(MethodCallback cbmethods) const
 {
     const CorTableRows& cortdrows = this->getTableRows(CorMetadataTables::TypeDef);
-    const CorTableRows& cormdrows = this->getTableRows(CorMetadataTables::MethodDef);
-
-    for(auto it = cortdrows.begin(); it != cortdrows.end(); it++)
-    {
-        u32 c = this->getListCount(it, cortdrows, cormdrows.size(), [](const CorTablePtr& cortable) -> u32 {
-            return cortable->typeDef.methodList;
-        });
 
-        this->iterateMethods(*it, c, cbmethods);
-    }
+    for(size_t i = 0; i < cortdrows.size(); i++)
+        this->iterateMethods(cortdrows[i], this->_methodranges[i], cbmethods);
 }
 
 bool DotNetReader::isValid() const
@@ -49,11 +44,30 @@ bool DotNetReader::isValid() const
     return true;
 }
 
-const CorTableRows &DotNetReader::getTableRows(u32 cortable) const { return this->_cortables.items.at(cortable); }
+const CorTableRows &DotNetReader::getTableRows(u32 cortable) const { return this->_cortables.items[cortable]; }
+
+void DotNetReader::buildMethodRanges()
+{
+    const CorTableRows& cortdrows = this->getTableRows(CorMetadataTables::TypeDef);
+    u32 methodcount = this->getTableRows(CorMetadataTables::MethodDef).size();
+
+    this->_methodranges.resize(cortdrows.size());
+
+    for(size_t i = 0; i < cortdrows.size(); i++) // A type owns the methods up to the next type's list
+    {
+        u32 first = std::min(methodcount, DOTNET_INDEX(cortdrows[i].typeDef.methodList));
+        u32 last = methodcount;
+
+        if((i + 1) < cortdrows.size())
+            last = std::min(methodcount, DOTNET_INDEX(cortdrows[i + 1].typeDef.methodList));
+
+        this->_methodranges[i] = std::make_pair(first, (last > first) ? (last - first) : 0);
+    }
+}
 
 void DotNetReader::buildType(std::string &dest, u32 stringidx) const
 {
-    std::string s = this->getString(stringidx);
+    const std::string& s = this->getString(stringidx);
 
     if(s.front() != '.' && !dest.empty() && (dest.back() != '.'))
         dest += ".";
@@ -61,49 +75,42 @@ void DotNetReader::buildType(std::string &dest, u32 stringidx) const
     dest += s;
 }
 
-void DotNetReader::iterateMethods(const CorTablePtr& cortypedef, u32 methodcount, MethodCallback cbmethods) const
+void DotNetReader::iterateMethods(const CorTable& cortypedef, const MethodRange& methodrange, MethodCallback cbmethods) const
 {
     std::string tname;
 
-    if(cortypedef->typeDef.typeNamespace)
-        this->buildType(tname, cortypedef->typeDef.typeNamespace);
+    if(cortypedef.typeDef.typeNamespace)
+        this->buildType(tname, cortypedef.typeDef.typeNamespace);
 
-    this->buildType(tname, cortypedef->typeDef.typeName);
+    this->buildType(tname, cortypedef.typeDef.typeName);
 
     const CorTableRows& cormdrows = this->getTableRows(CorMetadataTables::MethodDef);
-    auto it = cormdrows.begin();
-    std::advance(it, DOTNET_INDEX(cortypedef->typeDef.methodList));
 
-    for(u32 i = 0; (it != cormdrows.end()) && (i < methodcount); it++, i++)
+    for(u32 i = methodrange.first; i < (methodrange.first + methodrange.second); i++)
     {
         std::string mname = tname;
-        this->buildType(mname, (*it)->methodDef.name);
-        cbmethods((*it)->methodDef.rva, mname + "()");
+        this->buildType(mname, cormdrows[i].methodDef.name);
+        cbmethods(cormdrows[i].methodDef.rva, mname + "()");
     }
 }
 
-u32 DotNetReader::getListCount(CorTableRows::const_iterator rowsit, const CorTableRows& cortablerows, u32 maxrows, IndexCallback cbindex) const
+const std::string& DotNetReader::getString(u32 index) const
 {
-    u32 index = cbindex(*rowsit), lastindex = 0;
-    rowsit++;
+    auto it = this->_stringcache.find(index);
 
-    if(rowsit != cortablerows.end())
-        lastindex = std::min(maxrows, cbindex(*rowsit));
-    else
-        lastindex = maxrows;
+    if(it != this->_stringcache.end())
+        return it->second;
 
-    return lastindex - index;
-}
+    std::string s;
 
-std::string DotNetReader::getString(u32 index) const
-{
     if(!index)
-        return "string_null";
-
-    if(!this->_corstrings)
-        return "string_" + std::to_string(index);
+        s = "string_null";
+    else if(!this->_corstrings || (index >= this->_corstringssize))
+        s = "string_" + std::to_string(index);
+    else
+        s = this->_corstrings + index;
 
-    return this->_corstrings + index;
+    return this->_stringcache.emplace(index, std::move(s)).first->second;
 }
 
 } // namespace REDasm
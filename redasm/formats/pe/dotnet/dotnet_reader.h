@@ -10,7 +10,7 @@ class DotNetReader
 {
     private:
         typedef std::function<void(u32, const std::string&)> MethodCallback;
-        typedef std::function<u32(const CorTablePtr&)> IndexCallback;
+        typedef std::pair<u32, u32> MethodRange; // First MethodDef row, count
 
     public:
         DotNetReader(ImageCor20MetaData *cormetadata);
@@ -19,16 +19,19 @@ class DotNetReader
 
     private:
         const CorTableRows& getTableRows(u32 cortable) const;
+        void buildMethodRanges();
         void buildType(std::string& s, u32 stringidx) const;
-        void iterateMethods(const CorTablePtr &cortypedef, u32 methodcount, MethodCallback cbmethods) const;
-        u32 getListCount(CorTableRows::const_iterator rowsit, const CorTableRows &cortablerows, u32 maxrows, IndexCallback cbindex) const;
-        std::string getString(u32 index) const;
+        void iterateMethods(const CorTable &cortypedef, const MethodRange& methodrange, MethodCallback cbmethods) const;
+        const std::string& getString(u32 index) const;
 
     private:
         ImageCor20MetaData* _cormetadata;
         ImageCor20TablesHeader* _cortablesheader;
         CorTables _cortables;
+        std::vector<MethodRange> _methodranges;                     // TypeDef -> MethodDef rows, resolved once
+        mutable std::unordered_map<u32, std::string> _stringcache;  // #Strings heap, by offset
         char* _corstrings;
+        u32 _corstringssize;
 };
 
 } // namespace REDasm
@@ -1,13 +1,25 @@
 #ifndef DOTNET_TABLES_H
 #define DOTNET_TABLES_H
 
+#include <array>
 #include "../../../redasm.h"
 
 #define DOTNET_TAG_F(n) u8 n##_tag; u32 n
+#define DOTNET_MAX_TABLES 64
 
 namespace REDasm {
 
-struct CorTable
+namespace CorCodedIndex {
+
+enum: u32 {
+    ResolutionScope = 0, TypeDefOrRef, MemberRefParent, HasConstant, HasCustomAttribute, CustomAttributeType,
+    HasFieldMarshal, HasDeclSecurity, HasSemantics, MethodDefOrRef, MemberForwarded, Implementation,
+    Count
+};
+
+}
+
+union CorTable // A row belongs to one table only, keep them small
 {
     struct { u16 generation; u32 name, mvId, encId, encBaseId; } module;
     struct { DOTNET_TAG_F(resolutionScope); u32 typeName, typeNamespace; } typeRef;
@@ -48,15 +60,18 @@ struct CorTable
     struct { u32 owner; DOTNET_TAG_F(constraint); } genericParamConstraint;
 };
 
-typedef std::unique_ptr<CorTable> CorTablePtr;
-typedef std::vector<CorTablePtr> CorTableRows;
+typedef std::vector<CorTable> CorTableRows;
 
 struct CorTables
 {
+    CorTables(): items(DOTNET_MAX_TABLES) { rows.fill(0); indexsizes.fill(sizeof(u16)); codedindexsizes.fill(sizeof(u16)); }
+
     u8 stringoffsize, guidoffsize, bloboffsize;
 
-    std::map<u32, CorTableRows> items;
-    std::map<u32, u32> rows;
+    std::vector<CorTableRows> items;                          // Flat rows, indexed by table id
+    std::array<u32, DOTNET_MAX_TABLES> rows;
+    std::array<u8, DOTNET_MAX_TABLES> indexsizes;             // Simple index size of each table
+    std::array<u8, CorCodedIndex::Count> codedindexsizes;     // Precomputed once, every row has the same layout
 };
 
 } // namespace REDasm
@@ -124,6 +124,31 @@ bool PeFormat::load(u8 *rawformat, u64)
     return true;
 }
 
+u32 PeFormat::probe(const u8 *data, u64 length)
+{
+    if(length < sizeof(ImageDosHeader))
+        return FormatConfidence::None;
+
+    const ImageDosHeader* dosheader = reinterpret_cast<const ImageDosHeader*>(data);
+
+    if(dosheader->e_magic != IMAGE_DOS_SIGNATURE)
+        return FormatConfidence::None;
+
+    // Signature + FileHeader + OptionalHeaderMagic
+    if((static_cast<u64>(dosheader->e_lfanew) + sizeof(u32) + sizeof(ImageFileHeader) + sizeof(u16)) > length)
+        return FormatConfidence::None;
+
+    const ImageNtHeaders* ntheaders = reinterpret_cast<const ImageNtHeaders*>(data + dosheader->e_lfanew);
+
+    if(ntheaders->Signature != IMAGE_NT_SIGNATURE)
+        return FormatConfidence::None;
+
+    if((ntheaders->OptionalHeaderMagic != IMAGE_NT_OPTIONAL_HDR32_MAGIC) && (ntheaders->OptionalHeaderMagic != IMAGE_NT_OPTIONAL_HDR64_MAGIC))
+        return FormatConfidence::None;
+
+    return FormatConfidence::Certain;
+}
+
 const DotNetReader *PeFormat::dotNetReader() const
 {
     return this->_dotnetreader;
@@ -356,12 +381,22 @@ void PeFormat::loadExports()
     u32* names = RVA_POINTER(u32, exporttable->AddressOfNames);
     u16* nameords = RVA_POINTER(u16, exporttable->AddressOfNameOrdinals);
 
-    for(size_t i = 0; i < exporttable->NumberOfFunctions; i++)
+    std::vector<s64> exportnames(exporttable->NumberOfFunctions, -1); // Ordinal -> AddressOfNames' index
+
+    for(u32 i = 0; i < exporttable->NumberOfNames; i++)
+    {
+        if((nameords[i] < exportnames.size()) && (exportnames[nameords[i]] == -1))
+            exportnames[nameords[i]] = i;
+    }
+
+    SymbolVector symbols;
+    symbols.reserve(exporttable->NumberOfFunctions);
+
+    for(u32 i = 0; i < exporttable->NumberOfFunctions; i++)
     {
         if(!functions[i])
             continue;
 
-        bool namedfunction = false;
         u32 funcep = this->_imagebase + functions[i];
         const Segment* segment = this->segment(funcep);
 
@@ -371,23 +406,13 @@ void PeFormat::loadExports()
         u32 symboltype = segment->is(SegmentTypes::Code) ? SymbolTypes::ExportFunction :
                                                            SymbolTypes::ExportData;
 
-        for(u64 j = 0; j < exporttable->NumberOfNames; j++)
-        {
-            if(nameords[j] != i)
-                continue;
-
-            namedfunction = true;
-            this->defineSymbol(funcep, RVA_POINTER(const char, names[j]), symboltype);
-            break;
-        }
-
-        if(namedfunction)
-            continue;
-
-        std::stringstream ss;
-        ss << "Ordinal__" << std::uppercase << std::setw(4) << std::setfill('0') << std::setbase(16) << (exporttable->Base + i);
-        this->defineSymbol(funcep, ss.str(), symboltype);
+        if(exportnames[i] != -1)
+            symbols.emplace_back(symboltype, 0, funcep, RVA_POINTER(const char, names[exportnames[i]]));
+        else
+            symbols.emplace_back(symboltype, 0, funcep, PEUtils::ordinalName(exporttable->Base + i));
     }
+
+    this->defineSymbols(symbols);
 }
 
 void PeFormat::loadImports()
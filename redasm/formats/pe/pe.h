@@ -30,6 +30,9 @@ class PeFormat: public FormatPluginT<ImageDosHeader>
         virtual bool load(u8 *rawformat, u64);
         const DotNetReader *dotNetReader() const;
 
+    public:
+        static u32 probe(const u8* data, u64 length);
+
     private:
         u64 rvaToOffset(u64 rva, bool* ok = NULL) const;
         void checkDelphi(const REDasm::PEResources &peresources);
@@ -67,6 +70,9 @@ template<typename THUNK, u64 ordinalflag> void PeFormat::readDescriptor(const Im
     if(descriptorname.find("msvbvm") != std::string::npos)
         this->_petype = PeType::VisualBasic;
 
+    std::string libraryname = PEUtils::libraryName(descriptorname) + "_"; // Normalize it once per descriptor
+    SymbolVector symbols;
+
     for(size_t i = 0; thunk[i]; i++)
     {
         std::string importname;
@@ -80,20 +86,22 @@ template<typename THUNK, u64 ordinalflag> void PeFormat::readDescriptor(const Im
             if(!ok)
                 continue;
 
-            importname = PEUtils::importName(descriptorname, reinterpret_cast<const char*>(&importbyname->Name));
+            importname = libraryname + reinterpret_cast<const char*>(&importbyname->Name);
         }
         else
         {
             u16 ordinal = (ordinalflag ^ thunk[i]);
 
             if(!PEImports::importName(descriptorname, ordinal, importname))
-                importname = PEUtils::importName(descriptorname, ordinal);
+                importname = libraryname + PEUtils::ordinalName(ordinal);
             else
-                importname = PEUtils::importName(descriptorname, importname);
+                importname = libraryname + importname;
         }
 
-        this->defineSymbol(address, importname, SymbolTypes::Import);
+        symbols.emplace_back(SymbolTypes::Import, 0, address, importname);
     }
+
+    this->defineSymbols(symbols);
 }
 
 DECLARE_FORMAT_PLUGIN(PeFormat, pe)
@@ -4,28 +4,38 @@
 
 #define IMPORT_NAME(library, name) PEUtils::importName(library, name)
 #define IMPORT_TRAMPOLINE(library, name) ("_" + REDasm::normalize(IMPORT_NAME(library, name)))
-#define ADD_WNDPROC_API(argidx, name) _wndprocapi.push_back(std::make_pair(argidx, name))
 
 namespace REDasm {
 
-PEAnalyzer::PEAnalyzer(DisassemblerAPI *disassembler, const SignatureFiles& signatures): Analyzer(disassembler, signatures)
-{
-    ADD_WNDPROC_API(4, "DialogBoxA");
-    ADD_WNDPROC_API(4, "DialogBoxW");
-    ADD_WNDPROC_API(4, "DialogBoxParamA");
-    ADD_WNDPROC_API(4, "DialogBoxParamW");
-    ADD_WNDPROC_API(4, "CreateDialogParamA");
-    ADD_WNDPROC_API(4, "CreateDialogParamW");
-    ADD_WNDPROC_API(4, "CreateDialogIndirectParamA");
-    ADD_WNDPROC_API(4, "CreateDialogIndirectParamW");
-}
+const PEAnalyzer::APIHeuristic PEAnalyzer::API_HEURISTICS[] = { // Stop APIs first: argument scans stop at split points
+    { "kernel32.dll", "ExitProcess",                0, APIActions::Stop,     NULL },
+    { "kernel32.dll", "TerminateProcess",           0, APIActions::Stop,     NULL },
+    { "user32.dll",   "DialogBoxA",                 4, APIActions::Function, "DlgProc_" },
+    { "user32.dll",   "DialogBoxW",                 4, APIActions::Function, "DlgProc_" },
+    { "user32.dll",   "DialogBoxParamA",            4, APIActions::Function, "DlgProc_" },
+    { "user32.dll",   "DialogBoxParamW",            4, APIActions::Function, "DlgProc_" },
+    { "user32.dll",   "CreateDialogParamA",         4, APIActions::Function, "DlgProc_" },
+    { "user32.dll",   "CreateDialogParamW",         4, APIActions::Function, "DlgProc_" },
+    { "user32.dll",   "CreateDialogIndirectParamA", 4, APIActions::Function, "DlgProc_" },
+    { "user32.dll",   "CreateDialogIndirectParamW", 4, APIActions::Function, "DlgProc_" },
+    { "kernel32.dll", "CreateThread",               3, APIActions::Function, "ThreadProc_" },
+};
 
-void PEAnalyzer::analyze(Listing &listing)
+PEAnalyzer::PEAnalyzer(DisassemblerAPI *disassembler, const SignatureFiles& signatures): Analyzer(disassembler, signatures)
 {
-    Analyzer::analyze(listing);
-    this->findStopAPI(listing, "kernel32.dll", "ExitProcess");
-    this->findStopAPI(listing, "kernel32.dll", "TerminateProcess");
-    this->findAllWndProc(listing);
+    AnalyzerPass& imports = this->_pipeline.add("imports", { "trampolines" }); // Imports may be renamed as trampolines
+    imports.prepare = [this](Listing& listing) { this->prepareImports(listing); };
+    imports.watch = [this](Listing& listing, std::list<SymbolPtr>& symbols) { this->watchImports(listing, symbols); };
+
+    imports.visitreference = [this](Listing& listing, const SymbolPtr& symbol, const InstructionPtr& instruction) {
+        for(const APIHeuristic* heuristic : this->_heuristics[symbol->address])
+            this->applyHeuristic(listing, *heuristic, instruction);
+    };
+
+    imports.finalize = [this](Listing&) {
+        this->_heuristics.clear();
+        this->_callarguments.reset();
+    };
 }
 
 SymbolPtr PEAnalyzer::getImport(Listing &listing, const std::string &library, const std::string &api)
@@ -39,74 +49,61 @@ SymbolPtr PEAnalyzer::getImport(Listing &listing, const std::string &library, co
     return symbol;
 }
 
-ReferenceVector PEAnalyzer::getAPIReferences(Listing& listing, const std::string &library, const std::string &api)
+void PEAnalyzer::prepareImports(Listing &listing)
 {
-    SymbolPtr symbol = this->getImport(listing, library, api);
+    this->_callarguments = std::make_unique<CallArguments>(listing);
 
-    if(!symbol)
-        return ReferenceVector();
+    if(listing.format()->bits() == 64) // Microsoft x64: first four arguments in registers
+    {
+        this->_callarguments->setRegisters({ { X86_REG_RCX, X86_REG_ECX }, { X86_REG_RDX, X86_REG_EDX },
+                                             { X86_REG_R8, X86_REG_R8D }, { X86_REG_R9, X86_REG_R9D } },
+                                           { { X86_REG_CX, X86_REG_CL, X86_REG_CH }, { X86_REG_DX, X86_REG_DL, X86_REG_DH }, // Partial writes
+                                             { X86_REG_R8W, X86_REG_R8B }, { X86_REG_R9W, X86_REG_R9B } });
 
-    return this->_disassembler->getReferences(symbol);
+        this->_callarguments->setStackSlots(X86_REG_RSP, 0x20, sizeof(u64)); // After the shadow space
+    }
 }
 
-void PEAnalyzer::findStopAPI(Listing &listing, const std::string& library, const std::string& api)
+void PEAnalyzer::watchImports(Listing &listing, std::list<SymbolPtr> &symbols)
 {
-    ReferenceVector refs = this->getAPIReferences(listing, library, api);
+    for(const APIHeuristic& heuristic : API_HEURISTICS)
+    {
+        SymbolPtr symbol = this->getImport(listing, heuristic.library, heuristic.api);
 
-    std::for_each(refs.begin(), refs.end(), [&listing](address_t address) {
-        InstructionPtr instruction = listing[address];
-        listing.splitFunctionAt(instruction);
-    });
-}
+        if(!symbol)
+            continue;
 
-void PEAnalyzer::findAllWndProc(Listing &listing)
-{
-    for(auto it = this->_wndprocapi.begin(); it != this->_wndprocapi.end(); it++)
-    {
-        ReferenceVector refs = this->getAPIReferences(listing, "user32.dll", it->second);
+        std::list<const APIHeuristic*>& heuristics = this->_heuristics[symbol->address];
+
+        if(heuristics.empty())
+            symbols.push_back(symbol);
 
-        std::for_each(refs.begin(), refs.end(), [this, &listing, it](address_t address) {
-            this->findWndProc(listing, address, it->first);
-        });
+        heuristics.push_back(&heuristic);
     }
 }
 
-void PEAnalyzer::findWndProc(Listing &listing, address_t address, size_t argidx)
+void PEAnalyzer::applyHeuristic(Listing &listing, const APIHeuristic &heuristic, const InstructionPtr &instruction)
 {
-    auto it = listing.find(address);
-
-    if(it == listing.end())
+    if(heuristic.action == APIActions::Stop)
+    {
+        listing.splitFunctionAt(instruction);
         return;
+    }
+
+    u64 value = 0;
 
-    size_t arg = 0;
-    it--; // Skip call
+    if(!this->_callarguments->argument(instruction->address, heuristic.argidx, &value))
+        return;
 
-    while(arg < argidx)
+    if(heuristic.action == APIActions::Function)
     {
-        const InstructionPtr& instruction = *it;
-
-        if(instruction->is(InstructionTypes::Push))
-        {
-            arg++;
-
-            if(arg == argidx)
-            {
-                FormatPlugin* format = listing.format();
-                Operand& op = instruction->op(0);
-                Segment* segment = format->segment(op.u_value);
-
-                if(segment && segment->is(SegmentTypes::Code))
-                {
-                    this->_disassembler->disassembleFunction(op.u_value, "DlgProc_" + REDasm::hex(op.u_value, 0, false));
-                    listing.symbolTable()->lock(op.u_value);
-                }
-            }
-        }
-
-        if((arg == argidx) || (it == listing.begin()) || instruction->is(InstructionTypes::Stop))
-            break;
-
-        it--;
+        Segment* segment = listing.format()->segment(value);
+
+        if(!segment || !segment->is(SegmentTypes::Code))
+            return;
+
+        this->_disassembler->disassembleFunction(value, heuristic.prefix + REDasm::hex(value, 0, false));
+        listing.symbolTable()->lock(value);
     }
 }
 
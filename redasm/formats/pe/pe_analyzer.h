@@ -2,27 +2,32 @@
 #define PE_ANALYZER_H
 
 #include "../../analyzer/analyzer.h"
+#include "../../analyzer/callarguments.h"
 
 namespace REDasm {
 
+namespace APIActions {
+    enum: u32 { None = 0, Stop, Function }; // Stop: split the caller, Function: disassemble the argument
+}
+
 class PEAnalyzer: public Analyzer
 {
     private:
-        typedef std::pair<size_t, std::string> APIInfo;
+        struct APIHeuristic { const char* library; const char* api; size_t argidx; u32 action; const char* prefix; }; // 'argidx' is 1-based
 
     public:
         PEAnalyzer(DisassemblerAPI* disassembler, const SignatureFiles &signatures);
-        virtual void analyze(Listing& listing);
 
     private:
         SymbolPtr getImport(Listing& listing, const std::string& library, const std::string& api);
-        ReferenceVector getAPIReferences(Listing &listing, const std::string& library, const std::string& api);
-        void findStopAPI(Listing& listing, const std::string &library, const std::string &api);
-        void findAllWndProc(Listing& listing);
-        void findWndProc(Listing& listing, address_t address, size_t argidx);
+        void prepareImports(Listing& listing);
+        void watchImports(Listing& listing, std::list<SymbolPtr>& symbols);
+        void applyHeuristic(Listing& listing, const APIHeuristic& heuristic, const InstructionPtr& instruction);
 
     private:
-        std::list<APIInfo> _wndprocapi;
+        static const APIHeuristic API_HEURISTICS[];
+        std::unordered_map<address_t, std::list<const APIHeuristic*> > _heuristics; // Import's address -> heuristics
+        std::unique_ptr<CallArguments> _callarguments;
 };
 
 }
@@ -1,7 +1,6 @@
 #ifndef PE_IMPORTS_H
 #define PE_IMPORTS_H
 
-#include <unordered_map>
 #include <string>
 #include "../../redasm.h"
 #include "../../support/ordinals.h"
@@ -10,18 +9,12 @@ namespace REDasm {
 
 class PEImports
 {
-    private:
-        typedef std::map<std::string, OrdinalsMap> ResolveMap;
-
     private:
         PEImports();
-        static void loadImport(std::string dllname);
+        static const OrdinalDB& ordinals();
 
     public:
         static bool importName(const std::string& dllname, u16 ordinal, std::string& name);
-
-    private:
-        static ResolveMap _libraries;
 };
 
 } // namespace REDasm
@@ -1,7 +1,5 @@
 #include "pe_utils.h"
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
 
 namespace REDasm {
 
@@ -17,22 +15,39 @@ PEUtils::PEUtils()
 }
 
 std::string PEUtils::importName(std::string library, const std::string &name)
+{
+    return PEUtils::libraryName(library) + "_" + name;
+}
+
+std::string PEUtils::importName(std::string library, s64 ordinal)
+{
+    return PEUtils::importName(library, PEUtils::ordinalName(ordinal));
+}
+
+std::string PEUtils::libraryName(std::string library)
 {
     std::transform(library.begin(), library.end(), library.begin(), ::tolower);
 
     if(!endsWith(library, ".dll"))
         library += ".dll";
 
-    std::stringstream ss;
-    ss << library << "_" << name;
-    return ss.str();
+    return library;
 }
 
-std::string PEUtils::importName(std::string library, s64 ordinal)
+std::string PEUtils::ordinalName(u64 ordinal)
 {
-    std::stringstream ss;
-    ss << "Ordinal__" << std::uppercase << std::setw(4) << std::setfill('0') << std::setbase(16) << ordinal;
-    return PEUtils::importName(library, ss.str());
+    static const char* hexdigits = "0123456789ABCDEF";
+    char digits[sizeof(u64) * 2];
+    size_t i = sizeof(digits);
+
+    do // At least 4 digits, like "Ordinal__%04X"
+    {
+        digits[--i] = hexdigits[ordinal & 0xF];
+        ordinal >>= 4;
+    }
+    while(ordinal || (i > (sizeof(digits) - 4)));
+
+    return "Ordinal__" + std::string(digits + i, sizeof(digits) - i);
 }
 
 } // namespace REDasm
@@ -14,6 +14,8 @@ class PEUtils
     public:
         static std::string importName(std::string library, const std::string& name);
         static std::string importName(std::string library, s64 ordinal);
+        static std::string libraryName(std::string library);
+        static std::string ordinalName(u64 ordinal);
 };
 
 }
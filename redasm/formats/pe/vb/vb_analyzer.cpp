@@ -16,9 +16,12 @@ VBAnalyzer::VBAnalyzer(DisassemblerAPI *disassembler, const SignatureFiles &sign
     this->_vbobjtable = NULL;
     this->_vbobjtreeinfo = NULL;
     this->_vbpubobjdescr = NULL;
+
+    AnalyzerPass& project = this->_pipeline.add("vbproject"); // Functions found here are visited by the other passes
+    project.prepare = [this](Listing& listing) { this->decompileProject(listing); };
 }
 
-void VBAnalyzer::analyze(Listing &listing)
+void VBAnalyzer::decompileProject(Listing &listing)
 {
     SymbolTable* symboltable = listing.symbolTable();
     SymbolPtr entrypoint = symboltable->entryPoint();
@@ -51,7 +54,6 @@ void VBAnalyzer::analyze(Listing &listing)
     }
 
     this->decompile(listing, thunrtdata);
-    PEAnalyzer::analyze(listing);
 }
 
 void VBAnalyzer::disassembleTrampoline(u32 eventva, const std::string& name, Listing& listing)
@@ -12,9 +12,9 @@ class VBAnalyzer : public PEAnalyzer
 {
     public:
         VBAnalyzer(DisassemblerAPI* disassembler, const SignatureFiles& signatures);
-        virtual void analyze(Listing &listing);
 
     private:
+        void decompileProject(Listing &listing);
         void disassembleTrampoline(u32 eventva, const std::string &name, Listing &listing);
         void decompileObject(Listing &listing, const VBPublicObjectDescriptor& pubobjdescr);
         void decompile(Listing &listing, SymbolPtr thunrtdata);
@@ -1,5 +1,6 @@
 #include "vb_components.h"
 #include <sstream>
+#include <iomanip>
 
 #define EVENTS(...) __VA_ARGS__
 #define COMPONENT_VAR(n) c ## _ ## n
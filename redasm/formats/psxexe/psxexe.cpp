@@ -34,6 +34,19 @@ Analyzer *PsxExeFormat::createAnalyzer(DisassemblerAPI *disassembler, const Sign
     return new PsxExeAnalyzer(disassembler, signatures);
 }
 
+u32 PsxExeFormat::probe(const u8 *data, u64 length)
+{
+    if(length < sizeof(PsxExeHeader))
+        return FormatConfidence::None;
+
+    const PsxExeHeader* format = reinterpret_cast<const PsxExeHeader*>(data);
+
+    if(strncmp(format->id, PSXEXE_SIGNATURE, PSXEXE_SIGNATURE_SIZE))
+        return FormatConfidence::None;
+
+    return (length >= PSXEXE_TEXT_OFFSET) ? FormatConfidence::Certain : FormatConfidence::High;
+}
+
 bool PsxExeFormat::load(u8* rawformat, u64)
 {
     PsxExeHeader* format = convert(rawformat);
@@ -28,6 +28,9 @@ class PsxExeFormat: public FormatPluginT<PsxExeHeader>
         virtual const char* assembler() const;
         virtual Analyzer* createAnalyzer(DisassemblerAPI *disassembler, const SignatureFiles &signatures) const;
         virtual bool load(u8 *rawformat, u64);
+
+    public:
+        static u32 probe(const u8* data, u64 length);
 };
 
 DECLARE_FORMAT_PLUGIN(PsxExeFormat, psxexe)
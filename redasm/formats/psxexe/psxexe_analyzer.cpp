@@ -5,12 +5,8 @@ namespace REDasm {
 
 PsxExeAnalyzer::PsxExeAnalyzer(DisassemblerAPI *disassembler, const SignatureFiles &signaturefiles): Analyzer(disassembler, signaturefiles)
 {
-}
-
-void PsxExeAnalyzer::analyze(Listing& listing)
-{
-    Analyzer::analyze(listing);
-    this->detectMain(listing);
+    AnalyzerPass& main = this->_pipeline.add("main", { "trampolines" }); // InitHeap is named by signatures
+    main.finalize = [this](Listing& listing) { this->detectMain(listing); };
 }
 
 void PsxExeAnalyzer::detectMain(Listing &listing)
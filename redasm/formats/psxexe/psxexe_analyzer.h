@@ -9,7 +9,6 @@ class PsxExeAnalyzer: public Analyzer
 {
     public:
         PsxExeAnalyzer(DisassemblerAPI* disassembler, const SignatureFiles& signaturefiles);
-        virtual void analyze(Listing &listing);
 
     private:
         void detectMain(Listing& listing);
@@ -25,6 +25,19 @@ const char *XbeFormat::assembler() const
     return "x86_32";
 }
 
+u32 XbeFormat::probe(const u8 *data, u64 length)
+{
+    if(length < sizeof(XbeImageHeader))
+        return FormatConfidence::None;
+
+    const XbeImageHeader* format = reinterpret_cast<const XbeImageHeader*>(data);
+
+    if((format->Magic != XBE_MAGIC_NUMBER) || !format->SectionHeader || !format->NumberOfSections)
+        return FormatConfidence::None;
+
+    return FormatConfidence::Certain;
+}
+
 bool XbeFormat::load(u8 *rawformat, u64)
 {
     XbeImageHeader* format = convert(rawformat);
@@ -149,8 +162,7 @@ void XbeFormat::loadSections(XbeSectionHeader *sectionhdr)
 
 bool XbeFormat::loadXBoxKrnl()
 {
-    OrdinalsMap ordinals;
-    REDasm::loadordinals(REDasm::makeFormatPath("xbe", "xboxkrnl.json"), ordinals);
+    static OrdinalDB ordinals(REDasm::makeFormatPath("xbe"));
     u32 kernelimagethunk;
 
     if(!this->decodeKernel(this->_format->KernelImageThunk, kernelimagethunk))
@@ -161,7 +173,7 @@ bool XbeFormat::loadXBoxKrnl()
 
     while(*pthunk)
     {
-        std::string ordinalname = REDasm::ordinal(ordinals, *pthunk ^ XBE_ORDINAL_FLAG, "XBoxKrnl!");
+        std::string ordinalname = ordinals.name("xboxkrnl", *pthunk ^ XBE_ORDINAL_FLAG, "XBoxKrnl!");
         this->defineSymbol(*pthunk, ordinalname, SymbolTypes::Import);
         pthunk++;
     }
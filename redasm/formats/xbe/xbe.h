@@ -17,6 +17,9 @@ class XbeFormat : public FormatPluginT<XbeImageHeader>
         virtual const char* assembler() const;
         virtual bool load(u8 *rawformat, u64);
 
+    public:
+        static u32 probe(const u8* data, u64 length);
+
     private:
         void displayXbeInfo();
         bool decodeEP(u32 encodedep, address_t &ep);
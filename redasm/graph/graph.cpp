@@ -170,10 +170,10 @@ void LayeredGraph::setGraph(Graph *graph)
     this->indicize();
 }
 
-void LayeredGraph::shuffle()
+void LayeredGraph::shuffle(std::mt19937_64 &engine)
 {
     for(VertexList& vl : *this)
-        std::random_shuffle(vl.begin(), vl.end());
+        std::shuffle(vl.begin(), vl.end(), engine);
 }
 
 void LayeredGraph::layerize()
@@ -2,6 +2,7 @@
 #define GRAPH_H
 
 #include <deque>
+#include <random>
 #include "../redasm.h"
 #include "vertex.h"
 
@@ -75,7 +76,7 @@ class LayeredGraph: public std::vector<VertexList>
         LayeredGraph(Graph* graph);
         vertex_layer_t lastLayer() const;
         void setGraph(Graph* graph);
-        void shuffle();
+        void shuffle(std::mt19937_64& engine);
 
     private:
         void layerize();
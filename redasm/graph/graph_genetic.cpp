@@ -1,13 +1,19 @@
 #include "graph_genetic.h"
 #include <iostream>
 
-#define MAX_GRAPHS 100
+#define MAX_GRAPHS                 100
+#define GRAPH_PLATEAU               20 // Give up after 20 generations without less crossings
+#define GRAPH_CONCURRENCY_THRESHOLD 64 // Vertices: smaller graphs are evaluated faster than workers start
 
 namespace REDasm {
 namespace Graphing {
 
-GraphGenetic::GraphGenetic(Graph *graph): genetic<LayeredGraphPtr, VertexList>(), _graph(graph)
+const size_t GraphGenetic::AUTO_THREADS = static_cast<size_t>(-1);
+
+GraphGenetic::GraphGenetic(Graph *graph, seed_t seed, size_t threads): genetic<LayeredGraphPtr, VertexList>(seed), _graph(graph)
 {
+    this->set_plateau(GRAPH_PLATEAU);
+
     for(size_t i = 0; i < MAX_GRAPHS; i++)
     {
         LayeredGraphPtr lgraph = std::make_shared<LayeredGraph>(graph);
@@ -15,9 +21,17 @@ GraphGenetic::GraphGenetic(Graph *graph): genetic<LayeredGraphPtr, VertexList>()
         if(!i && !this->crossingCount(lgraph))
             break;
 
-        lgraph->shuffle();
+        lgraph->shuffle(this->random_engine());
         this->add_individual(lgraph);
     }
+
+    if(this->empty()) // No crossings: nothing to grow
+        return;
+
+    if(threads == GraphGenetic::AUTO_THREADS)
+        threads = (graph->vertexCount() >= GRAPH_CONCURRENCY_THRESHOLD) ? thread_pool::concurrency() : 0;
+
+    this->set_threads(threads);
 }
 
 GraphGenetic::individual_t GraphGenetic::make_child() const { return std::make_shared<LayeredGraph>(); }
@@ -37,7 +51,7 @@ void GraphGenetic::mutate(GraphGenetic::allele_t &allele) const
         return;
     }
 
-    size_t idx1 = std::rand() % allele.size(), idx2 = std::rand() % allele.size();
+    size_t idx1 = this->random(allele.size()), idx2 = this->random(allele.size());
     std::iter_swap(allele.begin() + idx1, allele.begin() + idx2);
 }
 
@@ -9,10 +9,11 @@ namespace Graphing {
 
 class GraphGenetic : public genetic<LayeredGraphPtr, VertexList>
 {
-    private:
+    public:
+        static const size_t AUTO_THREADS;
 
     public:
-        GraphGenetic(Graph* graph);
+        GraphGenetic(Graph* graph, seed_t seed = GraphGenetic::random_seed(), size_t threads = GraphGenetic::AUTO_THREADS); // The initial population depends on 'seed' only
 
     protected:
         virtual individual_t make_child() const;
@@ -30,6 +30,7 @@ struct Vertex
     } layout;
 
     Vertex(): id(0), color("black"), graph(NULL) { layout = { 0, -1, false }; }
+    virtual ~Vertex() { }
     virtual s64 compare(Vertex* v) const { return id - v->id; }
     virtual bool equalsTo(Vertex* v) const { return compare(v) == 0; }
     virtual bool lessThan(Vertex* v) const { return compare(v) < 0; }
@@ -1,7 +1,5 @@
 #include "assembler.h"
 #include "../format.h"
-#include <iomanip>
-#include <sstream>
 
 namespace REDasm {
 
@@ -27,12 +25,7 @@ Printer *AssemblerPlugin::createPrinter(DisassemblerAPI *disassembler, SymbolTab
 
 void AssemblerPlugin::analyzeOperand(DisassemblerAPI *disassembler, const InstructionPtr &instruction, const Operand &operand) const
 {
-    if(operand.is(OperandTypes::Register))
-    {
-        this->analyzeRegister(disassembler, instruction, operand);
-        return;
-    }
-    else if(!operand.isNumeric())
+    if(!operand.isNumeric()) // Registers are resolved once per function, by constant propagation
         return;
 
     u64 value = operand.u_value;
@@ -98,16 +91,16 @@ void AssemblerPlugin::prepare(const InstructionPtr &instruction)
 
 bool AssemblerPlugin::decode(Buffer buffer, const InstructionPtr &instruction)
 {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
+    char hexbyte[HEX_BUFFER_SIZE];
+    instruction->bytes.clear();
+    instruction->bytes.reserve(instruction->size * 2);
 
     for(u64 i = 0; i < instruction->size; i++)
     {
         u8 b = buffer[i];
-        ss << std::setw(2) << static_cast<size_t>(b);
+        instruction->bytes.append(hexbyte, REDasm::hexstring(hexbyte, b, 8, false, false));
     }
 
-    instruction->bytes = ss.str();
     return false;
 }
 
@@ -175,16 +168,12 @@ void AssemblerPlugin::popState()
     this->_statestack.pop();
 }
 
-void AssemblerPlugin::analyzeRegister(DisassemblerAPI *disassembler, const InstructionPtr &instruction, const Operand &operand) const
+void AssemblerPlugin::analyzeRegister(DisassemblerAPI *disassembler, const InstructionPtr &instruction, const Operand &operand, u64 value) const
 {
-    if(!disassembler->emulator() || !operand.is(OperandTypes::Register))
-        return;
-
-    address_t target = 0;
-
-    if(!disassembler->emulator()->read(operand, target))
+    if(!operand.is(OperandTypes::Register))
         return;
 
+    address_t target = value;
     Segment* segment = disassembler->format()->segment(target);
 
     if(!segment)
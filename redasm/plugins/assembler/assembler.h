@@ -33,6 +33,7 @@ class AssemblerPlugin: public Plugin
         virtual VMIL::Emulator* createEmulator(DisassemblerAPI* disassembler) const;
         virtual Printer* createPrinter(DisassemblerAPI* disassembler, SymbolTable* symboltable) const;
         virtual void analyzeOperand(DisassemblerAPI* disassembler, const InstructionPtr& instruction, const Operand& operand) const;
+        virtual void analyzeRegister(DisassemblerAPI* disassembler, const InstructionPtr& instruction, const Operand &operand, u64 value) const;
         virtual void prepare(const InstructionPtr& instruction);
         virtual bool decode(Buffer buffer, const InstructionPtr& instruction);
         virtual bool done(const InstructionPtr& instruction);
@@ -48,7 +49,6 @@ class AssemblerPlugin: public Plugin
         void popState();
 
     protected:
-        virtual void analyzeRegister(DisassemblerAPI* disassembler, const InstructionPtr& instruction, const Operand &operand) const;
         virtual void analyzeRegisterBranch(address_t target, DisassemblerAPI* disassembler, const InstructionPtr& instruction, const Operand &operand) const;
 
     private:
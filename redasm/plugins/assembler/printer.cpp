@@ -3,7 +3,91 @@
 
 namespace REDasm {
 
-Printer::Printer(DisassemblerAPI *disassembler, SymbolTable *symboltable): _disassembler(disassembler), _symboltable(symboltable)
+PrinterCache::PrinterCache(ChangeJournal *journal): _journal(journal), _generation(0)
+{
+    this->_subscription = journal->subscribe([this](const Change& change) { this->applyChange(change); });
+}
+
+PrinterCache::~PrinterCache()
+{
+    this->_journal->unsubscribe(this->_subscription);
+}
+
+PrinterCache::RenderedLinePtr PrinterCache::line(address_t address) const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_lines.find(address);
+
+    if((it == this->_lines.end()) || (it->second->generation != this->_generation))
+        return NULL;
+
+    return it->second;
+}
+
+void PrinterCache::insert(const InstructionPtr &instruction, const RenderedLinePtr &renderedline)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if(this->_lines.size() >= PRINTER_CACHE_SIZE)
+    {
+        this->_lines.clear();
+        this->_dependents.clear();
+    }
+
+    renderedline->generation = this->_generation;
+
+    for(const Operand& operand : instruction->operands) // Symbols that imm() and disp() may print
+    {
+        if(operand.isNumeric())
+            this->_dependents[operand.u_value].insert(instruction->address);
+        else if(operand.is(OperandTypes::Displacement) && operand.disp.displacement)
+            this->_dependents[operand.disp.displacement].insert(instruction->address);
+    }
+
+    this->_lines[instruction->address] = renderedline;
+}
+
+void PrinterCache::invalidate()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_generation++;
+}
+
+void PrinterCache::applyChange(const Change &change)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if(change.is(ChangeTypes::InstructionUpdated))
+    {
+        this->eraseLine(change.address);
+        return;
+    }
+
+    if(!change.is(ChangeTypes::SymbolCreated) && !change.is(ChangeTypes::SymbolRenamed) && !change.is(ChangeTypes::SymbolErased))
+        return;
+
+    auto it = this->_dependents.find(change.address);
+
+    if(it == this->_dependents.end())
+        return;
+
+    for(address_t address : it->second)
+        this->eraseLine(address);
+
+    this->_dependents.erase(it);
+}
+
+void PrinterCache::eraseLine(address_t address)
+{
+    this->_lines.erase(address); // Stale entries in '_dependents' are harmless: they just erase again
+}
+
+Printer::Printer(DisassemblerAPI *disassembler, SymbolTable *symboltable): _disassembler(disassembler), _symboltable(symboltable), _cacheable(true), _cache(disassembler->printerCache())
+{
+
+}
+
+Printer::~Printer()
 {
 
 }
@@ -21,7 +105,7 @@ void Printer::symbols(const InstructionPtr &instruction, Printer::SymbolCallback
 std::string Printer::symbol(const SymbolPtr &symbol) const
 {
     if(symbol->is(SymbolTypes::Pointer))
-        return symbol->name;
+        return symbol->displayName();
 
     std::string s;
 
@@ -37,10 +121,58 @@ std::string Printer::out(const InstructionPtr &instruction) const
     return this->out(instruction, [](const Operand&, const std::string&, const std::string&) { });
 }
 
+std::string Printer::out(const InstructionPtr &instruction, OpCallback opfunc) const
+{
+    std::string line;
+    this->out(instruction, line, opfunc);
+    return line;
+}
+
+void Printer::out(const InstructionPtr &instruction, std::string &line, OpCallback opfunc) const
+{
+    if(!this->_cacheable || !this->_cache)
+    {
+        this->render(instruction, line, opfunc);
+        return;
+    }
+
+    PrinterCache::RenderedLinePtr cachedline = this->_cache->line(instruction->address);
+
+    if(cachedline) // Replay: no symbol lookups
+    {
+        if(opfunc)
+        {
+            for(const PrinterCache::RenderedOperand& renderedop : cachedline->operands)
+                opfunc(renderedop.operand, renderedop.opsize, renderedop.opstr);
+        }
+
+        line += cachedline->text;
+        return;
+    }
+
+    auto renderedline = std::make_shared<PrinterCache::RenderedLine>();
+
+    this->render(instruction, renderedline->text, [&renderedline, &opfunc](const Operand& operand, const std::string& opsize, const std::string& opstr) {
+        renderedline->operands.push_back({ operand, opsize, opstr });
+
+        if(opfunc)
+            opfunc(operand, opsize, opstr);
+    });
+
+    this->_cache->insert(instruction, renderedline);
+    line += renderedline->text;
+}
+
+void Printer::invalidate()
+{
+    if(this->_cache)
+        this->_cache->invalidate();
+}
+
 void Printer::header(const SymbolPtr &symbol, Printer::HeaderCallback headerfunc)
 {
     std::string s(20, '=');
-    headerfunc(s + " FUNCTION ", symbol->name, " " + s);
+    headerfunc(s + " FUNCTION ", symbol->displayName(), " " + s);
 }
 
 void Printer::prologue(const SymbolPtr &symbol, Printer::LineCallback prologuefunc)
@@ -66,7 +198,7 @@ void Printer::symbol(const SymbolPtr &symbol, SymbolCallback symbolfunc) const
 
         if(ptrsymbol)
         {
-            symbolfunc(symbol, ptrsymbol->name);
+            symbolfunc(symbol, ptrsymbol->displayName());
             this->symbol(ptrsymbol, symbolfunc); // Emit pointed symbol too
             return;
         }
@@ -99,25 +231,28 @@ void Printer::info(const InstructionPtr &instruction, LineCallback infofunc)
     RE_UNUSED(infofunc);
 }
 
-std::string Printer::out(const InstructionPtr &instruction, Printer::OpCallback opfunc) const
+void Printer::render(const InstructionPtr &instruction, std::string &line, Printer::OpCallback opfunc) const
 {
     const OperandList& operands = instruction->operands;
-    std::string s = instruction->mnemonic;
+    line += instruction->mnemonic;
 
     if(instruction->isInvalid())
     {
-        s += instruction->bytes;
-        opfunc(Operand(), std::string(), instruction->bytes);
-        return s;
+        line += instruction->bytes;
+
+        if(opfunc)
+            opfunc(Operand(), std::string(), instruction->bytes);
+
+        return;
     }
 
     if(!operands.empty())
-        s += " ";
+        line += ' ';
 
     for(auto it = operands.begin(); it != operands.end(); it++)
     {
         if(it != operands.begin())
-            s += ", ";
+            line += ", ";
 
         std::string opstr;
         const Operand& operand = *it;
@@ -137,18 +272,19 @@ std::string Printer::out(const InstructionPtr &instruction, Printer::OpCallback
                 continue;
         }
 
-        std::string opsize = OperandSizes::size(operand.size);
+        const std::string& opsize = OperandSizes::size(operand.size);
 
         if(opfunc)
             opfunc(operand, opsize, opstr);
 
         if(!opsize.empty())
-            s += opsize + " ";
+        {
+            line += opsize;
+            line += ' ';
+        }
 
-        s += opstr;
+        line += opstr;
     }
-
-    return s;
 }
 
 std::string Printer::reg(const RegisterOperand &regop) const
@@ -171,7 +307,10 @@ std::string Printer::disp(const DisplacementOperand &dispop) const
         s += this->reg(dispop.index);
 
         if(dispop.scale > 1)
-            s += " * " + REDasm::hex(dispop.scale);
+        {
+            s += " * ";
+            REDasm::appendhex(s, dispop.scale);
+        }
     }
 
     if(dispop.displacement)
@@ -181,7 +320,10 @@ std::string Printer::disp(const DisplacementOperand &dispop) const
         if(!s.empty() && ((dispop.displacement > 0) || symbol))
             s += " + ";
 
-        s += symbol ? symbol->name : REDasm::hex(dispop.displacement);
+        if(symbol)
+            s += symbol->displayName();
+        else
+            REDasm::appendhex(s, dispop.displacement);
     }
 
     if(!s.empty())
@@ -201,9 +343,19 @@ std::string Printer::imm(const Operand &operand) const
     SymbolPtr symbol = this->_symboltable->symbol(operand.u_value);
 
     if(operand.is(OperandTypes::Memory))
-        return "[" + (symbol ? symbol->name : REDasm::hex(operand.u_value)) + "]";
+    {
+        std::string s = "[";
+
+        if(symbol)
+            s += symbol->displayName();
+        else
+            REDasm::appendhex(s, operand.u_value);
+
+        s += ']';
+        return s;
+    }
 
-    return symbol ? symbol->name : REDasm::hex(operand.s_value);
+    return symbol ? symbol->displayName() : REDasm::hex(operand.s_value);
 }
 
 CapstonePrinter::CapstonePrinter(csh cshandle, DisassemblerAPI *disassembler, SymbolTable *symboltable): Printer(disassembler, symboltable), _cshandle(cshandle)
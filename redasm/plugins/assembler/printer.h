@@ -2,13 +2,43 @@
 #define PRINTER_H
 
 #include <memory>
+#include <mutex>
 #include <capstone.h>
 #include "../../redasm.h"
 #include "../../disassembler/types/symboltable.h"
 #include "../../disassembler/disassemblerapi.h"
 
+#define PRINTER_CACHE_SIZE 0x10000 // Lines
+
 namespace REDasm {
 
+class PrinterCache // Rendered lines, shared by every printer of a disassembler
+{
+    public:
+        struct RenderedOperand { Operand operand; std::string opsize, opstr; };
+        struct RenderedLine { u64 generation; std::string text; std::vector<RenderedOperand> operands; };
+        typedef std::shared_ptr<RenderedLine> RenderedLinePtr;
+
+    public:
+        PrinterCache(ChangeJournal* journal);
+        ~PrinterCache();
+        RenderedLinePtr line(address_t address) const;
+        void insert(const InstructionPtr& instruction, const RenderedLinePtr& renderedline);
+        void invalidate();
+
+    private:
+        void applyChange(const Change& change);
+        void eraseLine(address_t address);
+
+    private:
+        mutable std::mutex _mutex;
+        std::unordered_map<address_t, RenderedLinePtr> _lines;
+        std::unordered_map<address_t, std::set<address_t> > _dependents; // Symbol's address -> lines that print it
+        ChangeJournal* _journal;
+        ChangeJournal::subscription_t _subscription;
+        u64 _generation;
+};
+
 class Printer
 {
     public:
@@ -19,16 +49,19 @@ class Printer
 
     public:
         Printer(DisassemblerAPI* disassembler, SymbolTable* symboltable);
+        virtual ~Printer();
         void symbols(const InstructionPtr& instruction, SymbolCallback symbolfunc);
         std::string symbol(const SymbolPtr& symbol) const;
         std::string out(const InstructionPtr& instruction) const;
+        std::string out(const InstructionPtr& instruction, OpCallback opfunc) const;
+        void out(const InstructionPtr& instruction, std::string& line, OpCallback opfunc = nullptr) const; // Appends to a reusable buffer
+        void invalidate();
 
     public:
         virtual void header(const SymbolPtr& symbol, HeaderCallback headerfunc);
         virtual void prologue(const SymbolPtr& symbol, LineCallback prologuefunc);
         virtual void symbol(const SymbolPtr& symbol, SymbolCallback symbolfunc) const;
         virtual void info(const InstructionPtr& instruction, LineCallback infofunc);
-        virtual std::string out(const InstructionPtr& instruction, OpCallback opfunc) const;
 
     public: // Operand privitives
         virtual std::string reg(const RegisterOperand& regop) const;
@@ -36,9 +69,16 @@ class Printer
         virtual std::string loc(const Operand& operand) const;
         virtual std::string imm(const Operand& operand) const;
 
+    protected:
+        virtual void render(const InstructionPtr& instruction, std::string& line, OpCallback opfunc) const;
+
     protected:
         DisassemblerAPI* _disassembler;
         SymbolTable* _symboltable;
+        bool _cacheable; // Lines are cached by address: disable it for instructions the journal doesn't track
+
+    private:
+        PrinterCache* _cache; // Owned by the disassembler
 };
 
 class CapstonePrinter: public Printer
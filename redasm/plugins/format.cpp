@@ -125,6 +125,14 @@ void FormatPlugin::defineSymbol(address_t address, const std::string &name, u32
     this->_symbol.create(address, name, type | SymbolTypes::Locked, extratype);
 }
 
+void FormatPlugin::defineSymbols(SymbolVector &symbols)
+{
+    for(Symbol& symbol : symbols)
+        symbol.lock();
+
+    this->_symbol.create(symbols);
+}
+
 void FormatPlugin::defineFunction(address_t address, const std::string& name, u32 extratype)
 {
     this->defineSymbol(address, name, SymbolTypes::Function, extratype);
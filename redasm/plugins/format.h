@@ -8,7 +8,8 @@
 #include "../analyzer/analyzer.h"
 #include "base.h"
 
-#define DECLARE_FORMAT_PLUGIN(T, id) inline FormatPlugin* id##_formatPlugin(u8* data, u64 length) { return REDasm::declareFormatPlugin<T>(data, length); }
+#define DECLARE_FORMAT_PLUGIN(T, id) inline FormatPlugin* id##_formatPlugin(u8* data, u64 length) { return REDasm::declareFormatPlugin<T>(data, length); } \
+                                     inline u32 id##_formatProbe(const u8* data, u64 length) { return T::probe(data, length); }
 
 namespace REDasm {
 
@@ -23,6 +24,15 @@ template<typename T> T* declareFormatPlugin(u8* data, u64 length)
     return NULL;
 }
 
+namespace FormatConfidence { // Returned by probes: the best match is the only one that gets load()'ed
+    enum: u32 { None     = 0,
+                Fallback = 1,   // Always matches (eg. binary)
+                Low      = 25,  // Heuristics only
+                High     = 75,  // Magic number
+                Certain  = 100, // Magic number and consistent header
+    };
+}
+
 namespace FormatFlags {
     enum: u32 { None                 = 0,
                 Binary               = 1, // Internal Use
@@ -52,10 +62,14 @@ class FormatPlugin: public Plugin
         virtual endianness_t endianness() const;
         virtual bool load(u8* format);
 
+    public:
+        static u32 probe(const u8*, u64) { return FormatConfidence::Low; }
+
     protected:
         void addSignature(const std::string& signaturefile);
         void defineSegment(const std::string& name, offset_t offset, address_t address, u64 size, u32 flags);
         void defineSymbol(address_t address, const std::string& name, u32 type, u32 extratype = 0);
+        void defineSymbols(SymbolVector& symbols);
         void defineFunction(address_t address, const std::string &name, u32 extratype = 0);
         void defineEntryPoint(address_t address, u32 extratype = 0);
 
@@ -87,7 +101,16 @@ class FormatPluginB: public FormatPluginT<u8>
         virtual bool load(u8* format) { this->_format = format; return FormatPluginT<u8>::load(format); }
 };
 
-typedef std::function<FormatPlugin*(u8*, u64)> FormatPlugin_Entry;
+typedef std::function<FormatPlugin*(u8*, u64)> FormatPlugin_Load;
+typedef std::function<u32(const u8*, u64)> FormatPlugin_Probe;
+
+struct FormatPlugin_Entry
+{
+    FormatPlugin_Entry(const FormatPlugin_Probe& probe, const FormatPlugin_Load& load): probe(probe), load(load) { }
+
+    FormatPlugin_Probe probe; // Cheap, must not trust header fields
+    FormatPlugin_Load load;
+};
 
 }
 
@@ -22,7 +22,7 @@
 //#include ASSEMBLER_PLUGIN(arm64)
 #include ASSEMBLER_PLUGIN(chip8)
 
-#define REGISTER_FORMAT_PLUGIN(id)    REDasm::formats.push_back(&id##_formatPlugin)
+#define REGISTER_FORMAT_PLUGIN(id)    REDasm::formats.emplace_back(&id##_formatProbe, &id##_formatPlugin)
 #define REGISTER_ASSEMBLER_PLUGIN(id) REDasm::assemblers[#id] = &id##_assemblerPlugin
 
 namespace REDasm {
@@ -33,6 +33,7 @@ std::unordered_map<std::string, AssemblerPlugin_Entry> assemblers;
 void init(const std::string& searchpath)
 {
     Runtime::rntSearchPath = searchpath;
+    REDasm::loadDemangleCache();
 
     REGISTER_FORMAT_PLUGIN(pe);
     REGISTER_FORMAT_PLUGIN(elf32);
@@ -57,22 +58,48 @@ void init(const std::string& searchpath)
     REGISTER_ASSEMBLER_PLUGIN(chip8);
 }
 
+void deinit()
+{
+    REDasm::saveDemangleCache();
+}
+
 FormatPlugin *getFormat(u8 *data, u64 length)
 {
     if(!data)
         return NULL;
 
+    std::vector< std::pair<u32, const FormatPlugin_Entry*> > candidates;
+
     for(auto it = formats.begin(); it != formats.end(); it++)
     {
-        FormatPlugin* fp = (*it)(data, length);
+        u32 confidence = it->probe(data, length);
+
+        if(confidence)
+            candidates.emplace_back(confidence, &(*it));
+    }
+
+    // Registration order breaks ties
+    std::stable_sort(candidates.begin(), candidates.end(), [](const std::pair<u32, const FormatPlugin_Entry*>& c1,
+                                                              const std::pair<u32, const FormatPlugin_Entry*>& c2) -> bool {
+        return c1.first > c2.first;
+    });
+
+    for(auto it = candidates.begin(); it != candidates.end(); it++)
+    {
+        FormatPlugin* fp = it->second->load(data, length);
 
-        if(fp)
+        if(fp) // Fall back to the next candidate if a probe was too optimistic
             return fp;
     }
 
     return NULL;
 }
 
+FormatPlugin *getFormat(const Buffer &buffer)
+{
+    return getFormat(buffer.data, buffer.length);
+}
+
 AssemblerPlugin *getAssembler(const char* id)
 {
     if(!id)
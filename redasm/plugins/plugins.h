@@ -13,10 +13,12 @@ extern std::list<FormatPlugin_Entry> formats;
 extern std::unordered_map<std::string, AssemblerPlugin_Entry> assemblers;
 
 FormatPlugin* getFormat(u8* data, u64 length);
+FormatPlugin* getFormat(const Buffer& buffer);
 AssemblerPlugin* getAssembler(const char *id);
 void setLoggerCallback(Runtime::LogCallback logcb);
 void setStatusCallback(Runtime::LogCallback logcb);
 void init(const std::string &searchpath);
+void deinit(); // Saves what is shared between sessions, every front end calls it before exiting
 
 }
 
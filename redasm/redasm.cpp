@@ -20,21 +20,23 @@ LogCallback rntStatusCallback = [](const std::string&) { };
 
 namespace OperandSizes {
 
-std::string size(u32 opsize)
+const std::string& size(u32 opsize)
 {
+    static const std::string SIZES[] = { std::string(), "byte", "word", "dword", "qword" }; // Shared: printers call this per operand
+
     if(opsize == OperandSizes::Byte)
-        return "byte";
+        return SIZES[1];
 
     if(opsize == OperandSizes::Word)
-        return "word";
+        return SIZES[2];
 
     if(opsize == OperandSizes::Dword)
-        return "dword";
+        return SIZES[3];
 
     if(opsize == OperandSizes::Qword)
-        return "qword";
+        return SIZES[4];
 
-    return std::string();
+    return SIZES[0];
 }
 
 } // naspace OperandSizes
@@ -122,7 +122,7 @@ namespace OperandSizes {
         Qword      = 8,
     };
 
-    std::string size(u32 opsize);
+    const std::string& size(u32 opsize);
 }
 
 namespace BlockTypes {
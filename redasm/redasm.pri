@@ -0,0 +1,187 @@
+# Core engine: no Qt dependencies, shared by the GUI and the command line tool
+
+SOURCES += $$PWD/plugins/plugins.cpp \
+    $$PWD/plugins/format.cpp \
+    $$PWD/analyzer/analyzer.cpp \
+    $$PWD/analyzer/analyzerpass.cpp \
+    $$PWD/analyzer/callarguments.cpp \
+    $$PWD/disassembler/disassembler.cpp \
+    $$PWD/formats/psxexe/psxexe.cpp \
+    $$PWD/formats/psxexe/psxexe_analyzer.cpp \
+    $$PWD/formats/pe/pe.cpp \
+    $$PWD/plugins/assembler/printer.cpp \
+    $$PWD/formats/pe/pe_analyzer.cpp \
+    $$PWD/formats/pe/pe_utils.cpp \
+    $$PWD/formats/elf/elf.cpp \
+    $$PWD/support/utils.cpp \
+    $$PWD/support/demangler.cpp \
+    $$PWD/assemblers/mips/mips.cpp \
+    $$PWD/assemblers/x86/x86.cpp \
+    $$PWD/plugins/assembler/assembler.cpp \
+    $$PWD/formats/pe/vb/vb_analyzer.cpp \
+    $$PWD/formats/pe/vb/vb_components.cpp \
+    $$PWD/formats/pe/pe_imports.cpp \
+    $$PWD/disassembler/disassemblerbase.cpp \
+    $$PWD/disassembler/types/listing.cpp \
+    $$PWD/disassembler/types/referencetable.cpp \
+    $$PWD/disassembler/types/symboltable.cpp \
+    $$PWD/support/coff/coff_symboltable.cpp \
+    $$PWD/support/hash.cpp \
+    $$PWD/signatures/patparser.cpp \
+    $$PWD/support/serializer.cpp \
+    $$PWD/signatures/signaturedb.cpp \
+    $$PWD/redasm.cpp \
+    $$PWD/formats/pe/pe_resources.cpp \
+    $$PWD/formats/pe/borland/borland_version.cpp \
+    $$PWD/formats/binary/binary.cpp \
+    $$PWD/assemblers/chip8/chip8.cpp \
+    $$PWD/support/endianness.cpp \
+    $$PWD/vmil/vmil_instructions.cpp \
+    $$PWD/vmil/vmil_emulator.cpp \
+    $$PWD/vmil/vmil_printer.cpp \
+    $$PWD/vmil/vmil_cache.cpp \
+    $$PWD/vmil/vmil_constprop.cpp \
+    $$PWD/vmil/vmil_registerfile.cpp \
+    $$PWD/vmil/vmil_memory.cpp \
+    $$PWD/assemblers/mips/mips_quirks.cpp \
+    $$PWD/assemblers/mips/mips_printer.cpp \
+    $$PWD/assemblers/x86/x86_printer.cpp \
+    $$PWD/assemblers/chip8/chip8_printer.cpp \
+    $$PWD/assemblers/chip8/chip8_emulator.cpp \
+    $$PWD/assemblers/mips/mips_emulator.cpp \
+    $$PWD/formats/dex/dex.cpp \
+    $$PWD/assemblers/dalvik/dalvik.cpp \
+    $$PWD/assemblers/dalvik/dalvik_printer.cpp \
+    $$PWD/formats/dex/dex_statemachine.cpp \
+    $$PWD/formats/dex/dex_utils.cpp \
+    $$PWD/formats/elf/elf_analyzer.cpp \
+    $$PWD/disassembler/disassemblerapi.cpp \
+    $$PWD/assemblers/cil/cil.cpp \
+    $$PWD/formats/pe/dotnet/dotnet.cpp \
+    $$PWD/formats/pe/dotnet/dotnet_reader.cpp \
+    $$PWD/graph/graph.cpp \
+    $$PWD/graph/graph_layout.cpp \
+    $$PWD/disassembler/graph/functiongraph.cpp \
+    $$PWD/graph/graph_genetic.cpp \
+    $$PWD/disassembler/graph/callgraph.cpp \
+    $$PWD/formats/xbe/xbe.cpp \
+    $$PWD/support/ordinals.cpp \
+    $$PWD/support/mappedfile.cpp \
+    $$PWD/support/batch.cpp \
+    $$PWD/disassembler/types/listingindex.cpp \
+    $$PWD/disassembler/types/changejournal.cpp \
+    $$PWD/disassembler/types/progress.cpp \
+    $$PWD/formats/gba/gba.cpp \
+    $$PWD/formats/gba/gba_analyzer.cpp \
+    $$PWD/assemblers/metaarm/metaarm.cpp \
+    $$PWD/assemblers/metaarm/metaarm_printer.cpp \
+    $$PWD/assemblers/metaarm/metaarm_emulator.cpp \
+    $$PWD/assemblers/metaarm/arm.cpp \
+    $$PWD/assemblers/metaarm/armthumb.cpp \
+    $$PWD/assemblers/metaarm/arm_common.cpp
+
+HEADERS += $$PWD/redasm.h \
+    $$PWD/plugins/format.h \
+    $$PWD/plugins/base.h \
+    $$PWD/plugins/plugins.h \
+    $$PWD/analyzer/analyzer.h \
+    $$PWD/analyzer/analyzerpass.h \
+    $$PWD/analyzer/callarguments.h \
+    $$PWD/disassembler/disassembler.h \
+    $$PWD/formats/psxexe/psxexe.h \
+    $$PWD/formats/psxexe/psxexe_analyzer.h \
+    $$PWD/formats/pe/pe.h \
+    $$PWD/formats/pe/pe_constants.h \
+    $$PWD/formats/pe/pe_headers.h \
+    $$PWD/plugins/assembler/printer.h \
+    $$PWD/formats/pe/pe_analyzer.h \
+    $$PWD/formats/pe/pe_utils.h \
+    $$PWD/formats/elf/elf.h \
+    $$PWD/formats/elf/elf64_header.h \
+    $$PWD/formats/elf/elf32_header.h \
+    $$PWD/formats/elf/elf_common.h \
+    $$PWD/support/demangler.h \
+    $$PWD/support/utils.h \
+    $$PWD/assemblers/mips/mips.h \
+    $$PWD/assemblers/x86/x86.h \
+    $$PWD/formats/pe/vb/vb_analyzer.h \
+    $$PWD/formats/pe/vb/vb_header.h \
+    $$PWD/formats/pe/vb/vb_components.h \
+    $$PWD/formats/pe/pe_imports.h \
+    $$PWD/disassembler/disassemblerbase.h \
+    $$PWD/disassembler/types/listing.h \
+    $$PWD/disassembler/types/referencetable.h \
+    $$PWD/disassembler/types/symboltable.h \
+    $$PWD/support/coff/coff_symboltable.h \
+    $$PWD/support/coff/coff_types.h \
+    $$PWD/support/coff/coff_constants.h \
+    $$PWD/support/cachemap.h \
+    $$PWD/support/hash.h \
+    $$PWD/signatures/patparser.h \
+    $$PWD/support/serializer.h \
+    $$PWD/signatures/signaturedb.h \
+    $$PWD/formats/pe/pe_resources.h \
+    $$PWD/formats/pe/borland/borland_types.h \
+    $$PWD/formats/pe/borland/borland_version.h \
+    $$PWD/formats/binary/binary.h \
+    $$PWD/assemblers/chip8/chip8.h \
+    $$PWD/support/endianness.h \
+    $$PWD/vmil/vmil_instructions.h \
+    $$PWD/vmil/vmil_types.h \
+    $$PWD/vmil/vmil_emulator.h \
+    $$PWD/vmil/vmil_printer.h \
+    $$PWD/vmil/vmil_cache.h \
+    $$PWD/vmil/vmil_constprop.h \
+    $$PWD/vmil/vmil_registerfile.h \
+    $$PWD/vmil/vmil_memory.h \
+    $$PWD/assemblers/mips/mips_printer.h \
+    $$PWD/assemblers/mips/mips_quirks.h \
+    $$PWD/assemblers/x86/x86_printer.h \
+    $$PWD/assemblers/chip8/chip8_emulator.h \
+    $$PWD/assemblers/chip8/chip8_printer.h \
+    $$PWD/assemblers/chip8/chip8_registers.h \
+    $$PWD/assemblers/mips/mips_emulator.h \
+    $$PWD/formats/dex/dex.h \
+    $$PWD/formats/dex/dex_constants.h \
+    $$PWD/formats/dex/dex_header.h \
+    $$PWD/assemblers/dalvik/dalvik.h \
+    $$PWD/assemblers/dalvik/dalvik_printer.h \
+    $$PWD/assemblers/dalvik/dalvik_metadata.h \
+    $$PWD/assemblers/dalvik/dalvik_opcodes.h \
+    $$PWD/formats/dex/dex_statemachine.h \
+    $$PWD/formats/dex/dex_utils.h \
+    $$PWD/formats/pe/pe_debug.h \
+    $$PWD/formats/pe/pe_common.h \
+    $$PWD/formats/elf/elf_analyzer.h \
+    $$PWD/disassembler/disassemblerapi.h \
+    $$PWD/formats/pe/dotnet/dotnet_header.h \
+    $$PWD/assemblers/cil/cil.h \
+    $$PWD/formats/pe/dotnet/dotnet.h \
+    $$PWD/formats/pe/dotnet/dotnet_tables.h \
+    $$PWD/formats/pe/dotnet/dotnet_reader.h \
+    $$PWD/graph/graph.h \
+    $$PWD/graph/graph_layout.h \
+    $$PWD/disassembler/graph/functiongraph.h \
+    $$PWD/graph/vertex.h \
+    $$PWD/support/genetic.h \
+    $$PWD/support/threadpool.h \
+    $$PWD/graph/graph_genetic.h \
+    $$PWD/disassembler/graph/callgraph.h \
+    $$PWD/formats/xbe/xbe.h \
+    $$PWD/formats/xbe/xbe_header.h \
+    $$PWD/support/ordinals.h \
+    $$PWD/support/mappedfile.h \
+    $$PWD/support/batch.h \
+    $$PWD/disassembler/types/listingindex.h \
+    $$PWD/disassembler/types/changejournal.h \
+    $$PWD/disassembler/types/progress.h \
+    $$PWD/formats/gba/gba.h \
+    $$PWD/formats/gba/gba_analyzer.h \
+    $$PWD/assemblers/metaarm/metaarm.h \
+    $$PWD/assemblers/metaarm/metaarm_printer.h \
+    $$PWD/assemblers/metaarm/metaarm_emulator.h \
+    $$PWD/assemblers/metaarm/arm.h \
+    $$PWD/assemblers/metaarm/armthumb.h \
+    $$PWD/assemblers/metaarm/arm_common.h
+
+win32: LIBS += -lpsapi
@@ -66,7 +66,16 @@ bool SignatureDB::match(const std::string &hexbytes, Signature& signature)
             return true;
         }
 
-        EdgeList& edges = this->_edges[currentgraph];
+        auto eit = this->_edges.find(currentgraph); // No insertions: analyzers match concurrently
+
+        if(eit == this->_edges.end()) {
+            if(!currentgraph->isleaf)
+                failed = true;
+
+            return false;
+        }
+
+        EdgeList& edges = eit->second;
         auto it = this->findEdge(edges, pattern);
 
         if(it == edges.end()) {
@@ -0,0 +1,178 @@
+#include "batch.h"
+#include "mappedfile.h"
+#include "../disassembler/disassembler.h"
+#include <json.hpp>
+#include <fstream>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace REDasm {
+namespace Batch {
+
+using json = nlohmann::json;
+
+bool analyze(const std::string &filename, const std::string &outputfile, u32 output, BatchResult &result)
+{
+    auto start = std::chrono::steady_clock::now();
+    MappedFile mappedfile;
+    result.filename = filename;
+
+    if(!mappedfile.open(filename))
+    {
+        result.error = "Cannot open file";
+        return false;
+    }
+
+    Buffer buffer = mappedfile.buffer();
+    FormatPlugin* format = REDasm::getFormat(buffer);
+
+    if(!format || format->isBinary()) // Binaries need a manual loader, skip them
+    {
+        if(format)
+            delete format;
+
+        result.error = "Unsupported format";
+        return false;
+    }
+
+    AssemblerPlugin* assembler = REDasm::getAssembler(format->assembler());
+    result.format = format->name();
+
+    if(!assembler)
+    {
+        result.error = "Cannot find assembler '" + std::string(format->assembler() ? format->assembler() : "") + "'";
+        delete format;
+        return false;
+    }
+
+    result.assembler = assembler->name();
+    mappedfile.advise(format->segments());
+
+    Disassembler disassembler(buffer, assembler, format);
+    disassembler.disassemble();
+    result.elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if(!exportListing(&disassembler, outputfile, output, result))
+        return false;
+
+    result.peakrss = peakRSS();
+    result.success = true;
+    return true;
+}
+
+bool exportListing(Disassembler *disassembler, const std::string &outputfile, u32 output, BatchResult &result)
+{
+    SymbolTable* symboltable = disassembler->symbolTable();
+    Listing& listing = disassembler->listing();
+    json symbols = json::array(), functions = json::array(), xrefs = json::array();
+
+    symboltable->iterate(SymbolTypes::LockedMask, [&](const SymbolPtr& symbol) -> bool {
+        json jsymbol = { { "address", symbol->address }, { "name", symbol->name }, { "type", symbol->type } };
+
+        if(REDasm::isMangled(symbol->name))
+            jsymbol["demangled"] = symbol->displayName();
+
+        symbols.push_back(jsymbol);
+        result.symbols++;
+
+        address_t startaddress = 0, endaddress = 0;
+
+        if(symbol->isFunction() && listing.getFunctionBounds(symbol->address, &startaddress, &endaddress))
+        {
+            functions.push_back({ { "address", symbol->address }, { "start", startaddress }, { "end", endaddress } });
+            result.functions++;
+        }
+
+        ReferenceVector refs = disassembler->getReferences(symbol);
+
+        if(refs.empty())
+            return true;
+
+        xrefs.push_back({ { "address", symbol->address }, { "from", refs } });
+        result.references += refs.size();
+        return true;
+    });
+
+    if(output == BatchOutputs::None)
+        return true;
+
+    json js = { { "file", result.filename },
+                { "format", result.format },
+                { "assembler", result.assembler },
+                { "bits", disassembler->format()->bits() },
+                { "symbols", symbols },
+                { "functions", functions },
+                { "xrefs", xrefs } };
+
+    std::ofstream ofs(outputfile, std::ios::out | std::ios::trunc | std::ios::binary);
+
+    if(!ofs.is_open())
+    {
+        result.error = "Cannot write '" + outputfile + "'";
+        return false;
+    }
+
+    if(output == BatchOutputs::Binary) // Same document, CBOR encoded
+    {
+        std::vector<u8> cbor = json::to_cbor(js);
+        ofs.write(reinterpret_cast<const char*>(cbor.data()), cbor.size());
+    }
+    else
+        ofs << js;
+
+    return true;
+}
+
+std::string toJson(const BatchResult &result)
+{
+    json js = { { "file", result.filename },
+                { "success", result.success },
+                { "elapsed_ms", result.elapsed },
+                { "peak_rss_kb", result.peakrss },
+                { "symbols", result.symbols },
+                { "functions", result.functions },
+                { "xrefs", result.references } };
+
+    if(!result.format.empty())
+        js["format"] = result.format;
+
+    if(!result.assembler.empty())
+        js["assembler"] = result.assembler;
+
+    if(!result.error.empty())
+        js["error"] = result.error;
+
+    return js.dump();
+}
+
+u64 peakRSS()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return 0;
+
+    return pmc.PeakWorkingSetSize / 1024;
+#else
+    struct rusage usage;
+
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+} // namespace Batch
+} // namespace REDasm
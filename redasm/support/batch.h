@@ -0,0 +1,35 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "../redasm.h"
+
+namespace REDasm {
+
+class Disassembler;
+
+namespace BatchOutputs {
+    enum: u32 { None = 0, Json, Binary };
+}
+
+struct BatchResult
+{
+    BatchResult(): success(false), elapsed(0), peakrss(0), symbols(0), functions(0), references(0) { }
+
+    std::string filename, format, assembler, error;
+    bool success;
+    double elapsed;                     // Milliseconds: load + disassembly
+    u64 peakrss;                        // KiB
+    u64 symbols, functions, references;
+};
+
+namespace Batch {
+
+bool analyze(const std::string& filename, const std::string& outputfile, u32 output, BatchResult& result); // Headless: format -> assembler -> disassemble() -> export
+bool exportListing(Disassembler* disassembler, const std::string& outputfile, u32 output, BatchResult& result);
+std::string toJson(const BatchResult& result);
+u64 peakRSS();                                                                                             // Whole process, in KiB
+
+} // namespace Batch
+} // namespace REDasm
+
+#endif // BATCH_H
@@ -3,9 +3,18 @@
 
 #define CACHE_DEFAULT  "cachemap"
 #define CACHE_FILE_EXT ".db"
-#define CACHE_FILE     (_name + "_" + std::to_string(_timestamp) + CACHE_FILE_EXT)
+#define CACHE_FILE     (_name + "_" + std::to_string(CACHE_PID) + "_" + std::to_string(_timestamp) + "_" + std::to_string(_serial) + CACHE_FILE_EXT)
+
+#ifdef _WIN32
+#include <process.h>
+#define CACHE_PID _getpid()
+#else
+#include <unistd.h>
+#define CACHE_PID getpid()
+#endif
 
 #include <functional>
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <cstdio>
@@ -14,6 +23,8 @@
 
 namespace REDasm {
 
+inline u32 cache_serial() { static std::atomic<u32> serial(0); return serial++; } // Concurrent analyses must not share files
+
 template<typename T1, typename T2> class cache_map // Use STL's coding style for this type
 {
     private:
@@ -25,6 +36,7 @@ template<typename T1, typename T2> class cache_map // Use STL's coding style for
         class iterator: public std::iterator<std::random_access_iterator_tag, T2> {
             public:
                 explicit iterator(type& container, const offset_iterator& offit): _container(container), _offit(offit), key(offit->first) { }
+                iterator(const iterator& rhs) = default;
                 iterator& operator++() { _offit++; update(); return *this; }
                 iterator& operator--() { _offit--; update(); return *this; }
                 iterator operator++(int) { iterator copy = *this; _offit++; update(); return copy; }
@@ -46,13 +58,15 @@ template<typename T1, typename T2> class cache_map // Use STL's coding style for
         };
 
     public:
-        cache_map(): _name(CACHE_DEFAULT), _timestamp(time(NULL)) { }
-        cache_map(const std::string& name): _name(name), _timestamp(time(NULL)) { }
+        cache_map(): _name(CACHE_DEFAULT), _timestamp(time(NULL)), _serial(cache_serial()) { }
+        cache_map(const std::string& name): _name(name), _timestamp(time(NULL)), _serial(cache_serial()) { }
         ~cache_map();
         iterator begin() { return iterator(*this, this->_offsets.begin()); }
         iterator end() { return iterator(*this, this->_offsets.end()); }
         iterator find(const T1& key) { auto it = this->_offsets.find(key); return iterator(*this, it); }
+        size_t size() const { return this->_offsets.size(); }
         void commit(const T1& key, const T2& value);
+        template<typename InputIterator> void commit(InputIterator first, InputIterator last);
         void erase(const iterator& it);
         T2 operator[](const T1& key);
 
@@ -60,11 +74,15 @@ template<typename T1, typename T2> class cache_map // Use STL's coding style for
         virtual void serialize(const T2& value, std::fstream& fs) = 0;
         virtual void deserialize(T2& value, std::fstream& fs) = 0;
 
+    private:
+        void open();
+
     private:
         std::string _name;
         offset_map _offsets;
         std::fstream _file;
         time_t _timestamp;
+        u32 _serial;
 };
 
 template<typename T1, typename T2> cache_map<T1, T2>::~cache_map()
@@ -78,13 +96,7 @@ template<typename T1, typename T2> cache_map<T1, T2>::~cache_map()
 
 template<typename T1, typename T2> void cache_map<T1, T2>::commit(const T1& key, const T2 &value)
 {
-    if(!this->_file.is_open())
-    {
-        this->_file.open(CACHE_FILE, std::ios::in | std::ios::out |
-                                     std::ios::trunc | std::ios::binary);
-
-    }
-
+    this->open();
     this->_file.seekp(0, std::ios::end); // Ignore old key -> value reference, if any
     this->_offsets[key] = this->_file.tellp();
 
@@ -92,6 +104,35 @@ template<typename T1, typename T2> void cache_map<T1, T2>::commit(const T1& key,
     this->_file.clear(); // Reset error state
 }
 
+template<typename T1, typename T2> template<typename InputIterator> void cache_map<T1, T2>::commit(InputIterator first, InputIterator last)
+{
+    if(first == last)
+        return;
+
+    this->open();
+    this->_file.seekp(0, std::ios::end);
+
+    auto hint = this->_offsets.end(); // Sorted input appends in constant time
+
+    for(InputIterator it = first; it != last; it++)
+    {
+        hint = this->_offsets.insert(hint, std::make_pair(it->first, offset_t(0)));
+        hint->second = this->_file.tellp();
+        this->serialize(it->second, this->_file);
+        hint++;
+    }
+
+    this->_file.clear(); // Reset error state
+}
+
+template<typename T1, typename T2> void cache_map<T1, T2>::open()
+{
+    if(this->_file.is_open())
+        return;
+
+    this->_file.open(CACHE_FILE, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+}
+
 template<typename T1, typename T2> void cache_map<T1, T2>::erase(const cache_map<T1, T2>::iterator &it)
 {
     auto oit = this->_offsets.find(it.key);
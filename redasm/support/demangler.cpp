@@ -1,23 +1,196 @@
 #include "demangler.h"
+#include "../redasm.h"
+#include <fstream>
+#include <cstdio>
+#include <mutex>
+
+#ifdef _WIN32
+    #include <process.h>
+    #define DEMANGLER_PID _getpid()
+#else
+    #include <unistd.h>
+    #define DEMANGLER_PID getpid()
+#endif
 
 #ifdef __GNUC__
 #include <cstdlib>
 #include <cxxabi.h>
 #endif
 
+#define DEMANGLER_CACHE_SIZE 65536
+#define DEMANGLER_CACHE_FILE "demangler.cache"
+
 namespace REDasm {
 
+class DemangleCache // Bounded LRU, shared by every loaded binary
+{
+    private:
+        typedef std::pair<std::string, std::string> Entry; // Mangled -> Demangled
+        typedef std::list<Entry> EntryList;                // Most recently used first
+
+    public:
+        DemangleCache(size_t capacity): _capacity(capacity), _dirty(false) { }
+        bool get(const std::string& mangled, std::string& demangled);
+        void put(const std::string& mangled, const std::string& demangled);
+        bool load(const std::string& filename);
+        bool save(const std::string& filename); // Only if something was demangled since the last load/save
+
+    private:
+        bool insert(const std::string& mangled, const std::string& demangled);
+
+    private:
+        EntryList _entries;
+        std::unordered_map<std::string, EntryList::iterator> _index;
+        std::mutex _mutex;
+        size_t _capacity;
+        bool _dirty;
+};
+
+bool DemangleCache::get(const std::string &mangled, std::string &demangled)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_index.find(mangled);
+
+    if(it == this->_index.end())
+        return false;
+
+    this->_entries.splice(this->_entries.begin(), this->_entries, it->second);
+    demangled = it->second->second;
+    return true;
+}
+
+void DemangleCache::put(const std::string &mangled, const std::string &demangled)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if(this->insert(mangled, demangled))
+        this->_dirty = true;
+}
+
+bool DemangleCache::load(const std::string &filename)
+{
+    std::ifstream ifs(filename);
+
+    if(!ifs.is_open())
+        return false;
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    std::string line;
+
+    while(std::getline(ifs, line)) // Saved from MRU to LRU
+    {
+        size_t idx = line.find('\t');
+
+        if(idx == std::string::npos)
+            continue;
+
+        std::string mangled = line.substr(0, idx);
+
+        if(this->_index.find(mangled) == this->_index.end())
+        {
+            this->_entries.emplace_back(mangled, line.substr(idx + 1));
+            this->_index[mangled] = std::prev(this->_entries.end());
+        }
+
+        if(this->_entries.size() >= this->_capacity)
+            break;
+    }
+
+    return true;
+}
+
+bool DemangleCache::save(const std::string &filename)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if(!this->_dirty || this->_entries.empty())
+        return false;
+
+    // Write a private copy and rename it: batch workers save concurrently
+    std::string tmpfile = filename + "." + std::to_string(DEMANGLER_PID);
+    std::ofstream ofs(tmpfile, std::ios::out | std::ios::trunc);
+
+    if(!ofs.is_open())
+        return false;
+
+    for(const Entry& entry : this->_entries)
+        ofs << entry.first << "\t" << entry.second << "\n";
+
+    ofs.close();
+
+#ifdef _WIN32
+    std::remove(filename.c_str()); // rename() doesn't replace existing files
+#endif
+
+    if(!ofs || std::rename(tmpfile.c_str(), filename.c_str()))
+    {
+        std::remove(tmpfile.c_str());
+        return false;
+    }
+
+    this->_dirty = false;
+    return true;
+}
+
+bool DemangleCache::insert(const std::string &mangled, const std::string &demangled)
+{
+    auto it = this->_index.find(mangled);
+
+    if(it != this->_index.end())
+    {
+        this->_entries.splice(this->_entries.begin(), this->_entries, it->second);
+        return false;
+    }
+
+    this->_entries.emplace_front(mangled, demangled);
+    this->_index[mangled] = this->_entries.begin();
+
+    if(this->_entries.size() <= this->_capacity)
+        return true;
+
+    this->_index.erase(this->_entries.back().first);
+    this->_entries.pop_back();
+    return true;
+}
+
+static DemangleCache& demangleCache() { static DemangleCache cache(DEMANGLER_CACHE_SIZE); return cache; }
+
+bool isMangled(const std::string &s) { return (s.size() > 2) && !s.compare(0, 2, "_Z"); } // Itanium ABI
+
 std::string demangle(const std::string &s)
 {
+    if(!REDasm::isMangled(s)) // Don't let __cxa_demangle() turn plain names into types (eg. 'f' -> 'float')
+        return s;
+
+    std::string demangled;
+
+    if(demangleCache().get(s, demangled))
+        return demangled;
+
+    size_t idx = s.find('@'); // Keep versions and stub suffixes (eg. '@plt', '@@GLIBCXX_3.4')
+    std::string mangled = (idx != std::string::npos) ? s.substr(0, idx) : s;
+
+#ifdef __GNUC__
     int status = 0;
-    char* ret = abi::__cxa_demangle(s.c_str(), NULL, NULL, &status);
+    char* ret = abi::__cxa_demangle(mangled.c_str(), NULL, NULL, &status);
 
-    if(!ret)
-        return s;
+    if(ret)
+    {
+        demangled = ret;
+        std::free(ret);
 
-    std::string demangled(ret);
-    std::free(ret);
+        if(idx != std::string::npos)
+            demangled += s.substr(idx);
+    }
+    else
+#endif
+        demangled = s;
+
+    demangleCache().put(s, demangled);
     return demangled;
 }
 
+bool loadDemangleCache() { return demangleCache().load(REDasm::makeDbPath(DEMANGLER_CACHE_FILE)); }
+bool saveDemangleCache() { return demangleCache().save(REDasm::makeDbPath(DEMANGLER_CACHE_FILE)); }
+
 }
@@ -5,7 +5,10 @@
 
 namespace REDasm {
 
-std::string demangle(const std::string& s);
+bool isMangled(const std::string& s);
+std::string demangle(const std::string& s); // Memoized, thread safe
+bool loadDemangleCache();                   // From the database directory, if any
+bool saveDemangleCache();
 
 }
 
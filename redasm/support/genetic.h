@@ -5,6 +5,7 @@
 #define GENETIC_MUTATION_RATE   10 // Set mutation rate to 10%
 #define GENETIC_BEST_RATE       30 // Set best rate to 30%
 #define GENETIC_LUCKY_RATE      10 // Set lucky rate to 10%
+#define GENETIC_PLATEAU          0 // Don't stop on fitness plateaus
 
 #include <vector>
 #include <utility>
@@ -12,11 +13,14 @@
 #include <ctime>
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include "threadpool.h"
 
 namespace REDasm {
 
 typedef double fitness_t;
 typedef size_t generation_t;
+typedef uint64_t seed_t;
 
 template<typename INDIVIDUAL, typename ALLELE> class genetic
 {
@@ -24,13 +28,14 @@ template<typename INDIVIDUAL, typename ALLELE> class genetic
         typedef INDIVIDUAL individual_t;
         typedef ALLELE allele_t;
         typedef std::pair<individual_t, fitness_t> individual_fitness_t;
+        typedef std::mt19937_64 random_engine_t;
 
     protected:
         typedef std::vector<individual_fitness_t> population_fitness_t;
         typedef std::vector<individual_t> population_t;
 
     public:
-        genetic();
+        genetic(seed_t seed = genetic::random_seed());
         bool empty() const { return _population.empty(); }
         size_t size() const { return _population.size(); }
         generation_t generation() const { return _generation; }
@@ -38,15 +43,22 @@ template<typename INDIVIDUAL, typename ALLELE> class genetic
         void set_mutation_rate(size_t rate) { _mutationrate = rate; }
         void set_best_rate(size_t rate) { _bestrate = rate; }
         void set_lucky_rate(size_t rate) { _luckyrate = rate; }
+        void set_plateau(size_t generations) { _plateau = generations; }     // Stop after N generations without improvements (0 = never)
+        void set_threads(size_t count) { _pool.resize(count); }             // Evaluate fitness in parallel (0 = caller's thread)
+        void set_seed(seed_t seed) { _seed = seed; _rng.seed(seed); }       // Fixed seed: reproducible runs
+        seed_t seed() const { return _seed; }
+        static seed_t random_seed() { return std::random_device()() ^ static_cast<seed_t>(std::time(NULL)); }
         void exterminate() { _population.clear(); }
         individual_fitness_t grow(individual_t expected);
 
     protected:
         void add_individual(const individual_t& individual) { _population.push_back(individual); }
-        virtual void mutate_individual(individual_t& individual) const { this->mutate(this->get_allele(individual, std::rand() % this->allele_size(individual))); }
+        random_engine_t& random_engine() const { return _workerrng ? *_workerrng : _rng; }
+        size_t random(size_t n) const { return n ? static_cast<size_t>(this->random_engine()() % n) : 0; }
+        virtual void mutate_individual(individual_t& individual) const { this->mutate(this->get_allele(individual, this->random(this->allele_size(individual)))); }
         virtual void generation_completed(const individual_fitness_t&) const { }
         virtual void generation_best_completed(const individual_fitness_t&) const { }
-        virtual bool child_randomized() const { return (std::rand() % 100) < 50; }
+        virtual bool child_randomized() const { return this->random(100) < 50; }
         virtual individual_t create_child(individual_t& individual1, individual_t& individual2);
         virtual individual_t make_child() const { return individual_t(); }
         virtual fitness_t expected_fitness() const { return 100; }
@@ -67,34 +79,35 @@ template<typename INDIVIDUAL, typename ALLELE> class genetic
         population_t _population;
 
     private:
-        size_t _generation, _maxpopulation, _maxgeneration;
+        size_t _generation, _maxpopulation, _maxgeneration, _plateau;
         double _mutationrate, _bestrate, _luckyrate;
+        std::vector<random_engine_t> _workerrngs;
+        mutable random_engine_t _rng;
+        thread_pool _pool;
+        seed_t _seed;
 
     private:
-        static unsigned int _seed;
+        static thread_local random_engine_t* _workerrng;
 };
 
-template<typename INDIVIDUAL, typename ALLELE> unsigned int genetic<INDIVIDUAL, ALLELE>::_seed = 0;
+template<typename INDIVIDUAL, typename ALLELE> thread_local typename genetic<INDIVIDUAL, ALLELE>::random_engine_t* genetic<INDIVIDUAL, ALLELE>::_workerrng = NULL;
 
-template<typename INDIVIDUAL, typename ALLELE> genetic<INDIVIDUAL, ALLELE>::genetic()
+template<typename INDIVIDUAL, typename ALLELE> genetic<INDIVIDUAL, ALLELE>::genetic(seed_t seed)
 {
     this->_generation = this->_maxpopulation = 0;
     this->_maxgeneration = GENETIC_MAX_GENERATION;
+    this->_plateau = GENETIC_PLATEAU;
     this->_mutationrate = GENETIC_MUTATION_RATE;
     this->_bestrate = GENETIC_BEST_RATE;
     this->_luckyrate = GENETIC_LUCKY_RATE;
-
-    if(_seed)
-        return;
-
-    _seed = std::time(NULL);
-    std::srand(_seed);
+    this->set_seed(seed);
 }
 
 template<typename INDIVIDUAL, typename ALLELE> typename genetic<INDIVIDUAL, ALLELE>::individual_fitness_t genetic<INDIVIDUAL, ALLELE>::grow(individual_t expected)
 {
     individual_fitness_t bestfitness;
     fitness_t maxfitness = 0;
+    size_t stalled = 0;
 
     this->_generation = 1;
     this->_maxpopulation = this->_population.size();
@@ -114,13 +127,20 @@ template<typename INDIVIDUAL, typename ALLELE> typename genetic<INDIVIDUAL, ALLE
             bestfitness = currbestfitness;
             maxfitness = currbestfitness.second;
             this->generation_best_completed(bestfitness);
+            stalled = 0;
         }
         else
+        {
             this->generation_completed(currbestfitness);
+            stalled++;
+        }
 
         if((this->_generation >= this->_maxgeneration) || (currbestfitness.second == this->expected_fitness()))
             break;
 
+        if(this->_plateau && (stalled >= this->_plateau))
+            break;
+
         this->create_children(candidates);
         this->mutate_population();
         this->_generation++;
@@ -151,12 +171,39 @@ template<typename INDIVIDUAL, typename ALLELE> fitness_t genetic<INDIVIDUAL, ALL
 
 template<typename INDIVIDUAL, typename ALLELE> void genetic<INDIVIDUAL, ALLELE>::compute_fitness(genetic::population_fitness_t &populationfitness, individual_t &expected)
 {
-    populationfitness.reserve(this->_population.size());
+    populationfitness.resize(this->_population.size());
 
-    for(individual_t& individual : this->_population)
-        populationfitness.push_back(std::make_pair(individual, this->fitness(individual, expected)));
+    if(this->_pool.size() < 2)
+    {
+        for(size_t i = 0; i < this->_population.size(); i++)
+            populationfitness[i] = std::make_pair(this->_population[i], this->fitness(this->_population[i], expected));
+    }
+    else
+    {
+        // One contiguous chunk per worker, each one with its own engine seeded from the master one:
+        // results depend on seed and thread count only, not on scheduling
+        size_t chunks = std::min(this->_pool.size(), this->_population.size());
+        size_t chunksize = (this->_population.size() + chunks - 1) / chunks;
+        this->_workerrngs.resize(chunks);
+
+        for(size_t c = 0; c < chunks; c++)
+        {
+            this->_workerrngs[c].seed(this->_rng());
+
+            this->_pool.enqueue([this, c, chunksize, &populationfitness, &expected](size_t) {
+                _workerrng = &this->_workerrngs[c];
+
+                for(size_t i = c * chunksize; (i < (c + 1) * chunksize) && (i < this->_population.size()); i++)
+                    populationfitness[i] = std::make_pair(this->_population[i], this->fitness(this->_population[i], expected));
+
+                _workerrng = NULL;
+            });
+        }
+
+        this->_pool.wait();
+    }
 
-    std::sort(populationfitness.begin(), populationfitness.end(), [](const individual_fitness_t& fitness1, const individual_fitness_t& fitness2) {
+    std::stable_sort(populationfitness.begin(), populationfitness.end(), [](const individual_fitness_t& fitness1, const individual_fitness_t& fitness2) {
         return fitness1.second > fitness2.second;
     });
 }
@@ -171,7 +218,7 @@ template<typename INDIVIDUAL, typename ALLELE> void genetic<INDIVIDUAL, ALLELE>:
 
     for(ssize_t i = 0; i < luckycount; i++)
     {
-        ssize_t idx = bestcount + (std::rand() % luckycount);
+        ssize_t idx = bestcount + this->random(luckycount);
 
         if(std::find(candidates.rbegin(), candidates.rend(), populationfitness[idx].first) != candidates.rend())
             continue;
@@ -179,14 +226,14 @@ template<typename INDIVIDUAL, typename ALLELE> void genetic<INDIVIDUAL, ALLELE>:
         candidates.push_back(populationfitness[idx].first);
     }
 
-    std::random_shuffle(candidates.begin(), candidates.end());
+    std::shuffle(candidates.begin(), candidates.end(), this->_rng);
 }
 
 template<typename INDIVIDUAL, typename ALLELE> void genetic<INDIVIDUAL, ALLELE>::mutate_population()
 {
     for(individual_t& individual : this->_population)
     {
-        if(static_cast<size_t>(std::rand() % 100) < this->_mutationrate)
+        if(this->random(100) < this->_mutationrate)
             this->mutate_individual(individual);
     }
 }
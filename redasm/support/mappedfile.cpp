@@ -0,0 +1,172 @@
+#include "mappedfile.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace REDasm {
+
+#ifdef _WIN32
+MappedFile::MappedFile(): _data(NULL), _size(0), _file(INVALID_HANDLE_VALUE), _mapping(NULL) { }
+#else
+MappedFile::MappedFile(): _data(NULL), _size(0), _fd(-1) { }
+#endif
+
+MappedFile::~MappedFile()
+{
+    this->close();
+}
+
+bool MappedFile::open(const std::string &filename)
+{
+    this->close();
+
+#ifdef _WIN32
+    this->_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if(this->_file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER filesize;
+
+    if(!GetFileSizeEx(this->_file, &filesize) || !filesize.QuadPart)
+    {
+        this->close();
+        return false;
+    }
+
+    this->_size = static_cast<u64>(filesize.QuadPart);
+    this->_mapping = CreateFileMappingA(this->_file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+
+    if(this->_mapping)
+        this->_data = reinterpret_cast<u8*>(MapViewOfFile(this->_mapping, FILE_MAP_COPY, 0, 0, 0));
+#else
+    this->_fd = ::open(filename.c_str(), O_RDONLY);
+
+    if(this->_fd == -1)
+        return false;
+
+    struct stat st;
+
+    if((fstat(this->_fd, &st) == -1) || !st.st_size)
+    {
+        this->close();
+        return false;
+    }
+
+    this->_size = static_cast<u64>(st.st_size);
+
+    // Some plugins patch the buffer in place: private pages keep the file untouched
+    void* data = mmap(NULL, this->_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, this->_fd, 0);
+
+    if(data != MAP_FAILED)
+        this->_data = reinterpret_cast<u8*>(data);
+#endif
+
+    if(!this->_data)
+    {
+        REDasm::log("Cannot map " + REDasm::quoted(filename));
+        this->close();
+        return false;
+    }
+
+    this->advise(0, this->_size, MappedAdvices::Random); // Format parsing jumps around
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if(this->_data)
+        UnmapViewOfFile(this->_data);
+
+    if(this->_mapping)
+        CloseHandle(this->_mapping);
+
+    if(this->_file != INVALID_HANDLE_VALUE)
+        CloseHandle(this->_file);
+
+    this->_mapping = NULL;
+    this->_file = INVALID_HANDLE_VALUE;
+#else
+    if(this->_data)
+        munmap(this->_data, this->_size);
+
+    if(this->_fd != -1)
+        ::close(this->_fd);
+
+    this->_fd = -1;
+#endif
+
+    this->_data = NULL;
+    this->_size = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+    return this->_data != NULL;
+}
+
+u8 *MappedFile::data() const
+{
+    return this->_data;
+}
+
+u64 MappedFile::size() const
+{
+    return this->_size;
+}
+
+Buffer MappedFile::buffer() const
+{
+    return Buffer(this->_data, static_cast<s64>(this->_size));
+}
+
+void MappedFile::advise(offset_t offset, u64 size, u32 advice) const
+{
+    if(!this->_data || (offset >= this->_size))
+        return;
+
+    size = std::min(size, this->_size - offset);
+
+#ifdef _WIN32
+    RE_UNUSED(advice); // No portable equivalent: let the memory manager decide
+#else
+    long pagesize = sysconf(_SC_PAGESIZE);
+    offset_t alignedoffset = offset - (offset % pagesize); // madvise() wants page aligned addresses
+    int flags = MADV_NORMAL;
+
+    if(advice == MappedAdvices::Sequential)
+        flags = MADV_SEQUENTIAL;
+    else if(advice == MappedAdvices::Random)
+        flags = MADV_RANDOM;
+    else if(advice == MappedAdvices::WillNeed)
+        flags = MADV_WILLNEED;
+    else if(advice == MappedAdvices::DontNeed)
+        flags = MADV_DONTNEED;
+
+    madvise(this->_data + alignedoffset, size + (offset - alignedoffset), flags);
+#endif
+}
+
+void MappedFile::advise(const SegmentList &segments) const
+{
+    for(auto it = segments.begin(); it != segments.end(); it++)
+    {
+        const Segment& segment = *it;
+
+        if(segment.is(SegmentTypes::Bss))
+            continue;
+
+        // Code is swept linearly, data is read where it's referenced
+        this->advise(segment.offset, segment.size(), segment.is(SegmentTypes::Code) ? MappedAdvices::Sequential :
+                                                                                      MappedAdvices::Random);
+    }
+}
+
+} // namespace REDasm
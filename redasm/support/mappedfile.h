@@ -0,0 +1,43 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "../redasm.h"
+
+namespace REDasm {
+
+namespace MappedAdvices {
+    enum: u32 { Normal = 0, Sequential, Random, WillNeed, DontNeed };
+}
+
+class MappedFile // Read-only, private mapping: pages are loaded on demand, never copied
+{
+    public:
+        MappedFile();
+        ~MappedFile();
+        bool open(const std::string& filename);
+        void close();
+        bool isOpen() const;
+        u8* data() const;
+        u64 size() const;
+        Buffer buffer() const;
+        void advise(offset_t offset, u64 size, u32 advice) const;
+        void advise(const SegmentList& segments) const;
+
+    private:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator =(const MappedFile&) = delete;
+
+    private:
+        u8* _data;
+        u64 _size;
+
+#ifdef _WIN32
+        void *_file, *_mapping;
+#else
+        int _fd;
+#endif
+};
+
+} // namespace REDasm
+
+#endif // MAPPEDFILE_H
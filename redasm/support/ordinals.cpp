@@ -1,7 +1,28 @@
 #include "ordinals.h"
 #include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include <json.hpp>
 
+#ifdef _WIN32
+    #include <windows.h>
+    #include <process.h>
+    #define ORDINALS_PID _getpid()
+#else
+    #include <dirent.h>
+    #include <unistd.h>
+    #define ORDINALS_PID getpid()
+#endif
+
+#define ORDINALS_JSON_EXT   ".json"
+#define ORDINALS_CACHE_DIR  "REDasm"
+#define FNV_OFFSET_BASIS_32 0x811C9DC5u
+#define FNV_PRIME_32        0x01000193u
+#define FNV_OFFSET_BASIS_64 0xCBF29CE484222325ull
+#define FNV_PRIME_64        0x00000100000001B3ull
+
 namespace REDasm {
 
 using json = nlohmann::json;
@@ -38,14 +59,292 @@ bool loadordinals(const std::string &ordinalfile, OrdinalsMap &ordinals)
     return true;
 }
 
-std::string ordinal(const OrdinalsMap &ordinals, u64 ordinal, const std::string &fallbackprefix)
+OrdinalDB::OrdinalDB(const std::string &directory): _header(NULL), _entries(NULL), _pool(NULL)
 {
-    auto it = ordinals.find(ordinal);
+    if(!this->open(directory))
+        REDasm::log("Cannot load ordinals from " + REDasm::quoted(directory));
+}
+
+bool OrdinalDB::isValid() const { return this->_header != NULL; }
+
+bool OrdinalDB::lookup(const std::string &dllname, u64 ordinal, std::string &name) const
+{
+    if(!this->_header)
+        return false;
+
+    OrdinalDBEntry key = { OrdinalDB::dllHash(dllname), static_cast<u32>(ordinal), 0, 0 };
+    const OrdinalDBEntry* end = this->_entries + this->_header->count;
+
+    const OrdinalDBEntry* entry = std::lower_bound(this->_entries, end, key, [](const OrdinalDBEntry& e1, const OrdinalDBEntry& e2) -> bool {
+        return (e1.dll < e2.dll) || ((e1.dll == e2.dll) && (e1.ordinal < e2.ordinal));
+    });
 
-    if(it == ordinals.end())
+    if((entry == end) || (entry->dll != key.dll) || (entry->ordinal != key.ordinal))
+        return false;
+
+    name.assign(this->_pool + entry->name, entry->length);
+    return true;
+}
+
+std::string OrdinalDB::name(const std::string &dllname, u64 ordinal, const std::string &fallbackprefix) const
+{
+    std::string name;
+
+    if(!this->lookup(dllname, ordinal, name))
         return fallbackprefix + "Ordinal__" + REDasm::hex(ordinal, 16, false);
 
-    return it->second;
+    return name;
+}
+
+u32 OrdinalDB::dllHash(const std::string &dllname)
+{
+    size_t start = dllname.find_last_of("/\\"), end = dllname.find_last_of('.');
+    start = (start == std::string::npos) ? 0 : start + 1;
+
+    if((end == std::string::npos) || (end < start))
+        end = dllname.size();
+
+    u32 hash = FNV_OFFSET_BASIS_32; // FNV-1a of "msvbvm60", whatever the path, case or extension
+
+    for(size_t i = start; i < end; i++)
+    {
+        hash ^= static_cast<u8>(std::tolower(dllname[i]));
+        hash *= FNV_PRIME_32;
+    }
+
+    return hash;
+}
+
+bool OrdinalDB::open(const std::string &directory)
+{
+    std::vector<std::string> jsonfiles = OrdinalDB::listJson(directory);
+    u64 fingerprint = OrdinalDB::fingerprint(directory, jsonfiles);
+    std::vector<std::string> dbfiles = { REDasm::makePath(directory, ORDINALS_DB_FILE) };
+    std::string cachedirectory = OrdinalDB::cacheDirectory();
+
+    if(!cachedirectory.empty())
+        dbfiles.push_back(REDasm::makePath(cachedirectory, ORDINALS_DB_FILE));
+
+    for(const std::string& dbfile : dbfiles)
+    {
+        if(this->_mappedfile.open(dbfile) && this->load(this->_mappedfile.data(), this->_mappedfile.size(), fingerprint))
+            return true;
+
+        this->_mappedfile.close();
+    }
+
+    std::vector<u8> data;
+
+    if(!OrdinalDB::compile(directory, jsonfiles, fingerprint, data))
+        return false;
+
+    for(const std::string& dbfile : dbfiles)
+    {
+        if(!OrdinalDB::write(dbfile, data))
+            continue;
+
+        if(this->_mappedfile.open(dbfile) && this->load(this->_mappedfile.data(), this->_mappedfile.size(), fingerprint))
+            return true;
+
+        this->_mappedfile.close();
+    }
+
+    this->_data.swap(data);
+    return this->load(this->_data.data(), this->_data.size(), fingerprint);
+}
+
+bool OrdinalDB::load(const u8 *data, u64 size, u64 fingerprint)
+{
+    if(!data || (size < sizeof(OrdinalDBHeader)))
+        return false;
+
+    const OrdinalDBHeader* header = reinterpret_cast<const OrdinalDBHeader*>(data);
+
+    if((header->magic != ORDINALS_DB_MAGIC) || (header->version != ORDINALS_DB_VERSION) || (header->fingerprint != fingerprint))
+        return false;
+
+    if((header->pool < sizeof(OrdinalDBHeader) + (static_cast<u64>(header->count) * sizeof(OrdinalDBEntry))) || (header->pool > size))
+        return false;
+
+    const OrdinalDBEntry* entries = reinterpret_cast<const OrdinalDBEntry*>(data + sizeof(OrdinalDBHeader));
+    u64 poolsize = size - header->pool;
+
+    for(u32 i = 0; i < header->count; i++) // Validate once, lookups can trust it
+    {
+        if((static_cast<u64>(entries[i].name) + entries[i].length) > poolsize)
+            return false;
+    }
+
+    this->_header = header;
+    this->_entries = entries;
+    this->_pool = reinterpret_cast<const char*>(data + header->pool);
+    return true;
+}
+
+bool OrdinalDB::write(const std::string &dbfile, const std::vector<u8> &data)
+{
+    // Write a private copy and rename it, concurrent first runs may race here
+    std::string tmpfile = dbfile + "." + std::to_string(ORDINALS_PID);
+    std::ofstream ofs(tmpfile, std::ios::out | std::ios::trunc | std::ios::binary);
+
+    if(!ofs.is_open())
+        return false;
+
+    ofs.write(reinterpret_cast<const char*>(data.data()), data.size());
+    ofs.close();
+
+    if(!ofs)
+    {
+        std::remove(tmpfile.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    bool replaced = MoveFileExA(tmpfile.c_str(), dbfile.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+    bool replaced = !std::rename(tmpfile.c_str(), dbfile.c_str()); // Atomic: the old file is never missing
+#endif
+
+    if(!replaced)
+        std::remove(tmpfile.c_str());
+
+    return replaced;
+}
+
+bool OrdinalDB::compile(const std::string &directory, const std::vector<std::string> &jsonfiles, u64 fingerprint, std::vector<u8> &data)
+{
+    std::vector<OrdinalDBEntry> entries;
+    std::string pool;
+
+    for(const std::string& jsonfile : jsonfiles)
+    {
+        OrdinalsMap ordinals;
+
+        if(!REDasm::loadordinals(REDasm::makePath(directory, jsonfile), ordinals))
+            continue;
+
+        u32 dll = OrdinalDB::dllHash(jsonfile);
+
+        for(auto it = ordinals.begin(); it != ordinals.end(); it++)
+        {
+            OrdinalDBEntry entry = { dll, static_cast<u32>(it->first), static_cast<u32>(pool.size()), static_cast<u32>(it->second.size()) };
+            entries.push_back(entry);
+            pool += it->second;
+        }
+    }
+
+    if(entries.empty())
+        return false;
+
+    std::sort(entries.begin(), entries.end(), [](const OrdinalDBEntry& e1, const OrdinalDBEntry& e2) -> bool {
+        return (e1.dll < e2.dll) || ((e1.dll == e2.dll) && (e1.ordinal < e2.ordinal));
+    });
+
+    OrdinalDBHeader header = { ORDINALS_DB_MAGIC, ORDINALS_DB_VERSION, fingerprint, static_cast<u32>(entries.size()), 0 };
+    header.pool = sizeof(OrdinalDBHeader) + (entries.size() * sizeof(OrdinalDBEntry));
+
+    data.resize(header.pool + pool.size());
+    std::copy_n(reinterpret_cast<const u8*>(&header), sizeof(OrdinalDBHeader), data.begin());
+    std::copy_n(reinterpret_cast<const u8*>(entries.data()), entries.size() * sizeof(OrdinalDBEntry), data.begin() + sizeof(OrdinalDBHeader));
+    std::copy(pool.begin(), pool.end(), data.begin() + header.pool);
+    return true;
+}
+
+std::vector<std::string> OrdinalDB::listJson(const std::string &directory)
+{
+    std::vector<std::string> jsonfiles;
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA finddata;
+    HANDLE hfind = FindFirstFileA(REDasm::makePath(directory, "*" ORDINALS_JSON_EXT).c_str(), &finddata);
+
+    if(hfind != INVALID_HANDLE_VALUE)
+    {
+        do
+            jsonfiles.push_back(finddata.cFileName);
+        while(FindNextFileA(hfind, &finddata));
+
+        FindClose(hfind);
+    }
+#else
+    DIR* dir = opendir(directory.c_str());
+
+    if(dir)
+    {
+        std::string ext = ORDINALS_JSON_EXT;
+
+        while(struct dirent* entry = readdir(dir))
+        {
+            std::string filename = entry->d_name;
+
+            if((filename.size() > ext.size()) && !filename.compare(filename.size() - ext.size(), ext.size(), ext))
+                jsonfiles.push_back(filename);
+        }
+
+        closedir(dir);
+    }
+#endif
+
+    std::sort(jsonfiles.begin(), jsonfiles.end());
+    return jsonfiles;
+}
+
+u64 OrdinalDB::fingerprint(const std::string &directory, const std::vector<std::string> &jsonfiles)
+{
+    u64 hash = FNV_OFFSET_BASIS_64;
+
+    for(const std::string& jsonfile : jsonfiles)
+    {
+        struct stat st;
+        std::string s = jsonfile + ":";
+
+        if(!stat(REDasm::makePath(directory, jsonfile).c_str(), &st)) // Edits keeping the same size change the modification time
+            s += std::to_string(static_cast<u64>(st.st_size)) + ":" + std::to_string(static_cast<s64>(st.st_mtime));
+
+        s += ";";
+
+        for(char c : s)
+        {
+            hash ^= static_cast<u8>(c);
+            hash *= FNV_PRIME_64;
+        }
+    }
+
+    return hash;
+}
+
+std::string OrdinalDB::cacheDirectory()
+{
+#ifdef _WIN32
+    const char* localappdata = std::getenv("LOCALAPPDATA");
+
+    if(!localappdata || !*localappdata)
+        return std::string();
+
+    std::string directory = REDasm::makePath(localappdata, ORDINALS_CACHE_DIR);
+    CreateDirectoryA(directory.c_str(), NULL);
+#else
+    std::string cachehome;
+    const char* xdgcachehome = std::getenv("XDG_CACHE_HOME");
+
+    if(xdgcachehome && *xdgcachehome)
+        cachehome = xdgcachehome;
+    else
+    {
+        const char* home = std::getenv("HOME");
+
+        if(!home || !*home)
+            return std::string();
+
+        cachehome = REDasm::makePath(home, ".cache");
+        mkdir(cachehome.c_str(), 0755);
+    }
+
+    std::string directory = REDasm::makePath(cachehome, ORDINALS_CACHE_DIR);
+    mkdir(directory.c_str(), 0755);
+#endif
+
+    return directory;
 }
 
 } // namespace REDasm
@@ -2,13 +2,59 @@
 #define ORDINALS_H
 
 #include "../redasm.h"
+#include "mappedfile.h"
+
+#define ORDINALS_DB_FILE    "ordinals.db"
+#define ORDINALS_DB_MAGIC   0x4F445452 // 'RTDO'
+#define ORDINALS_DB_VERSION 1
 
 namespace REDasm {
 
 typedef std::unordered_map<u64, std::string> OrdinalsMap;
 
 bool loadordinals(const std::string& ordinalfile, OrdinalsMap& ordinals);
-std::string ordinal(const OrdinalsMap& ordinals, u64 ordinal, const std::string& fallbackprefix = std::string());
+
+struct OrdinalDBHeader
+{
+    u32 magic, version;
+    u64 fingerprint;  // Names, sizes and modification times of the JSON files it was compiled from
+    u32 count, pool;  // Entries, string pool's offset
+};
+
+struct OrdinalDBEntry // Sorted by (dll, ordinal)
+{
+    u32 dll, ordinal;
+    u32 name, length; // Relative to the string pool
+};
+
+class OrdinalDB // Compiled from <directory>/<dll>.json on first use, then memory mapped: lookups are read only and lock free
+                // Stored next to the JSON files, or in the user's cache directory if the database one is read only
+{
+    public:
+        OrdinalDB(const std::string& directory);
+        bool isValid() const;
+        bool lookup(const std::string& dllname, u64 ordinal, std::string& name) const;
+        std::string name(const std::string& dllname, u64 ordinal, const std::string& fallbackprefix = std::string()) const;
+
+    public:
+        static u32 dllHash(const std::string& dllname);
+
+    private:
+        bool open(const std::string& directory);
+        bool load(const u8* data, u64 size, u64 fingerprint);
+        static bool write(const std::string& dbfile, const std::vector<u8>& data);
+        static bool compile(const std::string& directory, const std::vector<std::string>& jsonfiles, u64 fingerprint, std::vector<u8>& data);
+        static std::vector<std::string> listJson(const std::string& directory);
+        static u64 fingerprint(const std::string& directory, const std::vector<std::string>& jsonfiles);
+        static std::string cacheDirectory();
+
+    private:
+        MappedFile _mappedfile;
+        std::vector<u8> _data; // Fallback, if no directory is writable
+        const OrdinalDBHeader* _header;
+        const OrdinalDBEntry* _entries;
+        const char* _pool;
+};
 
 } // namespace REDasm
 
@@ -0,0 +1,122 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <deque>
+
+namespace REDasm {
+
+class thread_pool // Use STL's coding style for this type
+{
+    public:
+        typedef std::function<void(size_t)> task_t; // Receives the worker's index
+
+    public:
+        thread_pool(size_t count = 0): _running(0), _stop(false) { this->resize(count); }
+        ~thread_pool() { this->shutdown(); }
+        size_t size() const { return _workers.size(); }
+        void resize(size_t count);
+        void enqueue(const task_t& task);
+        void wait();
+
+    public:
+        static size_t concurrency() { size_t c = std::thread::hardware_concurrency(); return c ? c : 1; }
+
+    private:
+        void shutdown();
+        void work(size_t index);
+
+    private:
+        std::vector<std::thread> _workers;
+        std::deque<task_t> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _taskcond, _donecond;
+        size_t _running;
+        bool _stop;
+};
+
+inline void thread_pool::resize(size_t count)
+{
+    if(count == _workers.size())
+        return;
+
+    this->shutdown();
+    _stop = false;
+
+    for(size_t i = 0; i < count; i++)
+        _workers.emplace_back(&thread_pool::work, this, i);
+}
+
+inline void thread_pool::enqueue(const task_t &task)
+{
+    if(_workers.empty()) // No workers: run it in the caller's thread
+    {
+        task(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(task);
+    }
+
+    _taskcond.notify_one();
+}
+
+inline void thread_pool::wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _donecond.wait(lock, [this]() { return _tasks.empty() && !_running; });
+}
+
+inline void thread_pool::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+
+    _taskcond.notify_all();
+
+    for(std::thread& t : _workers)
+        t.join();
+
+    _workers.clear();
+}
+
+inline void thread_pool::work(size_t index)
+{
+    while(true)
+    {
+        task_t task;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _taskcond.wait(lock, [this]() { return _stop || !_tasks.empty(); });
+
+            if(_stop && _tasks.empty())
+                return;
+
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+            _running++;
+        }
+
+        task(index);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running--;
+        }
+
+        _donecond.notify_all();
+    }
+}
+
+} // namespace REDasm
+
+#endif // THREADPOOL_H
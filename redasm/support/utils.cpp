@@ -1,5 +1,6 @@
 #include "utils.h"
 #include <algorithm>
+#include <cstring>
 
 namespace REDasm {
 
@@ -20,7 +21,25 @@ std::string wtoa(const std::wstring& ws)
     return s;
 }
 
-std::string quoted(const std::string &s) { return "\"" + s + "\""; }
-std::string quoted(const char* s) { return REDasm::quoted(std::string(s)); }
+std::string quoted(const std::string &s)
+{
+    std::string q;
+    q.reserve(s.size() + 2);
+    q += '"';
+    q += s;
+    q += '"';
+    return q;
+}
+
+std::string quoted(const char* s)
+{
+    size_t len = std::strlen(s);
+    std::string q;
+    q.reserve(len + 2);
+    q += '"';
+    q.append(s, len);
+    q += '"';
+    return q;
+}
 
 }
@@ -1,12 +1,15 @@
 #ifndef UTILS_H
 #define UTILS_H
 
-#include <sstream>
+#include <algorithm>
 #include <string>
-#include <iomanip>
 #include <climits>
+#include <cstdint>
 #include "demangler.h"
 
+#define HEX_MAX_DIGITS  16
+#define HEX_BUFFER_SIZE (HEX_MAX_DIGITS + 4) // Prefix, sign, digits and terminator
+
 namespace REDasm
 {
 std::string normalize(std::string s);
@@ -14,6 +17,9 @@ std::string quoted(const std::string& s);
 std::string wtoa(const std::wstring& wide);
 std::string quoted(const char* s);
 
+static const char HEX_DIGITS_UPPER[] = "0123456789ABCDEF";
+static const char HEX_DIGITS_LOWER[] = "0123456789abcdef";
+
 template<typename T> struct bitwidth { static const size_t value = sizeof(T) * CHAR_BIT; };
 
 template<typename T> inline std::string quoted(T t) { return REDasm::quoted(std::to_string(t)); }
@@ -43,45 +49,81 @@ template<typename T> std::string wtoa(T* ws, size_t len)
     return s;
 }
 
-template<typename T> std::string dec(T t)
-{
-    std::stringstream ss;
-    ss << t;
-    return ss.str();
-}
+template<typename T> std::string dec(T t) { return std::to_string(t); }
 
-template<typename T> std::string hex(T t, int bits = 0, bool withprefix = true)
+template<typename T> size_t hexstring(char* buffer, T t, int bits = 0, bool withprefix = true, bool uppercase = true) // 'buffer' holds HEX_BUFFER_SIZE chars, returns the length
 {
-    std::stringstream ss;
+    const char* digits = uppercase ? HEX_DIGITS_UPPER : HEX_DIGITS_LOWER;
+    char reversed[HEX_MAX_DIGITS];
+    char* p = buffer;
+    uint64_t value = static_cast<uint64_t>(t);
+    size_t n = 0, width = (bits > 0) ? std::min<size_t>(bits / 4, HEX_MAX_DIGITS) : 0;
 
     if(withprefix && (t > 9))
-        ss << "0x";
-
-    ss << std::uppercase << std::hex;
-
-    if(bits > 0)
-        ss << std::setfill('0') << std::setw(bits / 4);
+    {
+        *p++ = '0';
+        *p++ = 'x';
+    }
 
     if(std::is_signed<T>::value && t < 0)
-        ss << "-" << (~t) + 1;
-    else
-        ss << t;
+    {
+        *p++ = '-';
+        value = static_cast<uint64_t>(~t) + 1;
+    }
+
+    do
+    {
+        reversed[n++] = digits[value & 0xF];
+        value >>= 4;
+    }
+    while(value);
+
+    for(size_t i = n; i < width; i++)
+        *p++ = '0';
+
+    while(n)
+        *p++ = reversed[--n];
+
+    *p = '\0';
+    return p - buffer;
+}
 
-    return ss.str();
+template<typename T> void appendhex(std::string& s, T t, int bits = 0, bool withprefix = true) // Appends to a reusable buffer
+{
+    char buffer[HEX_BUFFER_SIZE];
+    s.append(buffer, REDasm::hexstring(buffer, t, bits, withprefix));
+}
+
+template<typename T> std::string hex(T t, int bits = 0, bool withprefix = true)
+{
+    char buffer[HEX_BUFFER_SIZE];
+    return std::string(buffer, REDasm::hexstring(buffer, t, bits, withprefix));
 }
 
 template<typename T> std::string symbol(const std::string& prefix, T t, const std::string& segmentname = std::string())
 {
-    std::stringstream ss;
-    ss << prefix;
+    char buffer[HEX_BUFFER_SIZE];
+    size_t len = REDasm::hexstring(buffer, t, 0, false, false);
+    std::string s;
 
     if(!segmentname.empty())
-        ss << "_" << REDasm::normalize(segmentname);
+    {
+        std::string normalized = REDasm::normalize(segmentname);
+        s.reserve(prefix.size() + normalized.size() + len + 2);
+        s += prefix;
+        s += '_';
+        s += normalized;
+    }
+    else
+    {
+        s.reserve(prefix.size() + len + 1);
+        s += prefix;
+    }
 
-    ss << "_" << std::hex << t;
-    return ss.str();
+    s += '_';
+    s.append(buffer, len);
+    return s;
 }
-
 }
 
 #endif // UTILS_H
@@ -0,0 +1,81 @@
+#include "vmil_cache.h"
+
+namespace REDasm {
+namespace VMIL {
+
+bool VMILFunction::range(address_t address, const VMILInstruction **first, size_t *count) const
+{
+    auto it = this->ranges.find(address);
+
+    if(it == this->ranges.end())
+        return false;
+
+    *first = this->instructions.data() + it->second.first;
+    *count = it->second.second;
+    return true;
+}
+
+VMILCache::VMILCache(Emulator *emulator, Listing *listing, ChangeJournal *journal): _emulator(emulator), _listing(listing), _journal(journal), _codeversion(journal->version())
+{
+    this->_subscription = journal->subscribe([this](const Change& change) {
+        if(!change.is(ChangeTypes::InstructionUpdated) && !change.is(ChangeTypes::FunctionBoundsChanged))
+            return;
+
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_codeversion = this->_journal->version();
+    });
+}
+
+VMILCache::~VMILCache()
+{
+    this->_journal->unsubscribe(this->_subscription);
+}
+
+VMILFunctionPtr VMILCache::function(address_t address)
+{
+    SymbolPtr symbol = this->_listing->getFunction(address);
+
+    if(!symbol)
+        return NULL;
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        auto it = this->_functions.find(symbol->address);
+
+        if((it != this->_functions.end()) && (it->second->version >= this->_codeversion))
+            return it->second;
+    }
+
+    VMILFunctionPtr vmilfunction = this->translate(symbol->address); // Don't hold the lock while translating
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_functions[symbol->address] = vmilfunction;
+    return vmilfunction;
+}
+
+void VMILCache::clear()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_functions.clear();
+}
+
+VMILFunctionPtr VMILCache::translate(address_t address)
+{
+    auto vmilfunction = std::make_shared<VMILFunction>();
+    vmilfunction->address = address;
+    vmilfunction->version = this->_journal->version();
+
+    VMILInstructionList vminstructions; // Per instruction scratch buffer
+
+    this->_listing->iterateFunction(address, [&](const InstructionPtr& instruction) {
+        this->_emulator->translate(instruction, vminstructions);
+
+        vmilfunction->ranges[instruction->address] = std::make_pair(vmilfunction->instructions.size(), vminstructions.size());
+        vmilfunction->instructions.insert(vmilfunction->instructions.end(), vminstructions.begin(), vminstructions.end());
+    });
+
+    return vmilfunction;
+}
+
+} // namespace VMIL
+} // namespace REDasm
@@ -0,0 +1,55 @@
+#ifndef VMIL_CACHE_H
+#define VMIL_CACHE_H
+
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include "../disassembler/types/listing.h"
+#include "vmil_emulator.h"
+
+namespace REDasm {
+namespace VMIL {
+
+struct VMILFunction
+{
+    typedef std::pair<size_t, size_t> Range; // First, count
+
+    VMILFunction(): address(0), version(0) { }
+    bool range(address_t address, const VMILInstruction** first, size_t* count) const;
+
+    address_t address;
+    u64 version;                                  // Listing's version at translation time
+    VMILInstructionList instructions;             // Whole function, contiguous
+    std::unordered_map<address_t, Range> ranges;  // Source instruction -> VMIL instructions
+};
+
+typedef std::shared_ptr<const VMILFunction> VMILFunctionPtr;
+
+class VMILCache // Translate once per function, until its code changes
+{
+    private:
+        typedef std::unordered_map<address_t, VMILFunctionPtr> Functions;
+
+    public:
+        VMILCache(Emulator* emulator, Listing* listing, ChangeJournal* journal);
+        ~VMILCache();
+        VMILFunctionPtr function(address_t address);
+        void clear();
+
+    private:
+        VMILFunctionPtr translate(address_t address);
+
+    private:
+        std::mutex _mutex;
+        Emulator* _emulator;
+        Listing* _listing;
+        ChangeJournal* _journal;
+        ChangeJournal::subscription_t _subscription;
+        u64 _codeversion; // Last version that touched code: renames and references don't invalidate translations
+        Functions _functions;
+};
+
+} // namespace VMIL
+} // namespace REDasm
+
+#endif // VMIL_CACHE_H
@@ -0,0 +1,794 @@
+#include "vmil_constprop.h"
+#include "../plugins/format.h"
+
+#define VMIL_VARIABLE_KEY(reg, temporary) ((static_cast<u64>(reg) << 1) | (temporary ? 1 : 0))
+#define VMIL_UNKNOWN_VALUE                0
+
+#define EVALUATE_MATH_OPCODE(a, b, mathop) { LatticeStates::Constant, a.value mathop b.value }
+
+namespace REDasm {
+namespace VMIL {
+
+ConstantPropagation::ConstantPropagation(DisassemblerAPI *disassembler, Listing &listing, Emulator *emulator): _disassembler(disassembler), _listing(listing), _emulator(emulator), _entry(0)
+{
+
+}
+
+bool ConstantPropagation::run(const VMILFunctionPtr &vmilfunction, ConstantList &constants)
+{
+    this->reset();
+
+    if(!vmilfunction || !this->buildBlocks(vmilfunction->address))
+        return false;
+
+    this->buildDominators();
+    this->insertPhis(vmilfunction);
+    this->rename(vmilfunction);
+    this->propagate();
+
+    for(const Query& query : this->_queries)
+    {
+        const Lattice& lattice = this->_values[query.value];
+
+        if(!this->_blocks[query.block].executable || (lattice.state != LatticeStates::Constant))
+            continue;
+
+        constants.push_back({ query.address, query.index, lattice.value + query.offset });
+    }
+
+    return true;
+}
+
+void ConstantPropagation::reset()
+{
+    this->_blocks.clear();
+    this->_rpo.clear();
+    this->_variables.clear();
+    this->_registers.clear();
+    this->_defblocks.clear();
+    this->_values.clear();
+    this->_uses.clear();
+    this->_statements.clear();
+    this->_phis.clear();
+    this->_queries.clear();
+    this->_cfgworklist.clear();
+    this->_ssaworklist.clear();
+
+    this->pushValue(LatticeStates::Bottom); // VMIL_UNKNOWN_VALUE: clobbered or undefined registers share it
+}
+
+bool ConstantPropagation::buildBlocks(address_t address)
+{
+    FunctionGraph graph(this->_listing);
+
+    if(!graph.buildBlocks(address) || !graph.rootVertex())
+        return false;
+
+    std::unordered_map<Graphing::vertex_id_t, size_t> blockids;
+    std::unordered_map<address_t, size_t> blockstarts;
+
+    for(auto it = graph.begin(); it != graph.end(); it++)
+    {
+        FunctionGraphVertex* v = static_cast<FunctionGraphVertex*>(*it);
+        blockids[v->id] = this->_blocks.size();
+        blockstarts[v->start] = this->_blocks.size();
+
+        Block block;
+        block.start = v->start;
+        block.end = v->end;
+        this->_blocks.push_back(block);
+    }
+
+    for(auto it = graph.begin(); it != graph.end(); it++)
+    {
+        size_t from = blockids[(*it)->id];
+
+        for(Graphing::vertex_id_t id : (*it)->edges)
+        {
+            size_t to = blockids[id];
+            this->_blocks[from].succs.push_back(to);
+            this->_blocks[to].preds.push_back(from);
+        }
+    }
+
+    this->_entry = this->_blocks.size();
+    this->_blocks.push_back(Block());
+
+    size_t root = blockids[graph.rootVertex()->id];
+    this->_blocks[this->_entry].succs.push_back(root);
+    this->_blocks[root].preds.push_back(this->_entry);
+
+    for(Block& block : this->_blocks)
+    {
+        block.executableedges.resize(block.preds.size(), false);
+
+        if(&block == &this->_blocks[this->_entry])
+            continue;
+
+        auto it = this->_listing.find(block.start);
+
+        for( ; (it != this->_listing.end()) && (it.key <= block.end); it++)
+            block.instructions.push_back(*it);
+
+        if(block.instructions.empty())
+            continue;
+
+        const InstructionPtr& instruction = block.instructions.back();
+
+        if(!instruction->is(InstructionTypes::Jump) || !instruction->is(InstructionTypes::Conditional))
+            continue;
+
+        auto bit = blockstarts.find(instruction->endAddress());
+
+        if(bit != blockstarts.end())
+            block.fallthrough = bit->second;
+
+        if(!instruction->hasTargets())
+            continue;
+
+        bit = blockstarts.find(instruction->target());
+
+        if(bit != blockstarts.end())
+            block.taken = bit->second;
+    }
+
+    // Reverse postorder, iterative: functions can be large
+    std::vector<bool> visited(this->_blocks.size(), false);
+    std::vector<std::pair<size_t, size_t> > stack; // Block, next successor
+    stack.emplace_back(this->_entry, 0);
+    visited[this->_entry] = true;
+
+    while(!stack.empty())
+    {
+        size_t b = stack.back().first, s = stack.back().second;
+
+        if(s < this->_blocks[b].succs.size())
+        {
+            stack.back().second++;
+            size_t succ = this->_blocks[b].succs[s];
+
+            if(visited[succ])
+                continue;
+
+            visited[succ] = true;
+            stack.emplace_back(succ, 0);
+            continue;
+        }
+
+        this->_rpo.push_back(b);
+        stack.pop_back();
+    }
+
+    std::reverse(this->_rpo.begin(), this->_rpo.end());
+    return true;
+}
+
+void ConstantPropagation::buildDominators() // Cooper, Harvey, Kennedy: "A Simple, Fast Dominance Algorithm"
+{
+    std::vector<size_t> order(this->_blocks.size(), 0);
+
+    for(size_t i = 0; i < this->_rpo.size(); i++)
+        order[this->_rpo[i]] = i;
+
+    this->_blocks[this->_entry].idom = this->_entry;
+    bool changed = true;
+
+    while(changed)
+    {
+        changed = false;
+
+        for(size_t i = 1; i < this->_rpo.size(); i++)
+        {
+            Block& block = this->_blocks[this->_rpo[i]];
+            s64 idom = -1;
+
+            for(size_t p : block.preds)
+            {
+                if(this->_blocks[p].idom < 0) // Unreachable or not processed yet
+                    continue;
+
+                if(idom < 0)
+                {
+                    idom = p;
+                    continue;
+                }
+
+                size_t a = p, b = idom;
+
+                while(a != b)
+                {
+                    while(order[a] > order[b])
+                        a = this->_blocks[a].idom;
+
+                    while(order[b] > order[a])
+                        b = this->_blocks[b].idom;
+                }
+
+                idom = a;
+            }
+
+            if(block.idom == idom)
+                continue;
+
+            block.idom = idom;
+            changed = true;
+        }
+    }
+
+    for(size_t i = 1; i < this->_rpo.size(); i++)
+        this->_blocks[this->_blocks[this->_rpo[i]].idom].children.push_back(this->_rpo[i]);
+}
+
+void ConstantPropagation::insertPhis(const VMILFunctionPtr &vmilfunction)
+{
+    std::vector<size_t> clobberblocks; // Calls clobber everything
+
+    for(size_t b : this->_rpo)
+    {
+        for(const InstructionPtr& instruction : this->_blocks[b].instructions)
+        {
+            const VMILInstruction* vminstructions = NULL;
+            size_t count = 0;
+            bool unknown = false;
+
+            if(vmilfunction->range(instruction->address, &vminstructions, &count))
+            {
+                for(size_t i = 0; i < count; i++)
+                {
+                    const VMILInstruction& vminstruction = vminstructions[i];
+
+                    for(u32 j = 0; j < vminstruction.count; j++)
+                    {
+                        const VMILOperand& vmop = vminstruction.op(j);
+
+                        if(vmop.is(OperandTypes::Register) && (vmop.reg != REGISTER_INVALID))
+                            this->variable(vmop.reg, vmop.isTemporary());
+                    }
+
+                    if(vminstruction.id == VMIL::Opcodes::Unkn)
+                        unknown = true;
+                    else if((vminstruction.id == VMIL::Opcodes::Undef) || this->definesDestination(vminstruction))
+                    {
+                        const VMILOperand& vmop = vminstruction.op(0);
+
+                        if(vmop.is(OperandTypes::Register) && (vmop.reg != REGISTER_INVALID))
+                            this->_defblocks[this->variable(vmop.reg, vmop.isTemporary())].insert(b);
+                    }
+                }
+            }
+
+            for(const Operand& operand : instruction->operands)
+            {
+                if(operand.is(OperandTypes::Register) && operand.reg.isValid())
+                {
+                    size_t var = this->variable(operand.reg.r, false);
+
+                    if(unknown && this->clobbers(instruction, operand))
+                        this->_defblocks[var].insert(b);
+                }
+                else if(operand.is(OperandTypes::Displacement) && operand.disp.base.isValid())
+                    this->variable(operand.disp.base.r, false);
+            }
+
+            if(instruction->is(InstructionTypes::Call))
+                clobberblocks.push_back(b);
+        }
+    }
+
+    // Dominance frontiers
+    std::vector<std::set<size_t> > frontiers(this->_blocks.size());
+
+    for(size_t b : this->_rpo)
+    {
+        const Block& block = this->_blocks[b];
+
+        if(block.preds.size() < 2)
+            continue;
+
+        for(size_t p : block.preds)
+        {
+            if(this->_blocks[p].idom < 0)
+                continue;
+
+            for(size_t runner = p; runner != static_cast<size_t>(block.idom); runner = this->_blocks[runner].idom)
+                frontiers[runner].insert(b);
+        }
+    }
+
+    for(size_t var = 0; var < this->_registers.size(); var++)
+    {
+        if(this->_registers[var] & 1) // Temporaries don't outlive their source instruction
+            continue;
+
+        std::set<size_t>& defblocks = this->_defblocks[var];
+        defblocks.insert(this->_entry);
+        defblocks.insert(clobberblocks.begin(), clobberblocks.end());
+
+        std::vector<size_t> worklist(defblocks.begin(), defblocks.end());
+        std::set<size_t> hasphi;
+
+        while(!worklist.empty())
+        {
+            size_t b = worklist.back();
+            worklist.pop_back();
+
+            for(size_t f : frontiers[b])
+            {
+                if(!hasphi.insert(f).second)
+                    continue;
+
+                Phi phi;
+                phi.block = f;
+                phi.variable = var;
+                phi.def = this->pushValue(LatticeStates::Top);
+                phi.args.resize(this->_blocks[f].preds.size(), -1);
+
+                this->_blocks[f].phis.push_back(this->_phis.size());
+                this->_phis.push_back(phi);
+
+                if(defblocks.find(f) == defblocks.end())
+                    worklist.push_back(f);
+            }
+        }
+    }
+}
+
+void ConstantPropagation::rename(const VMILFunctionPtr &vmilfunction)
+{
+    struct Frame { size_t block, child; std::vector<size_t> pushed; };
+
+    std::vector<std::vector<size_t> > stacks(this->_registers.size()); // Variable -> reaching SSA values
+    std::vector<Frame> frames;
+
+    frames.push_back({ this->_entry, 0, std::vector<size_t>() });
+    this->renameBlock(vmilfunction, this->_entry, stacks, frames.back().pushed);
+
+    while(!frames.empty()) // Preorder walk over the dominator tree
+    {
+        Frame& frame = frames.back();
+        const Block& block = this->_blocks[frame.block];
+
+        if(frame.child < block.children.size())
+        {
+            size_t child = block.children[frame.child++];
+            frames.push_back({ child, 0, std::vector<size_t>() });
+            this->renameBlock(vmilfunction, child, stacks, frames.back().pushed);
+            continue;
+        }
+
+        for(size_t var : frame.pushed)
+            stacks[var].pop_back();
+
+        frames.pop_back();
+    }
+}
+
+void ConstantPropagation::renameBlock(const VMILFunctionPtr &vmilfunction, size_t b, std::vector<std::vector<size_t> > &stacks, std::vector<size_t> &pushed)
+{
+    Block& block = this->_blocks[b];
+
+    auto push = [&](size_t var, size_t value) {
+        stacks[var].push_back(value);
+        pushed.push_back(var);
+    };
+
+    auto top = [&](size_t var) -> size_t {
+        return stacks[var].empty() ? VMIL_UNKNOWN_VALUE : stacks[var].back();
+    };
+
+    if(b == this->_entry)
+    {
+        for(size_t var = 0; var < this->_registers.size(); var++)
+        {
+            u64 value = 0;
+
+            if(!(this->_registers[var] & 1) && this->_emulator->entryValue(this->_registers[var] >> 1, &value))
+                push(var, this->pushValue(LatticeStates::Constant, value));
+            else
+                push(var, VMIL_UNKNOWN_VALUE);
+        }
+    }
+
+    for(size_t p : block.phis)
+        push(this->_phis[p].variable, this->_phis[p].def);
+
+    for(const InstructionPtr& instruction : block.instructions)
+    {
+        for(const Operand& operand : instruction->operands) // Base registers are read before the instruction executes
+        {
+            if(!operand.is(OperandTypes::Displacement) || !operand.disp.base.isValid() || operand.disp.index.isValid())
+                continue;
+
+            this->_queries.push_back({ b, instruction->address, operand.index, top(this->variable(operand.disp.base.r, false)), operand.disp.displacement });
+        }
+
+        for(const Operand& operand : instruction->operands) // ...like branch targets
+        {
+            if(!operand.is(OperandTypes::Register) || !operand.reg.isValid() || !instruction->is(InstructionTypes::Branch) || (operand.index != instruction->target_idx))
+                continue;
+
+            this->_queries.push_back({ b, instruction->address, operand.index, top(this->variable(operand.reg.r, false)), 0 });
+        }
+
+        const VMILInstruction* vminstructions = NULL;
+        size_t count = 0;
+
+        if(!vmilfunction->range(instruction->address, &vminstructions, &count))
+            count = 0;
+
+        for(size_t i = 0; i < count; i++)
+        {
+            const VMILInstruction& vminstruction = vminstructions[i];
+            bool defines = this->definesDestination(vminstruction) || (vminstruction.id == VMIL::Opcodes::Undef);
+            Statement statement = { &vminstruction, b, { -1, -1, -1 }, -1 };
+
+            for(u32 j = 0; j < vminstruction.count; j++)
+            {
+                const VMILOperand& vmop = vminstruction.op(j);
+
+                if(!vmop.is(OperandTypes::Register) || (vmop.reg == REGISTER_INVALID) || (!j && defines))
+                    continue;
+
+                statement.uses[j] = top(this->variable(vmop.reg, vmop.isTemporary()));
+            }
+
+            if(vminstruction.id == VMIL::Opcodes::Unkn)
+            {
+                for(const Operand& operand : instruction->operands)
+                {
+                    if(this->clobbers(instruction, operand))
+                        push(this->variable(operand.reg.r, false), VMIL_UNKNOWN_VALUE);
+                }
+            }
+            else if(defines && vminstruction.op(0).is(OperandTypes::Register) && (vminstruction.op(0).reg != REGISTER_INVALID))
+            {
+                const VMILOperand& vmop = vminstruction.op(0);
+
+                if(vminstruction.id == VMIL::Opcodes::Undef)
+                    push(this->variable(vmop.reg, vmop.isTemporary()), VMIL_UNKNOWN_VALUE);
+                else
+                    push(this->variable(vmop.reg, vmop.isTemporary()), statement.def = this->pushValue(LatticeStates::Top));
+            }
+
+            size_t s = this->_statements.size();
+
+            for(u32 j = 0; j < VMIL_MAX_OPERANDS; j++)
+            {
+                if(statement.uses[j] >= 0)
+                    this->_uses[statement.uses[j]].push_back({ false, s });
+            }
+
+            if((vminstruction.id == VMIL::Opcodes::Jcc) && (instruction == block.instructions.back()))
+                block.jcc = s;
+
+            block.statements.push_back(s);
+            this->_statements.push_back(statement);
+        }
+
+        if(instruction->is(InstructionTypes::Call))
+        {
+            for(size_t var = 0; var < this->_registers.size(); var++)
+            {
+                if(!(this->_registers[var] & 1))
+                    push(var, VMIL_UNKNOWN_VALUE);
+            }
+        }
+
+        for(const Operand& operand : instruction->operands) // Everything else: the value it holds after the instruction
+        {
+            if(!operand.is(OperandTypes::Register) || !operand.reg.isValid() || (instruction->is(InstructionTypes::Branch) && (operand.index == instruction->target_idx)))
+                continue;
+
+            this->_queries.push_back({ b, instruction->address, operand.index, top(this->variable(operand.reg.r, false)), 0 });
+        }
+    }
+
+    for(size_t succ : block.succs)
+    {
+        Block& succblock = this->_blocks[succ];
+        size_t predidx = std::distance(succblock.preds.begin(), std::find(succblock.preds.begin(), succblock.preds.end(), b));
+
+        for(size_t p : succblock.phis)
+        {
+            Phi& phi = this->_phis[p];
+            size_t value = top(phi.variable);
+
+            phi.args[predidx] = value;
+            this->_uses[value].push_back({ true, p });
+        }
+    }
+}
+
+void ConstantPropagation::propagate()
+{
+    this->_cfgworklist.emplace_back(-1, this->_entry);
+
+    while(!this->_cfgworklist.empty() || !this->_ssaworklist.empty())
+    {
+        while(!this->_cfgworklist.empty())
+        {
+            auto edge = this->_cfgworklist.front();
+            this->_cfgworklist.pop_front();
+            this->visitEdge(edge.first, edge.second);
+        }
+
+        while(!this->_ssaworklist.empty())
+        {
+            size_t value = this->_ssaworklist.front();
+            this->_ssaworklist.pop_front();
+
+            for(const Use& use : this->_uses[value])
+            {
+                if(use.phi)
+                {
+                    if(this->_blocks[this->_phis[use.index].block].executable)
+                        this->visitPhi(use.index);
+
+                    continue;
+                }
+
+                size_t b = this->_statements[use.index].block;
+
+                if(!this->_blocks[b].executable)
+                    continue;
+
+                this->visitStatement(use.index);
+
+                if(this->_blocks[b].jcc == static_cast<s64>(use.index))
+                    this->visitTerminator(b);
+            }
+        }
+    }
+}
+
+void ConstantPropagation::visitEdge(s64 from, size_t to)
+{
+    Block& block = this->_blocks[to];
+
+    if(from >= 0)
+    {
+        size_t predidx = std::distance(block.preds.begin(), std::find(block.preds.begin(), block.preds.end(), static_cast<size_t>(from)));
+
+        if(block.executableedges[predidx])
+            return;
+
+        block.executableedges[predidx] = true;
+    }
+
+    for(size_t p : block.phis)
+        this->visitPhi(p);
+
+    if(block.executable)
+        return;
+
+    block.executable = true;
+
+    for(size_t s : block.statements)
+        this->visitStatement(s);
+
+    this->visitTerminator(to);
+}
+
+void ConstantPropagation::visitPhi(size_t p)
+{
+    const Phi& phi = this->_phis[p];
+    const Block& block = this->_blocks[phi.block];
+    Lattice lattice = { LatticeStates::Top, 0 };
+
+    for(size_t i = 0; (i < phi.args.size()) && (lattice.state != LatticeStates::Bottom); i++)
+    {
+        if(!block.executableedges[i] || (phi.args[i] < 0))
+            continue;
+
+        const Lattice& arg = this->_values[phi.args[i]];
+
+        if((arg.state == LatticeStates::Top) || ((lattice.state == LatticeStates::Constant) && (arg.state == LatticeStates::Constant) && (arg.value == lattice.value)))
+            continue;
+
+        if(lattice.state == LatticeStates::Top)
+            lattice = arg;
+        else
+            lattice.state = LatticeStates::Bottom;
+    }
+
+    this->update(phi.def, lattice);
+}
+
+void ConstantPropagation::visitStatement(size_t s)
+{
+    const Statement& statement = this->_statements[s];
+
+    if(statement.def < 0)
+        return;
+
+    this->update(statement.def, this->evaluate(statement));
+}
+
+void ConstantPropagation::visitTerminator(size_t b)
+{
+    const Block& block = this->_blocks[b];
+    Lattice condition = { LatticeStates::Bottom, 0 };
+
+    if(block.jcc >= 0)
+        condition = this->operandValue(this->_statements[block.jcc], 0);
+
+    if(condition.state == LatticeStates::Top)
+        return;
+
+    s64 chosen = -1; // Both edges must be known and distinct: 'jcc $+2' lands on its own fallthrough
+
+    if((condition.state == LatticeStates::Constant) && (block.fallthrough >= 0) && (block.taken >= 0) && (block.taken != block.fallthrough))
+        chosen = condition.value ? block.taken : block.fallthrough;
+
+    for(size_t succ : block.succs)
+    {
+        if((chosen >= 0) && (static_cast<s64>(succ) != chosen)) // Pruned by a constant condition
+            continue;
+
+        this->_cfgworklist.emplace_back(b, succ);
+    }
+}
+
+void ConstantPropagation::update(size_t value, const Lattice &lattice)
+{
+    Lattice& current = this->_values[value];
+
+    if((current.state == LatticeStates::Bottom) || (lattice.state == LatticeStates::Top))
+        return;
+
+    if((current.state == lattice.state) && (current.value == lattice.value))
+        return;
+
+    current = lattice;
+    this->_ssaworklist.push_back(value);
+}
+
+size_t ConstantPropagation::variable(vmilregister_t reg, bool temporary)
+{
+    u64 key = VMIL_VARIABLE_KEY(reg, temporary);
+    auto it = this->_variables.find(key);
+
+    if(it != this->_variables.end())
+        return it->second;
+
+    size_t var = this->_registers.size();
+    this->_variables[key] = var;
+    this->_registers.push_back(key);
+    this->_defblocks.emplace_back();
+    return var;
+}
+
+size_t ConstantPropagation::pushValue(u32 state, u64 value)
+{
+    this->_values.push_back({ state, value });
+    this->_uses.emplace_back();
+    return this->_values.size() - 1;
+}
+
+ConstantPropagation::Lattice ConstantPropagation::operandValue(const Statement &statement, u32 opidx) const
+{
+    const VMILOperand& vmop = statement.vminstruction->op(opidx);
+
+    if(statement.uses[opidx] >= 0)
+        return this->_values[statement.uses[opidx]];
+
+    if(vmop.is(OperandTypes::Register) || vmop.is(OperandTypes::Displacement))
+        return { LatticeStates::Bottom, 0 };
+
+    return { LatticeStates::Constant, vmop.u_value }; // Same as Emulator::read()
+}
+
+ConstantPropagation::Lattice ConstantPropagation::evaluate(const Statement &statement) const
+{
+    const VMILInstruction& vminstruction = *statement.vminstruction;
+
+    switch(vminstruction.id)
+    {
+        case VMIL::Opcodes::Def:
+            return { LatticeStates::Constant, 0 };
+
+        case VMIL::Opcodes::Str:
+            return this->operandValue(statement, 1);
+
+        case VMIL::Opcodes::Bisz:
+        {
+            Lattice a = this->operandValue(statement, 1);
+
+            if(a.state != LatticeStates::Constant)
+                return a;
+
+            return { LatticeStates::Constant, a.value == 0 };
+        }
+
+        case VMIL::Opcodes::Ldm:
+        {
+            Lattice a = this->operandValue(statement, 1);
+
+            if(a.state != LatticeStates::Constant)
+                return a;
+
+            return this->readMemory(a.value, vminstruction.op(1).size);
+        }
+
+        default:
+            break;
+    }
+
+    Lattice a = this->operandValue(statement, 1), b = this->operandValue(statement, 2);
+
+    if((a.state == LatticeStates::Bottom) || (b.state == LatticeStates::Bottom))
+        return { LatticeStates::Bottom, 0 };
+
+    if((a.state == LatticeStates::Top) || (b.state == LatticeStates::Top))
+        return { LatticeStates::Top, 0 };
+
+    switch(vminstruction.id)
+    {
+        case VMIL::Opcodes::Add: return EVALUATE_MATH_OPCODE(a, b, +);
+        case VMIL::Opcodes::Sub: return EVALUATE_MATH_OPCODE(a, b, -);
+        case VMIL::Opcodes::Mul: return EVALUATE_MATH_OPCODE(a, b, *);
+        case VMIL::Opcodes::Lsh: return EVALUATE_MATH_OPCODE(a, b, <<);
+        case VMIL::Opcodes::Rsh: return EVALUATE_MATH_OPCODE(a, b, >>);
+        case VMIL::Opcodes::And: return EVALUATE_MATH_OPCODE(a, b, &);
+        case VMIL::Opcodes::Or:  return EVALUATE_MATH_OPCODE(a, b, |);
+        case VMIL::Opcodes::Xor: return EVALUATE_MATH_OPCODE(a, b, ^);
+
+        case VMIL::Opcodes::Div:
+        case VMIL::Opcodes::Mod:
+            if(!b.value) // Division by zero
+                break;
+
+            if(vminstruction.id == VMIL::Opcodes::Div)
+                return EVALUATE_MATH_OPCODE(a, b, /);
+
+            return EVALUATE_MATH_OPCODE(a, b, %);
+
+        default:
+            break;
+    }
+
+    return { LatticeStates::Bottom, 0 };
+}
+
+ConstantPropagation::Lattice ConstantPropagation::readMemory(address_t address, u64 size) const
+{
+    Segment* segment = this->_disassembler->format()->segment(address);
+    u64 value = 0;
+
+    if(!size || !segment || segment->is(SegmentTypes::Write)) // Writable memory isn't constant
+        return { LatticeStates::Bottom, 0 };
+
+    if(!this->_disassembler->readAddress(address, size, &value))
+        return { LatticeStates::Bottom, 0 };
+
+    return { LatticeStates::Constant, value };
+}
+
+bool ConstantPropagation::definesDestination(const VMILInstruction &vminstruction) const
+{
+    switch(vminstruction.id)
+    {
+        case VMIL::Opcodes::Stm:
+        case VMIL::Opcodes::Jcc:
+        case VMIL::Opcodes::Undef:
+        case VMIL::Opcodes::Nop:
+        case VMIL::Opcodes::Unkn:
+            return false;
+
+        default:
+            break;
+    }
+
+    return vminstruction.op(0).is(OperandTypes::Register);
+}
+
+bool ConstantPropagation::clobbers(const InstructionPtr &instruction, const Operand &operand) const
+{
+    if(!operand.is(OperandTypes::Register) || !operand.reg.isValid() || instruction->is(InstructionTypes::Branch))
+        return false;
+
+    return operand.isWrite() || (!operand.index && !operand.isRead()); // Untranslated instructions: assume they write their first operand
+}
+
+} // namespace VMIL
+} // namespace REDasm
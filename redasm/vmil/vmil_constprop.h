@@ -0,0 +1,87 @@
+#ifndef VMIL_CONSTPROP_H
+#define VMIL_CONSTPROP_H
+
+#include <deque>
+#include "../disassembler/graph/functiongraph.h"
+#include "vmil_cache.h"
+
+namespace REDasm {
+namespace VMIL {
+
+namespace LatticeStates {
+    enum: u32 { Top = 0, Constant, Bottom };
+}
+
+class ConstantPropagation // Sparse conditional constant propagation over the function's SSA form
+{
+    public:
+        struct Constant { address_t address; s32 index; u64 value; }; // Source instruction, operand index, value (displacements: effective address)
+        typedef std::vector<Constant> ConstantList;
+
+    private:
+        struct Lattice { u32 state; u64 value; };
+        struct Use { bool phi; size_t index; };
+        struct Statement { const VMILInstruction* vminstruction; size_t block; s64 uses[VMIL_MAX_OPERANDS]; s64 def; };
+        struct Phi { size_t block, variable, def; std::vector<s64> args; }; // One argument per predecessor
+        struct Query { size_t block; address_t address; s32 index; size_t value; s64 offset; };
+
+        struct Block
+        {
+            Block(): start(0), end(0), idom(-1), fallthrough(-1), taken(-1), jcc(-1), executable(false) { }
+
+            address_t start, end;              // 'end' is the last instruction's address
+            std::list<InstructionPtr> instructions;
+            std::vector<size_t> preds, succs, children, phis, statements;
+            std::vector<bool> executableedges; // Incoming, same order as 'preds'
+            s64 idom, fallthrough, taken, jcc; // Conditional jumps only: not taken/taken successors and condition's statement
+            bool executable;
+        };
+
+    public:
+        ConstantPropagation(DisassemblerAPI* disassembler, Listing& listing, Emulator* emulator);
+        bool run(const VMILFunctionPtr& vmilfunction, ConstantList& constants);
+
+    private:
+        void reset();
+        bool buildBlocks(address_t address);
+        void buildDominators();
+        void insertPhis(const VMILFunctionPtr& vmilfunction);
+        void rename(const VMILFunctionPtr& vmilfunction);
+        void renameBlock(const VMILFunctionPtr& vmilfunction, size_t b, std::vector<std::vector<size_t> >& stacks, std::vector<size_t>& pushed);
+        void propagate();
+        void visitEdge(s64 from, size_t to);
+        void visitPhi(size_t p);
+        void visitStatement(size_t s);
+        void visitTerminator(size_t b);
+        void update(size_t value, const Lattice& lattice);
+        size_t variable(vmilregister_t reg, bool temporary);
+        size_t pushValue(u32 state, u64 value = 0);
+        Lattice operandValue(const Statement& statement, u32 opidx) const;
+        Lattice evaluate(const Statement& statement) const;
+        Lattice readMemory(address_t address, u64 size) const;
+        bool definesDestination(const VMILInstruction& vminstruction) const;
+        bool clobbers(const InstructionPtr& instruction, const Operand& operand) const;
+
+    private:
+        DisassemblerAPI* _disassembler;
+        Listing& _listing;
+        Emulator* _emulator;
+        size_t _entry;                                   // Virtual block: defines every register's entry value
+        std::vector<Block> _blocks;
+        std::vector<size_t> _rpo;                        // Reachable blocks, reverse postorder
+        std::unordered_map<u64, size_t> _variables;      // Register (temporaries tagged) -> variable
+        std::vector<u64> _registers;                     // Variable -> register (temporaries tagged)
+        std::vector<std::set<size_t> > _defblocks;       // Variable -> defining blocks
+        std::vector<Lattice> _values;                    // SSA values, #0 is the shared 'unknown' value
+        std::vector<std::vector<Use> > _uses;            // SSA value -> users
+        std::vector<Statement> _statements;
+        std::vector<Phi> _phis;
+        std::vector<Query> _queries;
+        std::deque<std::pair<s64, size_t> > _cfgworklist;
+        std::deque<size_t> _ssaworklist;
+};
+
+} // namespace VMIL
+} // namespace REDasm
+
+#endif // VMIL_CONSTPROP_H
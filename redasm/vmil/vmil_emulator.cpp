@@ -1,41 +1,30 @@
 #include "vmil_emulator.h"
 
-#define SET_EXECUTE_OPCODE(op) _opmap[VMIL::Opcodes::op] = [this](const InstructionPtr& instruction) { emulate##op(instruction); }
-#define SET_NULL_OPCODE(op)    _opmap[VMIL::Opcodes::op] = NULL;
+#define EXECUTE_OPCODE(op) &Emulator::emulate##op
 
 #define EXECUTE_MATH_OPCODE(instruction, mathop) if(!this->canExecute(instruction)) return; \
-                                                 u64 res = this->read(instruction->operands[1]) mathop \
-                                                           this->read(instruction->operands[2]); \
-                                                 this->write(instruction->operands[0], res)
+                                                 u64 res = this->read(instruction.operands[1]) mathop \
+                                                           this->read(instruction.operands[2]); \
+                                                 this->write(instruction.operands[0], res)
 
-#define DATA_TRANSFER(instruction, from, to) this->write(instruction->operands[to], this->read(instruction->operands[from]))
-#define SET_CONDITION(instruction, from, to) this->write(instruction->operands[to], (this->read(instruction->operands[from]) == 0));
+#define DATA_TRANSFER(instruction, from, to) this->write(instruction.operands[to], this->read(instruction.operands[from]))
+#define SET_CONDITION(instruction, from, to) this->write(instruction.operands[to], (this->read(instruction.operands[from]) == 0));
 
 namespace REDasm {
 namespace VMIL {
 
-Emulator::Emulator(DisassemblerAPI *disassembler): _defregister(VMIL_REGISTER_ID(0)), _disassembler(disassembler)
-{
-    SET_EXECUTE_OPCODE(Add);
-    SET_EXECUTE_OPCODE(Sub);
-    SET_EXECUTE_OPCODE(Mul);
-    SET_EXECUTE_OPCODE(Div);
-    SET_EXECUTE_OPCODE(Mod);
-    SET_EXECUTE_OPCODE(Lsh);
-    SET_EXECUTE_OPCODE(Rsh);
-    SET_EXECUTE_OPCODE(And);
-    SET_EXECUTE_OPCODE(Or);
-    SET_EXECUTE_OPCODE(Xor);
-    SET_EXECUTE_OPCODE(Str);
-    SET_EXECUTE_OPCODE(Ldm);
-    SET_EXECUTE_OPCODE(Stm);
-    SET_EXECUTE_OPCODE(Bisz);
-    SET_EXECUTE_OPCODE(Jcc);
-    SET_EXECUTE_OPCODE(Def);
-    SET_EXECUTE_OPCODE(Undef);
-
-    SET_NULL_OPCODE(Nop);
-    SET_NULL_OPCODE(Unkn);
+const Emulator::OpCallback Emulator::_optable[VMIL::Opcodes::Unkn + 1] = { // Same order as VMIL::Opcodes
+    EXECUTE_OPCODE(Add), EXECUTE_OPCODE(Sub), EXECUTE_OPCODE(Mul), EXECUTE_OPCODE(Div), EXECUTE_OPCODE(Mod), EXECUTE_OPCODE(Lsh), EXECUTE_OPCODE(Rsh),
+    EXECUTE_OPCODE(And), EXECUTE_OPCODE(Or), EXECUTE_OPCODE(Xor),
+    EXECUTE_OPCODE(Str), EXECUTE_OPCODE(Ldm), EXECUTE_OPCODE(Stm),
+    EXECUTE_OPCODE(Bisz), EXECUTE_OPCODE(Jcc),
+    EXECUTE_OPCODE(Def), EXECUTE_OPCODE(Undef),
+    NULL, NULL // Nop, Unkn
+};
+
+Emulator::Emulator(DisassemblerAPI *disassembler, size_t registers): _defregister(VMIL_REGISTER_ID(0)), _disassembler(disassembler), _tempregisters(VMIL_MAX_TEMPORARIES), _registers(registers)
+{
+
 }
 
 Emulator::~Emulator()
@@ -60,7 +49,7 @@ bool Emulator::read(const Operand &operand, u64 &value)
         if(!this->isRegisterValid(operand.reg))
             return false;
 
-        value = this->read(operand);
+        value = (operand.reg.extra_type == VMIL_REG_OPERAND) ? this->readT(operand.reg.r) : this->read(operand.reg.r);
         return true;
     }
 
@@ -72,38 +61,42 @@ bool Emulator::read(const Operand &operand, u64 &value)
 bool Emulator::translate(const InstructionPtr &instruction, VMILInstructionList &vminstructions)
 {
     instruction_id_t id = this->getInstructionId(instruction);
-    VMIL::VMILInstructionPtr vminstruction;
+    VMIL::VMILInstructionPtr vminstruction = NULL;
+    vminstructions.clear(); // VMIL addresses are relative to the list's start
 
-    auto it = this->_translatemap.find(id);
-
-    if(it != this->_translatemap.end())
-        it->second(instruction, vminstruction, vminstructions);
+    if((id < this->_translatetable.size()) && this->_translatetable[id])
+        (this->*this->_translatetable[id])(instruction, vminstruction, vminstructions);
 
     if(!vminstructions.empty())
         return true;
 
-    vminstructions.push_back(VMIL::emitUnkn(instruction));
+    VMIL::emitUnkn(instruction, vminstructions);
     return false;
 }
 
 bool Emulator::emulate(const InstructionPtr &instruction)
 {
-    VMILInstructionList vminstructions;
-    bool ok = this->translate(instruction, vminstructions);
+    bool ok = this->translate(instruction, this->_vminstructions);
+    this->execute(this->_vminstructions.data(), this->_vminstructions.size());
+    return ok;
+}
 
-    std::for_each(vminstructions.begin(), vminstructions.end(), [this](const VMILInstructionPtr& vminstruction) {
-        auto it = this->_opmap.find(vminstruction->id);
+void Emulator::execute(const VMILInstruction *vminstructions, size_t count)
+{
+    for(size_t i = 0; i < count; i++)
+    {
+        const VMILInstruction& vminstruction = vminstructions[i];
 
-        if(it == this->_opmap.end()) {
-            REDasm::log("VMIL: Cannot emulate '" + vminstruction->mnemonic + "' instruction");
-            return;
+        if(vminstruction.id > VMIL::Opcodes::Unkn) {
+            REDasm::log("VMIL: Cannot emulate opcode #" + std::to_string(vminstruction.id));
+            continue;
         }
 
-        if(it->second)
-            it->second(vminstruction);
-    });
+        OpCallback cb = Emulator::_optable[vminstruction.id];
 
-    return ok;
+        if(cb)
+            (this->*cb)(vminstruction);
+    }
 }
 
 void Emulator::reset()
@@ -113,6 +106,13 @@ void Emulator::reset()
     this->_memory.clear();
 }
 
+bool Emulator::entryValue(vmilregister_t reg, u64 *value) const
+{
+    RE_UNUSED(reg);
+    RE_UNUSED(value);
+    return false; // Registers are unknown on function entry
+}
+
 instruction_id_t Emulator::getInstructionId(const InstructionPtr &instruction) const
 {
     return instruction->id;
@@ -122,20 +122,18 @@ void Emulator::emitDisplacement(const InstructionPtr &instruction, u32 opidx, VM
 {
     Operand opmem = instruction->op(opidx);
 
-    VMILInstructionPtr vminstruction = VMIL::emitStr(instruction);
+    VMILInstructionPtr vminstruction = VMIL::emitStr(instruction, vminstructions);
     vminstruction->reg(VMIL_DEFAULT_REGISTER);
     vminstruction->reg(opmem.disp.base.r, opmem.type);
-    vminstructions.push_back(vminstruction);
 
     if(opmem.disp.displacement)
     {
         vminstruction = VMIL::emitInstruction(instruction, (opmem.disp.displacement > 0) ? VMIL::Opcodes::Add :
-                                                                                          VMIL::Opcodes::Sub, VMIL_INSTRUCTION_I(vminstructions));
+                                                                                          VMIL::Opcodes::Sub, vminstructions);
 
         vminstruction->reg(VMIL_DEFAULT_REGISTER);
         vminstruction->reg(VMIL_DEFAULT_REGISTER);
         vminstruction->imm(opmem.disp.displacement);
-        vminstructions.push_back(vminstruction);
     }
 }
 
@@ -143,50 +141,41 @@ void Emulator::emitEQ(const InstructionPtr& instruction, u32 opidx1, u32 opidx2,
 {
     VMILInstructionPtr vminstruction;
 
-    vminstruction = VMIL::emitXor(instruction);
+    vminstruction = VMIL::emitXor(instruction, vminstructions);
     vminstruction->reg(VMIL_DEFAULT_REGISTER);
     vminstruction->op(instruction->op(opidx1));
     vminstruction->op(instruction->op(opidx2));
-    vminstructions.push_back(vminstruction);
 
-    vminstruction = VMIL::emitBisz(instruction);
-    vminstruction->address = VMIL_INSTRUCTION_ADDRESS_I(instruction, 1);
+    vminstruction = VMIL::emitBisz(instruction, vminstructions);
     vminstruction->reg(VMIL_DEFAULT_REGISTER);
     vminstruction->reg(VMIL_DEFAULT_REGISTER);
-    vminstructions.push_back(vminstruction);
 }
 
 void Emulator::emitNEQ(const InstructionPtr &instruction, u32 opidx1, u32 opidx2, VMIL::VMILInstructionList &vminstructions) const
 {
     VMILInstructionPtr vminstruction;
 
-    vminstruction = VMIL::emitXor(instruction);
+    vminstruction = VMIL::emitXor(instruction, vminstructions);
     vminstruction->reg(VMIL_DEFAULT_REGISTER);
     vminstruction->op(instruction->op(opidx1));
     vminstruction->op(instruction->op(opidx2));
-    vminstructions.push_back(vminstruction);
 }
 
 void Emulator::invalidateRegister(register_t reg)
 {
-    auto it = this->_registers.find(reg);
-
-    if(it == this->_registers.end())
-        return;
-
-    this->_registers.erase(it);
+    this->_registers.invalidate(reg);
 }
 
-bool Emulator::canExecute(const VMILInstructionPtr &instruction)
+bool Emulator::canExecute(const VMILInstruction &instruction)
 {
-    for(auto it = instruction->operands.begin(); it != instruction->operands.end(); it++)
+    for(u32 i = 0; i < instruction.count; i++)
     {
-        const Operand& op = *it;
+        const VMILOperand& op = instruction.operands[i];
 
-        if(!op.is(OperandTypes::Register) || this->isWriteDestination(instruction, op))
+        if(!op.is(OperandTypes::Register) || this->isWriteDestination(instruction, i))
             continue;
 
-        if(!this->isRegisterValid(op.reg))
+        if(!this->isRegisterValid(op))
             return false;
     }
 
@@ -196,17 +185,25 @@ bool Emulator::canExecute(const VMILInstructionPtr &instruction)
 bool Emulator::isRegisterValid(const RegisterOperand &regop)
 {
     if(regop.extra_type == VMIL_REG_OPERAND)
-        return this->_tempregisters.find(regop.r) != this->_tempregisters.end();
+        return this->_tempregisters.isValid(regop.r);
+
+    return this->_registers.isValid(regop.r);
+}
+
+bool Emulator::isRegisterValid(const VMILOperand &operand)
+{
+    if(operand.isTemporary())
+        return this->_tempregisters.isValid(operand.reg);
 
-    return this->_registers.find(regop.r) != this->_registers.end();
+    return this->_registers.isValid(operand.reg);
 }
 
-bool Emulator::isWriteDestination(const VMILInstructionPtr& instruction, const Operand &operand) const
+bool Emulator::isWriteDestination(const VMILInstruction& instruction, u32 opidx) const
 {
-    if(operand.index > 0)
+    if(opidx > 0)
         return false;
 
-    switch(instruction->id)
+    switch(instruction.id)
     {
         case VMIL::Opcodes::Ldm:
         case VMIL::Opcodes::Stm:
@@ -224,51 +221,47 @@ bool Emulator::isWriteDestination(const VMILInstructionPtr& instruction, const O
     return true;
 }
 
-void Emulator::invalidateRegister(const RegisterOperand &regop)
+void Emulator::invalidateRegister(const VMILOperand &operand)
 {
-    if(regop.extra_type == VMIL_REG_OPERAND)
+    if(operand.isTemporary())
     {
-        auto it = this->_tempregisters.find(regop.r);
-
-        if(it == this->_tempregisters.end())
-            return;
-
-        this->_tempregisters.erase(it);
+        this->_tempregisters.invalidate(operand.reg);
         return;
     }
 
-    this->invalidateRegister(regop.r);
+    this->invalidateRegister(operand.reg);
 }
 
-void Emulator::invalidateRegisters(const VMILInstructionPtr &instruction)
+void Emulator::invalidateRegisters(const VMILInstruction &instruction)
 {
-    std::for_each(instruction->operands.begin(), instruction->operands.end(), [this](const Operand& operand) {
-        if(!operand.is(OperandTypes::Register))
-            return;
+    for(u32 i = 0; i < instruction.count; i++)
+    {
+        if(!instruction.operands[i].is(OperandTypes::Register))
+            continue;
 
-        this->invalidateRegister(operand.reg);
-    });
+        this->invalidateRegister(instruction.operands[i]);
+    }
 }
 
-void Emulator::write(const Operand &operand, u64 value)
+void Emulator::write(const VMILOperand &operand, u64 value)
 {
     if(!operand.is(OperandTypes::Register))
         return;
 
-    if(operand.reg.extra_type == VMIL_REG_OPERAND)
-        this->writeT(operand.reg.r, value);
+    if(operand.isTemporary())
+        this->writeT(operand.reg, value);
     else
-        this->write(operand.reg.r, value);
+        this->write(operand.reg, value);
 }
 
-u64 Emulator::read(const Operand &operand)
+u64 Emulator::read(const VMILOperand &operand)
 {
     if(operand.is(OperandTypes::Register))
     {
-        if(operand.reg.extra_type == VMIL_REG_OPERAND)
-            return this->readT(operand.reg.r);
+        if(operand.isTemporary())
+            return this->readT(operand.reg);
 
-        return this->read(operand.reg.r);
+        return this->read(operand.reg);
     }
 
     return operand.u_value;
@@ -276,27 +269,27 @@ u64 Emulator::read(const Operand &operand)
 
 void Emulator::writeT(vmilregister_t reg, u64 value)
 {
-    this->writeRegister(this->_tempregisters, reg, value);
+    this->_tempregisters.write(reg, value);
 }
 
 void Emulator::write(register_t reg, u64 value)
 {
-    this->writeRegister(this->_registers, reg, value);
+    this->_registers.write(reg, value);
 }
 
 u64 Emulator::readT(register_t reg)
 {
-    return this->readRegister(this->_tempregisters, reg);
+    return this->_tempregisters.read(reg);
 }
 
 u64 Emulator::read(register_t reg)
 {
-    return this->readRegister(this->_registers, reg);
+    return this->_registers.read(reg);
 }
 
-void Emulator::writeMemory(address_t address, u64 value)
+void Emulator::writeMemory(address_t address, u64 value, u64 size)
 {
-    this->_memory[address] = value;
+    this->_memory.write(address, value, size ? size : sizeof(u64)); // Unsized stores keep the whole value
 }
 
 u64 Emulator::readMemory(address_t address, u64 size, bool* ok)
@@ -308,54 +301,48 @@ u64 Emulator::readMemory(address_t address, u64 size, bool* ok)
         return 0;
     }
 
-    auto it = this->_memory.find(address);
+    u64 value = 0, memvalue = 0;
+    u8 fullmask = (size >= sizeof(u64)) ? 0xFF : ((1 << size) - 1);
+    u8 mask = this->_memory.read(address, size, &memvalue);
 
-    if(it != this->_memory.end())
+    if(mask == fullmask)
     {
         *ok = true;
-        return it->second;
+        return memvalue;
     }
 
-    u64 value = 0;
-    *ok = this->_disassembler->readAddress(address, size, &value);
-    return value;
-}
-
-void Emulator::writeRegister(Emulator::Registers &registers, register_t reg, u64 value)
-{
-    auto it = registers.find(reg);
+    *ok = this->_disassembler->readAddress(address, size, &value); // The bytes the emulator didn't write must be readable
 
-    if(it == registers.end())
-        registers[reg] = value;
-    else
-        it->second = value;
-}
+    if(!(*ok) || !mask)
+        return value;
 
-u64 Emulator::readRegister(Emulator::Registers &registers, register_t reg)
-{
-    auto it = registers.find(reg);
+    for(size_t i = 0; i < sizeof(u64); i++) // Bytes written by the emulator take precedence
+    {
+        if(!(mask & (1 << i)))
+            continue;
 
-    if(it == registers.end())
-        return 0;
+        value &= ~(0xFFull << (i * 8));
+        value |= memvalue & (0xFFull << (i * 8));
+    }
 
-    return it->second;
+    return value;
 }
 
-void Emulator::emulateAdd(const VMILInstructionPtr &instruction)  { EXECUTE_MATH_OPCODE(instruction, +);  }
-void Emulator::emulateSub(const VMILInstructionPtr &instruction)  { EXECUTE_MATH_OPCODE(instruction, -);  }
-void Emulator::emulateMul(const VMILInstructionPtr &instruction)  { EXECUTE_MATH_OPCODE(instruction, *);  }
-void Emulator::emulateMod(const VMILInstructionPtr &instruction)  { EXECUTE_MATH_OPCODE(instruction, %);  }
-void Emulator::emulateLsh(const VMILInstructionPtr &instruction)  { EXECUTE_MATH_OPCODE(instruction, <<); }
-void Emulator::emulateRsh(const VMILInstructionPtr &instruction)  { EXECUTE_MATH_OPCODE(instruction, >>); }
-void Emulator::emulateAnd(const VMILInstructionPtr &instruction)  { EXECUTE_MATH_OPCODE(instruction, &);  }
-void Emulator::emulateOr(const VMILInstructionPtr &instruction)   { EXECUTE_MATH_OPCODE(instruction, |);  }
-void Emulator::emulateXor(const VMILInstructionPtr &instruction)  { EXECUTE_MATH_OPCODE(instruction, ^);  }
-void Emulator::emulateBisz(const VMILInstructionPtr &instruction) { SET_CONDITION(instruction, 1, 0); }
-void Emulator::emulateStr(const VMILInstructionPtr &instruction)  { DATA_TRANSFER(instruction, 1, 0); }
+void Emulator::emulateAdd(const VMILInstruction &instruction)  { EXECUTE_MATH_OPCODE(instruction, +);  }
+void Emulator::emulateSub(const VMILInstruction &instruction)  { EXECUTE_MATH_OPCODE(instruction, -);  }
+void Emulator::emulateMul(const VMILInstruction &instruction)  { EXECUTE_MATH_OPCODE(instruction, *);  }
+void Emulator::emulateMod(const VMILInstruction &instruction)  { EXECUTE_MATH_OPCODE(instruction, %);  }
+void Emulator::emulateLsh(const VMILInstruction &instruction)  { EXECUTE_MATH_OPCODE(instruction, <<); }
+void Emulator::emulateRsh(const VMILInstruction &instruction)  { EXECUTE_MATH_OPCODE(instruction, >>); }
+void Emulator::emulateAnd(const VMILInstruction &instruction)  { EXECUTE_MATH_OPCODE(instruction, &);  }
+void Emulator::emulateOr(const VMILInstruction &instruction)   { EXECUTE_MATH_OPCODE(instruction, |);  }
+void Emulator::emulateXor(const VMILInstruction &instruction)  { EXECUTE_MATH_OPCODE(instruction, ^);  }
+void Emulator::emulateBisz(const VMILInstruction &instruction) { SET_CONDITION(instruction, 1, 0); }
+void Emulator::emulateStr(const VMILInstruction &instruction)  { DATA_TRANSFER(instruction, 1, 0); }
 
-void Emulator::emulateDiv(const VMILInstructionPtr &instruction)
+void Emulator::emulateDiv(const VMILInstruction &instruction)
 {
-    u64 value = this->read(instruction->op(2));
+    u64 value = this->read(instruction.op(2));
 
     if(!value) // Don't execute division by zero
     {
@@ -366,55 +353,47 @@ void Emulator::emulateDiv(const VMILInstructionPtr &instruction)
     EXECUTE_MATH_OPCODE(instruction, /);
 }
 
-void Emulator::emulateLdm(const VMILInstructionPtr &instruction)
+void Emulator::emulateLdm(const VMILInstruction &instruction)
 {
     if(!this->canExecute(instruction))
         return;
 
     bool ok = false;
-    Operand& srcop = instruction->op(1);
+    const VMILOperand& srcop = instruction.op(1);
     address_t address = this->read(srcop);
     u64 value = this->readMemory(address, srcop.size, &ok);
 
     if(ok)
-        this->write(instruction->op(0), value);
+        this->write(instruction.op(0), value);
 }
 
-void Emulator::emulateStm(const VMILInstructionPtr &instruction)
+void Emulator::emulateStm(const VMILInstruction &instruction)
 {
     if(!this->canExecute(instruction))
         return;
 
-    address_t address = this->read(instruction->op(0));
-    this->writeMemory(address, this->read(instruction->op(1)));
+    address_t address = this->read(instruction.op(0));
+    this->writeMemory(address, this->read(instruction.op(1)), instruction.op(1).size);
 }
 
-void Emulator::emulateJcc(const VMILInstructionPtr &instruction)
+void Emulator::emulateJcc(const VMILInstruction &instruction)
 {
-    u64 cond = this->read(instruction->operands[0]);
-    REDasm::log("VMIL: Jump @ " + REDasm::hex(instruction->address) + " condition to " +
-                                  REDasm::hex(this->read(instruction->operands[1])) + " = " + (cond ? "TRUE" : "FALSE"));
+    RE_UNUSED(instruction); // Straight line: conditions stay in their registers, branches are resolved by the caller
 }
 
-void Emulator::emulateDef(const VMILInstructionPtr &instruction)
+void Emulator::emulateDef(const VMILInstruction &instruction)
 {
-    register_t r = instruction->op(0).reg.r;
-    auto it = this->_registers.find(r);
-
-    if(it != this->_registers.end())
-        it->second = 0;
-    else
-        this->_registers[r] = 0;
+    this->_registers.write(instruction.op(0).reg, 0);
 }
 
-void Emulator::emulateUndef(const VMILInstructionPtr &instruction)
+void Emulator::emulateUndef(const VMILInstruction &instruction)
 {
-    Operand& op = instruction->op(0);
+    const VMILOperand& op = instruction.op(0);
 
     if(!op.is(OperandTypes::Register))
         return;
 
-    this->invalidateRegister(op.reg);
+    this->invalidateRegister(op);
 }
 
 } // namespace VMIL
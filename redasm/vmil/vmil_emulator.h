@@ -1,16 +1,16 @@
 #ifndef VMIL_EMULATOR_H
 #define VMIL_EMULATOR_H
 
-#include <unordered_map>
+#include <type_traits>
 #include "../disassembler/disassemblerapi.h"
 #include "../redasm.h"
 #include "vmil_instructions.h"
+#include "vmil_registerfile.h"
+#include "vmil_memory.h"
 
-#define VMIL_TRANSLATE_CALLBACK(id) [this](const InstructionPtr& instruction, VMIL::VMILInstructionPtr& vminstruction, VMIL::VMILInstructionList& vminstructions) { \
-                                            translate##id(instruction, vminstruction, vminstructions); \
-                                        }
+#define VMIL_MAX_TEMPORARIES 16
 
-#define VMIL_TRANSLATE_OPCODE(key, id) _translatemap[key] = VMIL_TRANSLATE_CALLBACK(id)
+#define VMIL_TRANSLATE_OPCODE(key, id) this->setTranslate(key, &std::remove_pointer<decltype(this)>::type::translate##id)
 
 namespace REDasm {
 namespace VMIL {
@@ -18,28 +18,27 @@ namespace VMIL {
 class Emulator
 {
     private:
-        typedef std::function<void(const InstructionPtr&)> OpCallback;
-        typedef std::function<void(VMILInstructionPtr&, vmilregister_t)> CondCallback;
-        typedef std::unordered_map<instruction_id_t, OpCallback> OpMap;
-        typedef std::unordered_map<register_t, u64> Registers;
-        typedef std::unordered_map<address_t, u64> Memory;
+        typedef void (Emulator::*OpCallback)(const VMILInstruction&);
 
     protected:
-        typedef std::function<void(const InstructionPtr&, VMIL::VMILInstructionPtr&, VMILInstructionList& vminstructions)> TranslateCallback;
-        typedef std::unordered_map<instruction_id_t, TranslateCallback> TranslateMap;
+        typedef void (Emulator::*TranslateCallback)(const InstructionPtr&, VMIL::VMILInstructionPtr&, VMILInstructionList& vminstructions) const;
+        typedef std::vector<TranslateCallback> TranslateTable; // Indexed by instruction id
 
     public:
-        Emulator(DisassemblerAPI* disassembler);
+        Emulator(DisassemblerAPI* disassembler, size_t registers);
         virtual ~Emulator();
         void setDefaultRegister(vmilregister_t reg);
         vmilregister_t defaultRegister() const;
         bool read(const Operand &operand, u64& value);
         bool translate(const InstructionPtr& instruction, VMILInstructionList& vminstructions);
         virtual bool emulate(const InstructionPtr &instruction);
+        void execute(const VMILInstruction* vminstructions, size_t count);
         virtual void reset();
+        virtual bool entryValue(vmilregister_t reg, u64* value) const;
 
     protected:
         virtual instruction_id_t getInstructionId(const InstructionPtr& instruction) const;
+        template<typename T> void setTranslate(instruction_id_t id, void (T::*cb)(const InstructionPtr&, VMIL::VMILInstructionPtr&, VMILInstructionList&) const);
         void emitDisplacement(const InstructionPtr& instruction, u32 opidx, VMILInstructionList& vminstructions) const;
         void emitEQ(const InstructionPtr &instruction, u32 opidx1, u32 opidx2, VMILInstructionList& vminstructions) const;
         void emitNEQ(const InstructionPtr &instruction, u32 opidx1, u32 opidx2, VMILInstructionList& vminstructions) const;
@@ -49,52 +48,58 @@ class Emulator
         void write(register_t reg, u64 value);
 
     private:
-        bool canExecute(const VMILInstructionPtr& instruction);
+        bool canExecute(const VMILInstruction& instruction);
         bool isRegisterValid(const RegisterOperand &regop);
-        bool isWriteDestination(const VMILInstructionPtr &instruction, const Operand& operand) const;
-        void invalidateRegister(const RegisterOperand& regop);
-        void invalidateRegisters(const VMILInstructionPtr &instruction);
-        void write(const Operand& operand, u64 value);
+        bool isRegisterValid(const VMILOperand& operand);
+        bool isWriteDestination(const VMILInstruction &instruction, u32 opidx) const;
+        void invalidateRegister(const VMILOperand& operand);
+        void invalidateRegisters(const VMILInstruction &instruction);
+        void write(const VMILOperand& operand, u64 value);
         void writeT(vmilregister_t reg, u64 value);
-        void writeMemory(address_t address, u64 value);
-        void writeRegister(Registers& registers, register_t reg, u64 value);
-        u64 read(const Operand& operand);
+        void writeMemory(address_t address, u64 value, u64 size);
+        u64 read(const VMILOperand& operand);
         u64 read(register_t reg);
         u64 readT(register_t reg);
         u64 readMemory(address_t address, u64 size, bool *ok);
-        u64 readRegister(Registers& registers, register_t reg);
 
     private:
-        void emulateAdd(const VMILInstructionPtr& instruction);
-        void emulateSub(const VMILInstructionPtr& instruction);
-        void emulateMul(const VMILInstructionPtr& instruction);
-        void emulateDiv(const VMILInstructionPtr& instruction);
-        void emulateMod(const VMILInstructionPtr& instruction);
-        void emulateLsh(const VMILInstructionPtr& instruction);
-        void emulateRsh(const VMILInstructionPtr& instruction);
-        void emulateAnd(const VMILInstructionPtr& instruction);
-        void emulateOr(const VMILInstructionPtr& instruction);
-        void emulateXor(const VMILInstructionPtr& instruction);
-        void emulateStr(const VMILInstructionPtr& instruction);
-        void emulateLdm(const VMILInstructionPtr& instruction);
-        void emulateStm(const VMILInstructionPtr& instruction);
-        void emulateBisz(const VMILInstructionPtr& instruction);
-        void emulateJcc(const VMILInstructionPtr& instruction);
-        void emulateDef(const VMILInstructionPtr& instruction);
-        void emulateUndef(const VMILInstructionPtr& instruction);
-
-    protected:
-        TranslateMap _translatemap;
+        void emulateAdd(const VMILInstruction& instruction);
+        void emulateSub(const VMILInstruction& instruction);
+        void emulateMul(const VMILInstruction& instruction);
+        void emulateDiv(const VMILInstruction& instruction);
+        void emulateMod(const VMILInstruction& instruction);
+        void emulateLsh(const VMILInstruction& instruction);
+        void emulateRsh(const VMILInstruction& instruction);
+        void emulateAnd(const VMILInstruction& instruction);
+        void emulateOr(const VMILInstruction& instruction);
+        void emulateXor(const VMILInstruction& instruction);
+        void emulateStr(const VMILInstruction& instruction);
+        void emulateLdm(const VMILInstruction& instruction);
+        void emulateStm(const VMILInstruction& instruction);
+        void emulateBisz(const VMILInstruction& instruction);
+        void emulateJcc(const VMILInstruction& instruction);
+        void emulateDef(const VMILInstruction& instruction);
+        void emulateUndef(const VMILInstruction& instruction);
 
     private:
+        static const OpCallback _optable[VMIL::Opcodes::Unkn + 1];
+        TranslateTable _translatetable;
         vmilregister_t _defregister;
         DisassemblerAPI* _disassembler;
-        OpMap _opmap;
-        Registers _tempregisters;
-        Registers _registers;
+        VMILInstructionList _vminstructions; // Reused by emulate()
+        RegisterFile _tempregisters;
+        RegisterFile _registers;
         Memory _memory;
 };
 
+template<typename T> void Emulator::setTranslate(instruction_id_t id, void (T::*cb)(const InstructionPtr&, VMIL::VMILInstructionPtr&, VMILInstructionList&) const)
+{
+    if(id >= this->_translatetable.size())
+        this->_translatetable.resize(id + 1, NULL);
+
+    this->_translatetable[id] = static_cast<TranslateCallback>(cb); // T derives from Emulator, 'this' will always be a T
+}
+
 } // namespace VMIL
 } // namespace REDasm
 
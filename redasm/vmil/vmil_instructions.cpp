@@ -27,12 +27,13 @@ VMILInstructionDef instructions[] = { VMIL_INSTRUCTION(ADD, Add),
                                       VMIL_INSTRUCTION(NOP, Nop),
                                       VMIL_INSTRUCTION_T(UNKN, Unkn, None) };
 
-VMILInstructionPtr emitInstruction(const REDasm::InstructionPtr& instruction, vmilopcode_t opcode, u64 index) {
+VMILInstructionPtr emitInstruction(const REDasm::InstructionPtr& instruction, vmilopcode_t opcode, VMILInstructionList& vminstructions) {
     const VMIL::VMILInstructionDef& vmilinstruction = VMIL::instructions[opcode];
+    u64 index = VMIL_INSTRUCTION_I(vminstructions);
 
-    VMILInstructionPtr vminstruction = std::make_shared<VMILInstruction>();
+    vminstructions.emplace_back();
+    VMILInstructionPtr vminstruction = &vminstructions.back();
     vminstruction->address = VMIL_INSTRUCTION_ADDRESS_I(instruction, index);
-    vminstruction->mnemonic = vmilinstruction.mnemonic;
     vminstruction->id = vmilinstruction.id;
     vminstruction->type = vmilinstruction.type;
     vminstruction->blocktype = instruction->blocktype;
@@ -40,5 +41,40 @@ VMILInstructionPtr emitInstruction(const REDasm::InstructionPtr& instruction, vm
     return vminstruction;
 }
 
+InstructionPtr toInstruction(const VMILInstruction &vminstruction)
+{
+    InstructionPtr instruction = std::make_shared<Instruction>();
+    instruction->address = vminstruction.address;
+    instruction->mnemonic = VMIL::instructions[vminstruction.id].mnemonic;
+    instruction->id = vminstruction.id;
+    instruction->type = vminstruction.type;
+    instruction->blocktype = vminstruction.blocktype;
+    instruction->target_idx = vminstruction.target_idx;
+
+    for(u32 i = 0; i < vminstruction.count; i++)
+    {
+        const VMILOperand& vmop = vminstruction.operands[i];
+        Operand operand;
+        operand.index = i;
+        operand.type = vmop.type;
+        operand.size = vmop.size;
+
+        if(vmop.is(OperandTypes::Displacement))
+            operand.disp = DisplacementOperand(RegisterOperand(vmop.regtype, vmop.reg), RegisterOperand(), 1, vmop.s_value);
+        else
+        {
+            operand.reg = RegisterOperand(vmop.regtype, vmop.reg);
+            operand.u_value = vmop.u_value;
+        }
+
+        instruction->operands.push_back(operand);
+    }
+
+    for(size_t i = 0; (i < VMIL_MAX_COMMENTS) && vminstruction.comments[i]; i++)
+        instruction->cmt(vminstruction.comments[i]);
+
+    return instruction;
+}
+
 } // namespace VMIL
 } // namespace REDasm
@@ -1,8 +1,8 @@
 #ifndef VMIL_INSTRUCTIONS_H
 #define VMIL_INSTRUCTIONS_H
 
-#define EMIT_OPCODE_FUNCTION(opcode) inline VMILInstructionPtr emit##opcode(const REDasm::InstructionPtr& instruction, u64 index = 0) { \
-                                return emitInstruction(instruction, VMIL::Opcodes::opcode, index); \
+#define EMIT_OPCODE_FUNCTION(opcode) inline VMILInstructionPtr emit##opcode(const REDasm::InstructionPtr& instruction, VMILInstructionList& vminstructions) { \
+                                return emitInstruction(instruction, VMIL::Opcodes::opcode, vminstructions); \
                             }
 
 #include "vmil_types.h"
@@ -12,7 +12,8 @@ namespace VMIL {
 
 extern VMILInstructionDef instructions[];
 
-VMILInstructionPtr emitInstruction(const REDasm::InstructionPtr& instruction, vmilopcode_t opcode, u64 index = 0);
+VMILInstructionPtr emitInstruction(const REDasm::InstructionPtr& instruction, vmilopcode_t opcode, VMILInstructionList& vminstructions);
+InstructionPtr toInstruction(const VMILInstruction& vminstruction); // For printing only
 
 EMIT_OPCODE_FUNCTION(Add)
 EMIT_OPCODE_FUNCTION(Sub)
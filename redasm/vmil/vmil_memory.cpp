@@ -0,0 +1,90 @@
+#include "vmil_memory.h"
+
+#define PAGE_NUMBER(address) ((address) >> VMIL_PAGE_BITS)
+#define PAGE_OFFSET(address) ((address) & (VMIL_PAGE_SIZE - 1))
+#define IS_VALID(page, offset) ((page)->valid[(offset) / 64] & (1ull << ((offset) % 64)))
+
+namespace REDasm {
+namespace VMIL {
+
+Memory::Memory()
+{
+
+}
+
+size_t Memory::pages() const
+{
+    return this->_pages.size();
+}
+
+u8 Memory::read(address_t address, size_t size, u64 *value) const
+{
+    const Page* page = NULL;
+    address_t pageaddress = 0;
+    u8 mask = 0;
+    *value = 0;
+
+    for(size_t i = 0; i < std::min(size, sizeof(u64)); i++) // Little endian, byte by byte: accesses may cross pages
+    {
+        address_t byteaddress = address + i;
+
+        if(!page || (PAGE_NUMBER(byteaddress) != pageaddress))
+        {
+            pageaddress = PAGE_NUMBER(byteaddress);
+            auto it = this->_pages.find(pageaddress);
+            page = (it != this->_pages.end()) ? it->second.get() : NULL;
+
+            if(!page)
+                continue;
+        }
+
+        size_t offset = PAGE_OFFSET(byteaddress);
+
+        if(!IS_VALID(page, offset))
+            continue;
+
+        *value |= static_cast<u64>(page->data[offset]) << (i * 8);
+        mask |= 1 << i;
+    }
+
+    return mask;
+}
+
+void Memory::write(address_t address, u64 value, size_t size)
+{
+    Page* page = NULL;
+    address_t pageaddress = 0;
+
+    for(size_t i = 0; i < std::min(size, sizeof(u64)); i++)
+    {
+        address_t byteaddress = address + i;
+
+        if(!page || (PAGE_NUMBER(byteaddress) != pageaddress))
+        {
+            pageaddress = PAGE_NUMBER(byteaddress);
+            page = this->writablePage(pageaddress);
+        }
+
+        size_t offset = PAGE_OFFSET(byteaddress);
+        page->data[offset] = static_cast<u8>(value >> (i * 8));
+        page->valid[offset / 64] |= 1ull << (offset % 64);
+    }
+}
+
+void Memory::clear()
+{
+    this->_pages.clear();
+}
+
+Memory::Page *Memory::writablePage(address_t pageaddress)
+{
+    PagePtr& page = this->_pages[pageaddress];
+
+    if(!page)
+        page = std::make_unique<Page>();
+
+    return page.get();
+}
+
+} // namespace VMIL
+} // namespace REDasm
@@ -0,0 +1,39 @@
+#ifndef VMIL_MEMORY_H
+#define VMIL_MEMORY_H
+
+#include <unordered_map>
+#include <algorithm>
+#include <memory>
+#include "../redasm.h"
+
+#define VMIL_PAGE_BITS 12
+#define VMIL_PAGE_SIZE (1 << VMIL_PAGE_BITS)
+
+namespace REDasm {
+namespace VMIL {
+
+class Memory // Sparse and paged, with a written bit for every byte
+{
+    private:
+        struct Page { Page() { std::fill(valid, valid + (VMIL_PAGE_SIZE / 64), 0); } u8 data[VMIL_PAGE_SIZE]; u64 valid[VMIL_PAGE_SIZE / 64]; };
+        typedef std::unique_ptr<Page> PagePtr;
+        typedef std::unordered_map<address_t, PagePtr> Pages; // Page number -> Page
+
+    public:
+        Memory();
+        size_t pages() const;
+        u8 read(address_t address, size_t size, u64* value) const; // Returns a mask of the bytes written before
+        void write(address_t address, u64 value, size_t size);
+        void clear();
+
+    private:
+        Page* writablePage(address_t pageaddress);
+
+    private:
+        Pages _pages;
+};
+
+} // namespace VMIL
+} // namespace REDasm
+
+#endif // VMIL_MEMORY_H
@@ -5,7 +5,7 @@ namespace VMIL {
 
 VMILPrinter::VMILPrinter(const PrinterPtr &srcprinter, DisassemblerAPI *disassembler, SymbolTable *symboltable): Printer(disassembler, symboltable), _srcprinter(srcprinter)
 {
-
+    this->_cacheable = false; // VMIL addresses aren't tracked by the journal
 }
 
 std::string VMILPrinter::reg(const RegisterOperand &regop) const
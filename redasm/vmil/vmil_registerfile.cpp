@@ -0,0 +1,22 @@
+#include "vmil_registerfile.h"
+
+namespace REDasm {
+namespace VMIL {
+
+RegisterFile::RegisterFile(size_t count): _values(count, 0), _valid((count + 63) / 64, 0)
+{
+
+}
+
+size_t RegisterFile::size() const
+{
+    return this->_values.size();
+}
+
+void RegisterFile::clear()
+{
+    std::fill(this->_valid.begin(), this->_valid.end(), 0);
+}
+
+} // namespace VMIL
+} // namespace REDasm
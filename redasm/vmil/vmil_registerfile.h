@@ -0,0 +1,45 @@
+#ifndef VMIL_REGISTERFILE_H
+#define VMIL_REGISTERFILE_H
+
+#include <algorithm>
+#include <vector>
+#include "../redasm.h"
+
+#define VMIL_VALID_WORD(reg) (static_cast<size_t>(reg) / 64)
+#define VMIL_VALID_BIT(reg)  (1ull << (static_cast<size_t>(reg) % 64))
+
+namespace REDasm {
+namespace VMIL {
+
+class RegisterFile // Dense values indexed by register id, one valid bit per register
+{
+    public:
+        RegisterFile(size_t count = 0);
+        size_t size() const;
+        void clear();
+
+    public: // Emulator's hot path, keep them inline
+        bool isValid(register_t reg) const { return this->inRange(reg) && (this->_valid[VMIL_VALID_WORD(reg)] & VMIL_VALID_BIT(reg)); }
+        u64 read(register_t reg) const { return this->isValid(reg) ? this->_values[reg] : 0; }
+        void invalidate(register_t reg) { if(this->inRange(reg)) this->_valid[VMIL_VALID_WORD(reg)] &= ~VMIL_VALID_BIT(reg); }
+
+        void write(register_t reg, u64 value)
+        {
+            if(!this->inRange(reg)) // Unknown to this architecture, it stays invalid
+                return;
+
+            this->_values[reg] = value;
+            this->_valid[VMIL_VALID_WORD(reg)] |= VMIL_VALID_BIT(reg);
+        }
+
+    private:
+        bool inRange(register_t reg) const { return (reg >= 0) && (static_cast<size_t>(reg) < this->_values.size()); }
+
+    private:
+        std::vector<u64> _values, _valid;
+};
+
+} // namespace VMIL
+} // namespace REDasm
+
+#endif // VMIL_REGISTERFILE_H
@@ -34,6 +34,8 @@
 #define VMIL_REGISTER_ID(i)                          i
 #define VMIL_REGISTER(i)                             VMIL_REGISTER_ID(i), VMIL_REG_OPERAND
 #define VMIL_DEFAULT_REGISTER                        VMIL_REGISTER(defaultRegister())
+#define VMIL_MAX_OPERANDS                            3 // Three-address code
+#define VMIL_MAX_COMMENTS                            2
 
 namespace REDasm {
 namespace VMIL {
@@ -53,9 +55,96 @@ struct VMILInstructionDef { std::string mnemonic; u32 id, type; };
 typedef address_t vmiladdress_t;
 typedef register_t vmilregister_t;
 typedef u32 vmilopcode_t;
-typedef Instruction VMILInstruction;
-typedef InstructionPtr VMILInstructionPtr;
-typedef std::vector<VMILInstructionPtr> VMILInstructionList;
+
+struct VMILOperand
+{
+    VMILOperand(): type(OperandTypes::None), size(OperandSizes::Undefined), regtype(0), reg(REGISTER_INVALID), u_value(0) { }
+
+    u32 type, size;
+    u64 regtype;                             // Same as RegisterOperand::extra_type
+    vmilregister_t reg;                      // Displacement's base, if any
+    union { s64 s_value; u64 u_value; };     // Displacement's offset, if any
+
+    bool is(u32 t) const { return type & t; }
+    bool isTemporary() const { return this->is(OperandTypes::Register) && (regtype == VMIL_REG_OPERAND); }
+};
+
+struct VMILInstruction // Fixed width, no heap allocations: lives inline in VMILInstructionList
+{
+    VMILInstruction(): address(0), id(Opcodes::Unkn), type(0), blocktype(0), target_idx(-1), count(0), comments{NULL, NULL} { }
+
+    vmiladdress_t address;
+    vmilopcode_t id;
+    u32 type, blocktype;
+    s32 target_idx;
+    u32 count;                               // Used operands
+    VMILOperand operands[VMIL_MAX_OPERANDS];
+    const char* comments[VMIL_MAX_COMMENTS]; // Static strings only
+
+    bool is(u32 t) const { return type & t; }
+    VMILOperand& op(size_t idx) { return operands[idx]; }
+    const VMILOperand& op(size_t idx) const { return operands[idx]; }
+    void op_size(s32 index, u32 size) { operands[index].size = size; }
+
+    VMILInstruction& cmt(const char* s)
+    {
+        for(size_t i = 0; i < VMIL_MAX_COMMENTS; i++)
+        {
+            if(comments[i])
+                continue;
+
+            comments[i] = s;
+            break;
+        }
+
+        return *this;
+    }
+
+    VMILInstruction& op(const Operand& operand)
+    {
+        VMILOperand& vmop = this->next();
+        vmop.type = operand.type;
+        vmop.size = operand.size;
+
+        if(operand.is(OperandTypes::Displacement))
+        {
+            vmop.regtype = operand.disp.base.extra_type;
+            vmop.reg = operand.disp.base.r;
+            vmop.s_value = operand.disp.displacement;
+        }
+        else
+        {
+            vmop.regtype = operand.reg.extra_type;
+            vmop.reg = operand.reg.r;
+            vmop.u_value = operand.u_value;
+        }
+
+        return *this;
+    }
+
+    VMILInstruction& reg(vmilregister_t r, u64 type = 0)
+    {
+        VMILOperand& vmop = this->next();
+        vmop.type = OperandTypes::Register;
+        vmop.regtype = type;
+        vmop.reg = r;
+        return *this;
+    }
+
+    template<typename T> VMILInstruction& imm(T v)
+    {
+        VMILOperand& vmop = this->next();
+        vmop.type = OperandTypes::Immediate;
+        vmop.u_value = static_cast<u64>(v);
+        return *this;
+    }
+
+    private:
+        VMILOperand& next() { return operands[(count < VMIL_MAX_OPERANDS) ? count++ : (VMIL_MAX_OPERANDS - 1)]; }
+};
+
+typedef VMILInstruction* VMILInstructionPtr;              // Valid until the next instruction is emitted
+typedef std::vector<VMILInstruction> VMILInstructionList; // Reusable: clear() keeps its capacity
 
 } // namespace VMIL
 } // namespace REDasm
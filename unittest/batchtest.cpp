@@ -0,0 +1,76 @@
+#include "batchtest.h"
+#include "cli/batchrunner.h"
+#include <unordered_set>
+#include <iostream>
+
+#define REPEAT_COUNT    20
+#define REPEATED(s)     std::string(REPEAT_COUNT, s)
+
+#define RED_STRING(s)   ("\x1b[31m" + std::string(s) + "\x1b[0m")
+#define GREEN_STRING(s) ("\x1b[32m" + std::string(s) + "\x1b[0m")
+#define TEST_OK         GREEN_STRING("OK")
+#define TEST_FAIL       RED_STRING("FAIL")
+
+#define TEST(s, cond)   cout << "->> " << s << "..." << ((cond) ? TEST_OK : TEST_FAIL) << endl
+#define TITLE(t)        cout << REPEATED('-') << t << " " << REPEATED('-') << endl
+
+using namespace std;
+
+BatchTest::BatchTest()
+{
+
+}
+
+void BatchTest::runTests()
+{
+    TITLE("Testing BatchRunner");
+    this->testOutputFiles();
+    this->testFailures();
+    cout << REPEATED('-') << REPEATED('-') << REPEATED('-') << endl << endl;
+}
+
+bool BatchTest::allDistinct(const std::vector<string> &files)
+{
+    std::unordered_set<std::string> unique(files.begin(), files.end());
+    return unique.size() == files.size();
+}
+
+void BatchTest::testOutputFiles()
+{
+    std::vector<std::string> files = { "a/x.exe", "b/x.exe", "c/x.exe", "d/x.exe-2", "y.exe" };
+
+    BatchRunner nextto(1, REDasm::BatchOutputs::Json, std::string());
+    std::vector<std::string> outputfiles = nextto.outputFiles(files);
+    TEST("Output next to each file", (outputfiles.size() == files.size()) && (outputfiles[0] == "a/x.exe.redasm.json") &&
+                                     (outputfiles[1] == "b/x.exe.redasm.json"));
+
+    BatchRunner outputdir(1, REDasm::BatchOutputs::Binary, "out");
+    outputfiles = outputdir.outputFiles(files);
+    TEST("Output directory: one file per input", outputfiles.size() == files.size());
+
+    if(outputfiles.size() != files.size())
+        return;
+
+    TEST("Output directory: first name is kept", outputfiles[0] == REDasm::makePath("out", "x.exe.redasm.cbor"));
+    TEST("Output directory: same names are suffixed", (outputfiles[1] == REDasm::makePath("out", "x.exe-2.redasm.cbor")) &&
+                                                      (outputfiles[2] == REDasm::makePath("out", "x.exe-3.redasm.cbor")));
+    TEST("Output directory: suffixes skip existing names", outputfiles[3] == REDasm::makePath("out", "x.exe-2-2.redasm.cbor"));
+    TEST("Output directory: no collisions", BatchTest::allDistinct(outputfiles));
+}
+
+void BatchTest::testFailures()
+{
+    std::vector<std::string> files = { "/nonexistent/a/x.exe", "/nonexistent/b/x.exe" };
+    BatchRunner runner(2, REDasm::BatchOutputs::None, std::string());
+    size_t count = 0, failed = 0;
+
+    runner.run(files, [&count, &failed](const REDasm::BatchResult& result, const std::string& report) {
+        count++;
+
+        if(!result.success && !report.empty())
+            failed++;
+    });
+
+    TEST("Every file is reported", count == files.size());
+    TEST("Missing files are reported as failures", failed == files.size());
+}
@@ -0,0 +1,21 @@
+#ifndef BATCHTEST_H
+#define BATCHTEST_H
+
+#include <string>
+#include <vector>
+
+class BatchTest
+{
+    public:
+        BatchTest();
+        void runTests();
+
+    private:
+        static bool allDistinct(const std::vector<std::string>& files);
+
+    private: // Tests
+        void testOutputFiles();
+        void testFailures();
+};
+
+#endif // BATCHTEST_H
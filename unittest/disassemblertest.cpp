@@ -1,5 +1,7 @@
 #include "disassemblertest.h"
 #include "redasm/disassembler/disassembler.h"
+#include "redasm/formats/binary/binary.h"
+#include "redasm/analyzer/callarguments.h"
 #include <iostream>
 #include <QString>
 #include <QFileInfo>
@@ -29,6 +31,7 @@
 #define ADD_TEST_NULL(t, cb)             this->_tests[t] = NULL;
 #define ADD_TEST_PATH(t, cb)             this->_tests[TEST_PATH(t)] = [this](REDasm::Disassembler* disassembler) { this->cb(disassembler); }
 #define ADD_TEST_PATH_NULL(t, cb)        this->_tests[TEST_PATH(t)] = NULL;
+#define ADD_FIXTURE(t, a, b, ba, d, cb)  this->_fixtures[t] = { a, b, ba, d, [this](REDasm::Disassembler* disassembler) { this->cb(disassembler); } }
 
 using namespace std;
 using namespace REDasm;
@@ -46,6 +49,35 @@ DisassemblerTest::DisassemblerTest()
 
     ADD_TEST_PATH_NULL("PE Test/CorruptedIT.exe", NULL);
 
+    // v1 = 3, v0 = 5, 'se v0, 5' always skips 'v1 = 7', v2 = 4 | v1, v2 += 1
+    ADD_FIXTURE("CHIP-8 constant branch", "chip8", 16, 0x200, std::vector<u8>({ 0x61, 0x03, 0x60, 0x05, 0x30, 0x05, 0x61, 0x07,
+                                                                                0x62, 0x04, 0x82, 0x11, 0x72, 0x01, 0x00, 0xEE }), testConstantBranch);
+
+    // v0 = 0, v1 = 5, loop: v0 += 1 until v0 == 5, v1 += 1
+    ADD_FIXTURE("CHIP-8 loop phi", "chip8", 16, 0x200, std::vector<u8>({ 0x60, 0x00, 0x61, 0x05, 0x70, 0x01, 0x30, 0x05,
+                                                                         0x12, 0x04, 0x71, 0x01, 0x00, 0xEE }), testLoopPhi);
+
+    // lui $t9, 0x40, addiu $t9, $t9, 0x10, jr $t9 (delay slot: nop), 0x00400010: jr $ra (delay slot: nop)
+    ADD_FIXTURE("MIPS jr", "mips32", 32, 0x00400000, std::vector<u8>({ 0x40, 0x00, 0x19, 0x3C, 0x10, 0x00, 0x39, 0x27,
+                                                                         0x08, 0x00, 0x20, 0x03, 0x00, 0x00, 0x00, 0x00,
+                                                                         0x08, 0x00, 0xE0, 0x03, 0x00, 0x00, 0x00, 0x00 }), testJumpRegister);
+
+    // beq 0x8004 (taken and fallthrough are the same block), ldr r1, [pc, #0], bx lr, 0x0000800C: 0x1234
+    ADD_FIXTURE("ARM jcc to fallthrough", "arm", 32, 0x00008000, std::vector<u8>({ 0xFF, 0xFF, 0xFF, 0x0A, 0x00, 0x10, 0x9F, 0xE5,
+                                                                                   0x1E, 0xFF, 0x2F, 0xE1, 0x34, 0x12, 0x00, 0x00 }), testJccFallthrough);
+
+    // push 0, push 0x00401020 (DlgProc), test eax, eax, jz 0x00401018, push 0, push 0x65, push 0, call [0x00402000], ret
+    ADD_FIXTURE("x86 call arguments", "x86_32", 32, 0x00401000, std::vector<u8>({ 0x6A, 0x00, 0x68, 0x20, 0x10, 0x40, 0x00, 0x85,
+                                                                                  0xC0, 0x74, 0x0D, 0x6A, 0x00, 0x6A, 0x65, 0x6A,
+                                                                                  0x00, 0xFF, 0x15, 0x00, 0x20, 0x40, 0x00, 0xC3,
+                                                                                  0xC3, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90,
+                                                                                  0xC3 }), testPushArguments);
+
+    // sub rsp, 0x38, mov qword ptr [rsp + 0x20], 0x2A, xor r9d, r9d, call [rip], add rsp, 0x38, ret
+    ADD_FIXTURE("x64 call arguments", "x86_64", 64, 0x00001000, std::vector<u8>({ 0x48, 0x83, 0xEC, 0x38, 0x48, 0xC7, 0x44, 0x24,
+                                                                                  0x20, 0x2A, 0x00, 0x00, 0x00, 0x45, 0x31, 0xC9,
+                                                                                  0xFF, 0x15, 0x00, 0x00, 0x00, 0x00, 0x48, 0x83,
+                                                                                  0xC4, 0x38, 0xC3 }), testStackArguments);
 }
 
 void DisassemblerTest::runTests()
@@ -73,6 +105,12 @@ void DisassemblerTest::runTests()
         DisassemblerTest::runTest(data, test.second);
         cout << REPEATED('-') << REPEATED('-') << REPEATED('-') << endl << endl;
     });
+
+    std::for_each(this->_fixtures.begin(), this->_fixtures.end(), [](const FixtureItem& fixture) {
+        TEST_TITLE(fixture.first);
+        DisassemblerTest::runFixture(fixture.second);
+        cout << REPEATED('-') << REPEATED('-') << REPEATED('-') << endl << endl;
+    });
 }
 
 string DisassemblerTest::replaceAll(std::string str, const std::string &from, const std::string &to)
@@ -128,6 +166,58 @@ void DisassemblerTest::runTest(QByteArray &data, const TestCallback& testcallbac
         testcallback(&disassembler);
 }
 
+void DisassemblerTest::runFixture(Fixture fixture)
+{
+    BinaryFormat* format = REDasm::declareFormatPlugin<BinaryFormat>(fixture.data.data(), fixture.data.size());
+    TEST("Format", format);
+
+    if(!format)
+        return;
+
+    format->build(fixture.assembler, fixture.bits, 0, fixture.baseaddress, fixture.baseaddress, fixture.data.size());
+    AssemblerPlugin* assembler = REDasm::getAssembler(format->assembler());
+    TEST("Assembler", assembler);
+
+    if(!assembler)
+    {
+        delete format;
+        return;
+    }
+
+    Disassembler disassembler(Buffer(fixture.data.data(), fixture.data.size()), assembler, format);
+
+    cout << "->> Disassembler...";
+        disassembler.disassemble();
+    cout << TEST_OK << endl;
+
+    fixture.callback(&disassembler);
+}
+
+bool DisassemblerTest::constantValue(Disassembler *disassembler, address_t function, address_t address, s32 index, u64 *value)
+{
+    VMIL::VMILCache* vmilcache = disassembler->vmilCache();
+
+    if(!vmilcache)
+        return false;
+
+    VMIL::ConstantPropagation constprop(disassembler, disassembler->listing(), disassembler->emulator());
+    VMIL::ConstantPropagation::ConstantList constants;
+
+    if(!constprop.run(vmilcache->function(function), constants))
+        return false;
+
+    for(const VMIL::ConstantPropagation::Constant& constant : constants)
+    {
+        if((constant.address != address) || (constant.index != index))
+            continue;
+
+        *value = constant.value;
+        return true;
+    }
+
+    return false;
+}
+
 void DisassemblerTest::testVBEvents(Disassembler *disassembler, const std::map<address_t, string> &vbevents)
 {
     SymbolTable* symboltable = disassembler->symbolTable();
@@ -331,3 +421,67 @@ void DisassemblerTest::testTn11(Disassembler *disassembler)
         i++;
     });
 }
+
+void DisassemblerTest::testConstantBranch(Disassembler *disassembler)
+{
+    u64 value = 0;
+
+    TEST("Pruned branch: 'v1 = 7' is not executable", !DisassemblerTest::constantValue(disassembler, 0x200, 0x206, 0, &value));
+    TEST("Phi over the pruned edge: v1 = 3 @ 0x20A", DisassemblerTest::constantValue(disassembler, 0x200, 0x20A, 1, &value) && (value == 3));
+    TEST("Folded OR: v2 = 7 @ 0x20A", DisassemblerTest::constantValue(disassembler, 0x200, 0x20A, 0, &value) && (value == 7));
+    TEST("Folded ADD: v2 = 8 @ 0x20C", DisassemblerTest::constantValue(disassembler, 0x200, 0x20C, 0, &value) && (value == 8));
+}
+
+void DisassemblerTest::testLoopPhi(Disassembler *disassembler)
+{
+    u64 value = 0;
+
+    TEST("Loop counter is not constant @ 0x204", !DisassemblerTest::constantValue(disassembler, 0x200, 0x204, 0, &value));
+    TEST("Loop invariant phi: v1 = 6 @ 0x20A", DisassemblerTest::constantValue(disassembler, 0x200, 0x20A, 0, &value) && (value == 6));
+}
+
+void DisassemblerTest::testJumpRegister(Disassembler *disassembler)
+{
+    Listing& listing = disassembler->listing();
+    auto it = listing.find(0x00400008);
+    TEST("Checking JR @ 0x00400008", it != listing.end());
+
+    if(it == listing.end())
+        return;
+
+    InstructionPtr instruction = *it;
+    u64 value = 0;
+
+    TEST("Materialized address: $t9 = 0x00400010 @ 0x00400004", DisassemblerTest::constantValue(disassembler, 0x00400000, 0x00400004, 0, &value) && (value == 0x00400010));
+    TEST("Resolved JR target @ 0x00400008", instruction->hasTargets() && (instruction->target() == 0x00400010));
+    TEST("Disassembled JR target @ 0x00400010", listing.find(0x00400010) != listing.end());
+}
+
+void DisassemblerTest::testPushArguments(Disassembler *disassembler)
+{
+    CallArguments callarguments(disassembler->listing());
+    u64 value = 0;
+
+    TEST("Pushes across the jz: DlgProc = 0x00401020", callarguments.argument(0x00401011, 4, &value) && (value == 0x00401020));
+    TEST("Template = 0x65", callarguments.argument(0x00401011, 2, &value) && (value == 0x65));
+    TEST("lParam = 0", callarguments.argument(0x00401011, 5, &value) && !value);
+}
+
+void DisassemblerTest::testStackArguments(Disassembler *disassembler)
+{
+    CallArguments callarguments(disassembler->listing());
+    callarguments.setRegisters({ { X86_REG_RCX, X86_REG_ECX }, { X86_REG_RDX, X86_REG_EDX }, { X86_REG_R8, X86_REG_R8D }, { X86_REG_R9, X86_REG_R9D } });
+    callarguments.setStackSlots(X86_REG_RSP, 0x20, sizeof(u64));
+    u64 value = 0;
+
+    TEST("Register argument: r9 = 0", callarguments.argument(0x00001010, 4, &value) && !value);
+    TEST("Stack argument: [rsp + 0x20] = 0x2A", callarguments.argument(0x00001010, 5, &value) && (value == 0x2A));
+    TEST("Unset register argument", !callarguments.argument(0x00001010, 1, &value));
+}
+
+void DisassemblerTest::testJccFallthrough(Disassembler *disassembler)
+{
+    u64 value = 0;
+
+    TEST("Fallthrough block is executable: r1 = 0x1234 @ 0x00008004", DisassemblerTest::constantValue(disassembler, 0x00008000, 0x00008004, 0, &value) && (value == 0x1234));
+}
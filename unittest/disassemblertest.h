@@ -13,6 +13,10 @@ class DisassemblerTest
         typedef std::map<std::string, TestCallback> TestList;
         typedef std::pair<std::string, TestCallback> TestItem;
 
+        struct Fixture { std::string assembler; u32 bits; address_t baseaddress; std::vector<u8> data; TestCallback callback; }; // In memory binaries
+        typedef std::map<std::string, Fixture> FixtureList;
+        typedef std::pair<std::string, Fixture> FixtureItem;
+
     public:
         DisassemblerTest();
         void runTests();
@@ -21,6 +25,8 @@ class DisassemblerTest
         static std::string replaceAll(std::string str, const std::string& from, const std::string& to);
         static QByteArray readFile(const QString& file);
         static void runTest(QByteArray &data, const TestCallback &testcallback);
+        static void runFixture(Fixture fixture);
+        static bool constantValue(REDasm::Disassembler* disassembler, address_t function, address_t address, s32 index, u64* value);
 
     private:
         void testVBEvents(REDasm::Disassembler* disassembler, const std::map<address_t, std::string>& vbevents);
@@ -34,8 +40,17 @@ class DisassemblerTest
         void testIoliARM(REDasm::Disassembler* disassembler);
         void testTn11(REDasm::Disassembler* disassembler);
 
+    private: // Fixtures
+        void testConstantBranch(REDasm::Disassembler* disassembler);
+        void testLoopPhi(REDasm::Disassembler* disassembler);
+        void testJumpRegister(REDasm::Disassembler* disassembler);
+        void testJccFallthrough(REDasm::Disassembler* disassembler);
+        void testPushArguments(REDasm::Disassembler* disassembler);
+        void testStackArguments(REDasm::Disassembler* disassembler);
+
     private:
         TestList _tests;
+        FixtureList _fixtures;
 };
 
 #endif // DISASSEMBLERTEST_H
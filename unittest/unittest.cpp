@@ -1,9 +1,13 @@
 #include "unittest.h"
 #include "disassemblertest.h"
+#include "batchtest.h"
 
 int UnitTest::run()
 {
     DisassemblerTest disasmtest;
     disasmtest.runTests();
+
+    BatchTest batchtest;
+    batchtest.runTests();
     return 0;
 }
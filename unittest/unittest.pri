@@ -1,2 +1,6 @@
 HEADERS += $$PWD/*.h
 SOURCES += $$PWD/*.cpp
+
+# BatchRunner lives in the CLI front end
+HEADERS += $$PWD/../cli/batchrunner.h
+SOURCES += $$PWD/../cli/batchrunner.cpp
@@ -12,7 +12,7 @@ QSize CallGraphItem::size() const
 {
     QFontMetrics fm(this->_font);
     const REDasm::CallGraphVertex* cgv = static_cast<const REDasm::CallGraphVertex*>(this->vertex());
-    return QSize(fm.width(QString::fromStdString(cgv->symbol->name)) + (fm.width(" ") * 2), fm.height() * 2);
+    return QSize(fm.width(QString::fromStdString(cgv->symbol->displayName())) + (fm.width(" ") * 2), fm.height() * 2);
 }
 
 void CallGraphItem::paint(QPainter *painter)
@@ -22,7 +22,7 @@ void CallGraphItem::paint(QPainter *painter)
 
     painter->setFont(this->_font);
     painter->drawText(QRect(this->position(), this->size()),
-                      QString::fromStdString(cgv->symbol->name), textoption);
+                      QString::fromStdString(cgv->symbol->displayName()), textoption);
 
     GraphItem::paint(painter);
 }
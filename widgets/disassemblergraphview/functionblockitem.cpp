@@ -45,7 +45,7 @@ void FunctionBlockItem::paint(QPainter *painter)
     QFontMetrics fm(this->font());
     QString title = QString("%1.%2: %3").arg(fgv->layer())
                                         .arg(fgv->index())
-                                        .arg(QString::fromStdString(symbol ? symbol->name : REDasm::hex(fgv->start)));
+                                        .arg(QString::fromStdString(symbol ? symbol->displayName() : REDasm::hex(fgv->start)));
 
     painter->save();
         painter->setFont(this->font());
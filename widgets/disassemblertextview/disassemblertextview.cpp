@@ -14,7 +14,7 @@
 #include <QtMath>
 #include <QMenu>
 
-DisassemblerTextView::DisassemblerTextView(QWidget *parent): QPlainTextEdit(parent), _issymboladdressvalid(false), _emitmode(DisassemblerTextView::Normal), _disdocument(NULL), _disassembler(NULL), _currentaddress(INT64_MAX), _symboladdress(0)
+DisassemblerTextView::DisassemblerTextView(QWidget *parent): QPlainTextEdit(parent), _issymboladdressvalid(false), _emitmode(DisassemblerTextView::Normal), _disdocument(NULL), _disassembler(NULL), _subscription(0), _currentaddress(INT64_MAX), _symboladdress(0)
 {
     QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
     font.setPointSize(12);
@@ -39,6 +39,8 @@ DisassemblerTextView::DisassemblerTextView(QWidget *parent): QPlainTextEdit(pare
 
 DisassemblerTextView::~DisassemblerTextView()
 {
+    if(this->_disassembler)
+        this->_disassembler->journal()->unsubscribe(this->_subscription);
 }
 
 bool DisassemblerTextView::canGoBack() const
@@ -71,7 +73,11 @@ void DisassemblerTextView::setDisassembler(REDasm::Disassembler *disassembler)
     if(this->_disdocument)
         delete this->_disdocument;
 
+    if(this->_disassembler)
+        this->_disassembler->journal()->unsubscribe(this->_subscription);
+
     this->_disassembler = disassembler;
+    this->_subscription = disassembler->journal()->subscribe([this](const REDasm::Change& change) { this->applyChange(change); });
     this->_disdocument = new DisassemblerTextDocument(disassembler, this->document(), this);
     this->_highlighter->setHighlightColor(ThemeProvider::highlightColor());
     this->_highlighter->setSeekColor(ThemeProvider::seekColor());
@@ -263,7 +269,6 @@ void DisassemblerTextView::createContextMenu()
         if(!this->_disassembler->dataToString(this->_symboladdress))
             return;
 
-        this->_disdocument->update(this->_symboladdress);
         emit invalidateSymbols();
     });
 
@@ -335,6 +340,14 @@ void DisassemblerTextView::adjustContextMenu()
     this->_acthexdump->setVisible(segment && !segment->is(REDasm::SegmentTypes::Bss));
 }
 
+void DisassemblerTextView::applyChange(const REDasm::Change &change)
+{
+    if(!this->_disdocument || !change.is(REDasm::ChangeTypes::SymbolRenamed))
+        return;
+
+    this->_disdocument->update(change.address); // Refresh generated blocks only
+}
+
 void DisassemblerTextView::highlightWords()
 {
     if(!this->_disdocument || !this->_currentaddress)
@@ -383,7 +396,7 @@ void DisassemblerTextView::showReferences(address_t address)
 
     if(!this->_disassembler->getReferencesCount(address))
     {
-        QMessageBox::information(this, "No References", "There are no references to " + S_TO_QS(symbol->name));
+        QMessageBox::information(this, "No References", "There are no references to " + S_TO_QS(symbol->displayName()));
         return;
     }
 
@@ -445,6 +458,5 @@ void DisassemblerTextView::rename(address_t address)
     if(s.simplified().isEmpty() || !symboltable->update(symbol, newsym))
         return;
 
-    this->_disdocument->update(address);
     emit symbolRenamed(symbol);
 }
@@ -41,6 +41,7 @@ class DisassemblerTextView : public QPlainTextEdit
         void createContextMenu();
         void adjustContextMenu();
         void highlightWords();
+        void applyChange(const REDasm::Change& change);
         void updateAddress();
         void updateSymbolAddress(address_t address);
         void display(address_t address);
@@ -67,6 +68,7 @@ class DisassemblerTextView : public QPlainTextEdit
         DisassemblerTextDocument* _disdocument;
         DisassemblerHighlighter* _highlighter;
         REDasm::Disassembler* _disassembler;
+        REDasm::ChangeJournal::subscription_t _subscription;
         QAction *_actrename, *_actcreatestring, *_actxrefs, *_actfollow, *_actcallgraph;
         QAction *_actgoto, *_acthexdump, *_actback, *_actforward, *_actcopy, *_actselectall;
         QMenu* _contextmenu;
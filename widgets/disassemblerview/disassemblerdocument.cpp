@@ -158,7 +158,7 @@ void DisassemblerDocument::appendLabel(const REDasm::SymbolPtr &symbol, bool rep
     charformat.setFontUnderline(true);
 
     this->_textcursor.insertText(QString(" ").repeated(this->getIndent(symbol->address) + INDENT_WIDTH), QTextCharFormat());
-    this->_textcursor.insertText(S_TO_QS(symbol->name) + ":", charformat);
+    this->_textcursor.insertText(S_TO_QS(symbol->displayName()) + ":", charformat);
 }
 
 void DisassemblerDocument::appendFunctionStart(const REDasm::SymbolPtr &symbol, bool replace)
@@ -377,7 +377,7 @@ void DisassemblerDocument::appendSymbol(const REDasm::SymbolPtr &symbol, const s
     charformat.setForeground(THEME_VALUE("label_fg"));
     charformat.setAnchor(true);
     charformat.setAnchorHref(DisassemblerDocument::encode(data));
-    this->_textcursor.insertText(S_TO_QS(symbol->name) + " ", charformat);
+    this->_textcursor.insertText(S_TO_QS(symbol->displayName()) + " ", charformat);
 
     if(symbol->is(REDasm::SymbolTypes::String))
         charformat.setForeground(THEME_VALUE("string_fg"));
@@ -1,11 +1,14 @@
 #include "disassemblerthread.h"
 
-DisassemblerThread::DisassemblerThread(REDasm::Disassembler *disassembler, QObject *parent) : QThread(parent), _disassembler(disassembler)
+DisassemblerThread::DisassemblerThread(REDasm::Disassembler *disassembler, bool lazy, QObject *parent) : QThread(parent), _disassembler(disassembler), _lazy(lazy)
 {
 
 }
 
 void DisassemblerThread::run()
 {
-    this->_disassembler->disassemble();
+    if(this->_lazy)
+        this->_disassembler->disassembleLazy(); // Background passes are left to the caller
+    else
+        this->_disassembler->disassemble();
 }
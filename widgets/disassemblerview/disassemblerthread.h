@@ -9,13 +9,14 @@ class DisassemblerThread : public QThread
     Q_OBJECT
 
     public:
-        explicit DisassemblerThread(REDasm::Disassembler* disassembler, QObject *parent = 0);
+        explicit DisassemblerThread(REDasm::Disassembler* disassembler, bool lazy, QObject *parent = 0);
 
     protected:
         virtual void run();
 
     private:
         REDasm::Disassembler* _disassembler;
+        bool _lazy;
 };
 
 #endif // DISASSEMBLERTHREAD_H
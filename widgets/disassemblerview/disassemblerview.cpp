@@ -1,12 +1,20 @@
 #include "disassemblerview.h"
 #include "ui_disassemblerview.h"
 #include "../../dialogs/referencesdialog.h"
+#include <QElapsedTimer>
 #include <QMessageBox>
+#include <limits>
 
 #define VMIL_TAB_INDEX 1
+#define LAZY_THRESHOLD 0x2000000 // 32 MiB: bigger images are disassembled on demand
+#define PASSES_BUDGET  256
+#define PASSES_SLICE   15        // ms, keeps the UI responsive
+#define PROGRESS_RATE  50        // ms, progress is sampled, never pushed
 
 DisassemblerView::DisassemblerView(QLabel *lblstatus, QWidget *parent) : QWidget(parent), ui(new Ui::DisassemblerView), _hexdocument(NULL), _lblstatus(lblstatus), _disassembler(NULL), _disassemblerthread(NULL)
 {
+    this->_passestimer = new QTimer(this);
+    this->_progresstimer = new QTimer(this);
     ui->setupUi(this);
     ui->vSplitter->setSizes((QList<int>() << this->width() * 0.70
                                           << this->width() * 0.30));
@@ -70,20 +78,22 @@ DisassemblerView::DisassemblerView(QLabel *lblstatus, QWidget *parent) : QWidget
     ui->tvStrings->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
     ui->tvStrings->horizontalHeader()->setSectionResizeMode(2, QHeaderView::ResizeToContents);
 
-    connect(ui->disassemblerTextView, &DisassemblerTextView::gotoRequested, this, &DisassemblerView::showGoto);
-    connect(ui->disassemblerTextView, &DisassemblerTextView::hexDumpRequested, this, &DisassemblerView::showHexDump);
-    connect(ui->disassemblerTextView, &DisassemblerTextView::symbolRenamed, this, &DisassemblerView::updateModel);
-    connect(ui->disassemblerTextView, &DisassemblerTextView::addressChanged, this, &DisassemblerView::displayAddress);
-    connect(ui->disassemblerTextView, &DisassemblerTextView::addressChanged, this, &DisassemblerView::displayInstructionReferences);
-    connect(ui->disassemblerTextView, &DisassemblerTextView::symbolAddressChanged, this, &DisassemblerView::displayReferences);
-    connect(ui->disassemblerTextView, &DisassemblerTextView::symbolDeselected, this->_referencesmodel, &ReferencesModel::clear);
-    connect(ui->disassemblerTextView, &DisassemblerTextView::invalidateSymbols, [this]() { this->updateModel(NULL);});
-    connect(ui->disassemblerTextView, &DisassemblerTextView::canGoBackChanged, [this]() { ui->tbBack->setEnabled(ui->disassemblerTextView->canGoBack()); });
-    connect(ui->disassemblerTextView, &DisassemblerTextView::canGoForwardChanged, [this]() { ui->tbForward->setEnabled(ui->disassemblerTextView->canGoForward()); });
-
-    connect(ui->tbBack, &QToolButton::clicked, ui->disassemblerTextView, &DisassemblerTextView::goBack);
-    connect(ui->tbForward, &QToolButton::clicked, ui->disassemblerTextView, &DisassemblerTextView::goForward);
+    connect(ui->disassemblerTextView, &ListingTextView::gotoRequested, this, &DisassemblerView::showGoto);
+    connect(ui->disassemblerTextView, &ListingTextView::hexDumpRequested, this, &DisassemblerView::showHexDump);
+    connect(ui->disassemblerTextView, &ListingTextView::addressChanged, this, &DisassemblerView::displayAddress);
+    connect(ui->disassemblerTextView, &ListingTextView::addressChanged, this, &DisassemblerView::displayInstructionReferences);
+    connect(ui->disassemblerTextView, &ListingTextView::symbolAddressChanged, this, &DisassemblerView::displayReferences);
+    connect(ui->disassemblerTextView, &ListingTextView::symbolDeselected, this->_referencesmodel, &ReferencesModel::clear);
+    connect(ui->disassemblerTextView, &ListingTextView::canGoBackChanged, [this]() { ui->tbBack->setEnabled(ui->disassemblerTextView->canGoBack()); });
+    connect(ui->disassemblerTextView, &ListingTextView::canGoForwardChanged, [this]() { ui->tbForward->setEnabled(ui->disassemblerTextView->canGoForward()); });
+
+    connect(ui->tbBack, &QToolButton::clicked, ui->disassemblerTextView, &ListingTextView::goBack);
+    connect(ui->tbForward, &QToolButton::clicked, ui->disassemblerTextView, &ListingTextView::goForward);
     connect(ui->tbGoto, &QToolButton::clicked, this, &DisassemblerView::showGoto);
+    connect(ui->tbPause, &QToolButton::toggled, this, &DisassemblerView::pausePasses);
+    connect(ui->tbStop, &QToolButton::clicked, this, &DisassemblerView::stopPasses);
+    connect(this->_passestimer, &QTimer::timeout, this, &DisassemblerView::runPasses);
+    connect(this->_progresstimer, &QTimer::timeout, this, &DisassemblerView::displayProgress);
 
     connect(ui->tvReferences, &QTreeView::doubleClicked, this, &DisassemblerView::gotoXRef);
     connect(ui->tvFunctions, &QTreeView::doubleClicked, this, &DisassemblerView::gotoSymbol);
@@ -109,25 +119,40 @@ DisassemblerView::~DisassemblerView()
 {
     delete ui;
 
+    // Child views are subscribed to the disassembler's journal: destroy them first
+    qDeleteAll(this->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly));
+
     if(this->_disassembler)
         delete this->_disassembler;
 }
 
-void DisassemblerView::setDisassembler(REDasm::Disassembler *disassembler)
+void DisassemblerView::setDisassembler(REDasm::Disassembler *disassembler, const std::shared_ptr<REDasm::MappedFile> &mappedfile)
 {
     this->_disassembler = disassembler;
+    this->_mappedfile = mappedfile;
     this->log(QString("Found format '%1' with '%2'").arg(S_TO_QS(disassembler->format()->name()),
                                                          S_TO_QS(disassembler->assembler()->name())));
 
+    // QHexDocument owns a copy of its data and takes an 'int' length: the mapping backs the disassembler only
     REDasm::Buffer& buffer = disassembler->buffer();
-    this->_hexdocument = QHexDocument::fromMemory(reinterpret_cast<const char*>(buffer.data), buffer.length);
+    int hexlength = static_cast<int>(std::min<s64>(buffer.length, std::numeric_limits<int>::max()));
+
+    if(hexlength < buffer.length)
+        this->log(QString("Hex view limited to the first %1 bytes").arg(hexlength));
+
+    this->_hexdocument = QHexDocument::fromMemory(reinterpret_cast<const char*>(buffer.data), hexlength);
     this->_hexdocument->setParent(this);
 
     ui->hexEdit->setDocument(this->_hexdocument);
     ui->bottomTabs->setCurrentWidget(ui->tabOutput);
     ui->disassemblerGraphView->setDisassembler(disassembler);
 
-    this->_disassemblerthread = new DisassemblerThread(disassembler, this);
+    bool lazy = buffer.length >= LAZY_THRESHOLD;
+
+    if(lazy)
+        this->log("Large image: lazy mode enabled, unexplored code is analyzed in background");
+
+    this->_disassemblerthread = new DisassemblerThread(disassembler, lazy, this);
 
     connect(this->_disassemblerthread, &DisassemblerThread::finished, this, &DisassemblerView::showListing);
 
@@ -137,6 +162,9 @@ void DisassemblerView::setDisassembler(REDasm::Disassembler *disassembler)
     });
 
     this->_disassemblerthread->start();
+    this->_progresstimer->start(PROGRESS_RATE);
+    ui->tbPause->setEnabled(true);
+    ui->tbStop->setEnabled(true);
 }
 
 bool DisassemblerView::busy() const
@@ -222,7 +250,7 @@ void DisassemblerView::xrefSymbol(const QModelIndex &index)
 
     if(!this->_disassembler->hasReferences(symbol))
     {
-        QMessageBox::information(this, "No References", "There are no references to " + S_TO_QS(symbol->name));
+        QMessageBox::information(this, "No References", "There are no references to " + S_TO_QS(symbol->displayName()));
         return;
     }
 
@@ -248,7 +276,7 @@ void DisassemblerView::displayAddress(address_t address)
     QString s = QString("<b>%1:%2</b>\u00A0\u00A0[%3]\u00A0\u00A0<b>%4%5</b>").arg(segment ? S_TO_QS(segment->name) : "unk",
                                                                                    S_TO_QS(REDasm::hex(address, bits, false)),
                                                                                    S_TO_QS(REDasm::hex(offset, bits, false)),
-                                                                                   symbol ? S_TO_QS(symbol->name) : QString(),
+                                                                                   symbol ? S_TO_QS(symbol->displayName()) : QString(),
                                                                                    soffset);
 
     this->_lblstatus->setText(s);
@@ -274,26 +302,6 @@ void DisassemblerView::displayReferences()
     this->_referencesmodel->xref(ui->disassemblerTextView->currentAddress(), symbol);
 }
 
-void DisassemblerView::updateModel(const REDasm::SymbolPtr &symbol)
-{
-    if(!symbol)
-    {
-        this->_functionsmodel->reloadSymbols();
-        this->_stringsmodel->reloadSymbols();
-        return;
-    }
-
-    if(symbol->isFunction())
-    {
-        this->_functionsmodel->reloadSymbols();
-        this->_exportsmodel->reloadSymbols();
-    }
-    else if(symbol->is(REDasm::SymbolTypes::ImportMask))
-        this->_importsmodel->reloadSymbols();
-    else if(symbol->is(REDasm::SymbolTypes::String))
-        this->_stringsmodel->reloadSymbols();
-}
-
 void DisassemblerView::log(const QString &s)
 {
     ui->pteOutput->insertPlainText(s + "\n");
@@ -348,9 +356,80 @@ void DisassemblerView::showListing()
     ui->tbGoto->setEnabled(true);
     ui->leFunctionFilter->setEnabled(true);
 
+    if(this->_disassembler->hasPendingPasses()) // Lazy mode: keep on analyzing in GUI's idle time
+    {
+        if(!ui->tbPause->isChecked())
+            this->_passestimer->start(0);
+    }
+    else
+    {
+        ui->tbPause->setEnabled(false);
+        ui->tbStop->setEnabled(false);
+    }
+
     emit done();
 }
 
+void DisassemblerView::runPasses()
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    while(this->_disassembler->runPendingPasses(PASSES_BUDGET))
+    {
+        if(elapsed.elapsed() >= PASSES_SLICE)
+            return;
+    }
+
+    this->_passestimer->stop();
+    ui->tbPause->setEnabled(false);
+    ui->tbStop->setEnabled(false);
+    this->log("Background analysis finished");
+}
+
+void DisassemblerView::pausePasses(bool paused)
+{
+    if(paused)
+    {
+        this->_disassembler->pausePasses();
+        this->_passestimer->stop();
+        return;
+    }
+
+    this->_disassembler->resumePasses();
+
+    if(!this->_disassemblerthread && this->_disassembler->hasPendingPasses())
+        this->_passestimer->start(0);
+}
+
+void DisassemblerView::stopPasses()
+{
+    this->_disassembler->cancelPasses();
+    ui->tbPause->setChecked(false);
+    ui->tbStop->setEnabled(false);
+
+    if(!this->_disassemblerthread) // Otherwise the thread will notice it by itself
+        this->runPasses();
+}
+
+void DisassemblerView::displayProgress()
+{
+    REDasm::ProgressInfo info = this->_disassembler->progress()->sample();
+    QString s = S_TO_QS(REDasm::Progress::phaseName(info.phase));
+
+    if(info.total)
+        s += QString(" %1%").arg((info.processed * 100) / info.total);
+
+    if(info.throughput > 0)
+        s += QString(" @ %1 KiB/s").arg(info.throughput / 1024, 0, 'f', 1);
+
+    s += QString(", %1 function(s)").arg(info.functions);
+    this->_lblstatus->setText(s);
+
+    if(info.is(REDasm::ProgressPhases::Done))
+        this->_progresstimer->stop();
+}
+
 void DisassemblerView::showHexDump(address_t address)
 {
     ui->topTabs->setCurrentWidget(ui->hexEdit);
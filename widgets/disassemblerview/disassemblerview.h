@@ -3,6 +3,7 @@
 
 #include <QWidget>
 #include <QLabel>
+#include <QTimer>
 #include <QMenu>
 #include <qhexedit.h>
 #include "../../models/symboltablefiltermodel.h"
@@ -10,6 +11,7 @@
 #include "../../models/segmentsmodel.h"
 #include "../../dialogs/gotodialog.h"
 #include "../../redasm/disassembler/disassembler.h"
+#include "../../redasm/support/mappedfile.h"
 #include "disassemblerthread.h"
 
 namespace Ui {
@@ -23,7 +25,7 @@ class DisassemblerView : public QWidget
     public:
         explicit DisassemblerView(QLabel* lblstatus, QWidget *parent = 0);
         ~DisassemblerView();
-        void setDisassembler(REDasm::Disassembler* disassembler);
+        void setDisassembler(REDasm::Disassembler* disassembler, const std::shared_ptr<REDasm::MappedFile>& mappedfile);
         bool busy() const;
 
     private slots:
@@ -35,7 +37,6 @@ class DisassemblerView : public QWidget
         void displayAddress(address_t address);
         void displayInstructionReferences();
         void displayReferences();
-        void updateModel(const REDasm::SymbolPtr& symbol);
         void log(const QString& s);
         void filterFunctions();
         void filterSymbols();
@@ -43,6 +44,10 @@ class DisassemblerView : public QWidget
         void showHexDump(address_t address);
         void showMenu(const QPoint&);
         void showGoto();
+        void runPasses();
+        void pausePasses(bool paused);
+        void stopPasses();
+        void displayProgress();
 
     private:
         void createMenu();
@@ -57,7 +62,9 @@ class DisassemblerView : public QWidget
         QMenu* _contextmenu;
         QLabel* _lblstatus;
         REDasm::Disassembler* _disassembler;
+        std::shared_ptr<REDasm::MappedFile> _mappedfile; // Released after the disassembler
         DisassemblerThread* _disassemblerthread;
+        QTimer *_passestimer, *_progresstimer;
         SymbolTableFilterModel *_functionsmodel, *_importsmodel, *_exportsmodel, *_stringsmodel;
         ReferencesModel* _referencesmodel;
         SegmentsModel* _segmentsmodel;
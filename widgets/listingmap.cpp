@@ -4,16 +4,31 @@
 
 #define SCALE_TO_WIDGET(v, w) std::ceil((v * w) / static_cast<double>(this->_size))
 
-ListingMap::ListingMap(QWidget *parent) : QWidget(parent), _size(0)
+ListingMap::ListingMap(QWidget *parent) : QWidget(parent), _size(0), _disassembler(NULL), _subscription(0)
 {
 
 }
 
+ListingMap::~ListingMap()
+{
+    if(this->_disassembler)
+        this->_disassembler->journal()->unsubscribe(this->_subscription);
+}
+
 void ListingMap::render(REDasm::Disassembler* disassembler)
 {
     u64 reloffset = 0;
     const REDasm::SegmentList& segments = disassembler->format()->segments();
 
+    if(this->_disassembler != disassembler)
+    {
+        if(this->_disassembler)
+            this->_disassembler->journal()->unsubscribe(this->_subscription);
+
+        this->_disassembler = disassembler;
+        this->_subscription = disassembler->journal()->subscribe([this](const REDasm::Change& change) { this->applyChange(change); });
+    }
+
     this->_size = 0;
     this->_segments.clear();
     this->_functions.clear();
@@ -41,31 +56,59 @@ void ListingMap::render(REDasm::Disassembler* disassembler)
     this->_size = reloffset;
 
     disassembler->symbolTable()->iterate(REDasm::SymbolTypes::FunctionMask, [this, disassembler](REDasm::SymbolPtr symbol) -> bool {
-        const Item* segmentitem = this->segmentBase(disassembler, symbol);
+        this->renderFunction(disassembler, symbol);
+        return true;
+    });
 
-        if(!segmentitem)
-            return true;
+    this->update();
+}
 
-        std::string sig = disassembler->listing().getSignature(symbol);
+void ListingMap::applyChange(const REDasm::Change &change)
+{
+    if(change.is(REDasm::ChangeTypes::SymbolErased))
+    {
+        if(!this->_functions.remove(change.address))
+            return;
+    }
+    else if(change.is(REDasm::ChangeTypes::FunctionBoundsChanged) || change.is(REDasm::ChangeTypes::SymbolRenamed))
+    {
+        REDasm::SymbolPtr symbol = this->_disassembler->symbolTable()->symbol(change.address);
 
-        if(sig.empty())
-            return true;
+        if(!symbol || !symbol->isFunction())
+            return;
 
-        Item item;
-        item.address = symbol->address;
-        item.offset = segmentitem->offset + (symbol->address - segmentitem->address);
-        item.size = sig.size();
+        this->_functions.remove(change.address);
+        this->renderFunction(this->_disassembler, symbol);
+    }
+    else
+        return;
 
-        if(symbol->type & REDasm::SymbolTypes::Locked)
-            item.color = QColor(Qt::magenta);
-        else
-            item.color = QColor(Qt::blue);
+    this->update();
+}
 
-        this->_functions[symbol->address] = item;
-        return true;
-    });
+void ListingMap::renderFunction(REDasm::Disassembler *disassembler, const REDasm::SymbolPtr &symbol)
+{
+    const Item* segmentitem = this->segmentBase(disassembler, symbol);
 
-    this->update();
+    if(!segmentitem)
+        return;
+
+    std::string sig = disassembler->listing().getSignature(symbol);
+
+    if(sig.empty())
+        return;
+
+    Item item;
+    item.address = symbol->address;
+    item.offset = segmentitem->offset + (symbol->address - segmentitem->address);
+    item.size = sig.size();
+
+    if(symbol->type & REDasm::SymbolTypes::Locked)
+        item.color = QColor(Qt::magenta);
+    else
+        item.color = QColor(Qt::blue);
+
+    this->_functions[symbol->address] = item;
 }
 
 const ListingMap::Item* ListingMap::segmentBase(REDasm::Disassembler* disassembler, REDasm::SymbolPtr symbol) const
@@ -18,9 +18,12 @@ class ListingMap : public QWidget
 
     public:
         explicit ListingMap(QWidget *parent = 0);
+        ~ListingMap();
         void render(REDasm::Disassembler *disassembler);
 
     private:
+        void applyChange(const REDasm::Change& change);
+        void renderFunction(REDasm::Disassembler* disassembler, const REDasm::SymbolPtr& symbol);
         const Item *segmentBase(REDasm::Disassembler* disassembler, REDasm::SymbolPtr symbol) const;
 
     protected:
@@ -28,6 +31,8 @@ class ListingMap : public QWidget
 
     private:
         u64 _size;
+        REDasm::Disassembler* _disassembler;
+        REDasm::ChangeJournal::subscription_t _subscription;
         QMap<u64, Item> _segments;
         QMap<u64, Item> _functions;
 };
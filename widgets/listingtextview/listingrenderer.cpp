@@ -0,0 +1,285 @@
+#include "listingrenderer.h"
+#include "../disassemblerview/disassemblerdocument.h"
+#include "../../themeprovider.h"
+
+#define INDENT_COMMENT 10
+#define INDENT_WIDTH   2
+
+QString RendererLine::text() const
+{
+    QString s;
+
+    foreach(const RendererChunk& chunk, this->chunks)
+        s += chunk.text;
+
+    return s;
+}
+
+ListingRenderer::ListingRenderer(REDasm::Disassembler *disassembler, const REDasm::PrinterPtr &printer): _disassembler(disassembler), _printer(printer), _segment(NULL)
+{
+    this->_symbols = disassembler->symbolTable();
+}
+
+const REDasm::PrinterPtr &ListingRenderer::printer() const { return this->_printer; }
+
+void ListingRenderer::render(const REDasm::ListingItem &item, RendererLine &line)
+{
+    line.item = item;
+    line.chunks.clear();
+
+    if(item.is(REDasm::ListingItemTypes::FunctionItem))
+        this->renderFunction(item, line);
+    else if(item.is(REDasm::ListingItemTypes::PrologueItem))
+        this->renderPrologue(item, line);
+    else if(item.is(REDasm::ListingItemTypes::LabelItem))
+        this->renderLabel(item, line);
+    else if(item.is(REDasm::ListingItemTypes::InfoItem))
+        this->renderInfo(item, line);
+    else if(item.is(REDasm::ListingItemTypes::InstructionItem))
+        this->renderInstruction(item, line);
+    else if(item.is(REDasm::ListingItemTypes::SymbolItem))
+        this->renderSymbol(item, line);
+}
+
+void ListingRenderer::renderFunction(const REDasm::ListingItem &item, RendererLine &line)
+{
+    REDasm::SymbolPtr symbol = this->_symbols->symbol(item.address);
+
+    if(!symbol)
+        return;
+
+    QColor headercolor = THEME_VALUE("header_fg");
+    line.chunks << RendererChunk(QString(" ").repeated(this->getIndent(item.address)));
+
+    this->_printer->header(symbol, [this, &line, &headercolor, symbol](const std::string& pre, const std::string& sym, const std::string& post) {
+        if(!pre.empty())
+            line.chunks << RendererChunk(S_TO_QS(pre), headercolor);
+
+        RendererChunk chunk(S_TO_QS(sym), headercolor);
+        this->setMetaData(chunk, symbol);
+        line.chunks << chunk;
+
+        if(!post.empty())
+            line.chunks << RendererChunk(S_TO_QS(post), headercolor);
+    });
+}
+
+void ListingRenderer::renderPrologue(const REDasm::ListingItem &item, RendererLine &line)
+{
+    REDasm::SymbolPtr symbol = this->_symbols->symbol(item.address);
+
+    if(!symbol)
+        return;
+
+    u32 index = 0;
+
+    this->_printer->prologue(symbol, [this, &item, &line, &index](const std::string& s) {
+        if(index++ != item.index)
+            return;
+
+        line.chunks << RendererChunk(QString(" ").repeated(this->getIndent(item.address)));
+        line.chunks << RendererChunk(S_TO_QS(s));
+    });
+}
+
+void ListingRenderer::renderLabel(const REDasm::ListingItem &item, RendererLine &line)
+{
+    REDasm::SymbolPtr symbol = this->_symbols->symbol(item.address);
+
+    if(!symbol)
+        return;
+
+    RendererChunk chunk(S_TO_QS(symbol->displayName()) + ":", THEME_VALUE("label_fg"));
+    chunk.address = symbol->address;
+    chunk.action = DisassemblerDocument::LabelAction;
+    chunk.underline = true;
+
+    line.chunks << RendererChunk(QString(" ").repeated(this->getIndent(item.address) + INDENT_WIDTH));
+    line.chunks << chunk;
+}
+
+void ListingRenderer::renderInfo(const REDasm::ListingItem &item, RendererLine &line)
+{
+    REDasm::InstructionPtr instruction = this->_disassembler->listing()[item.address];
+    u32 index = 0;
+
+    this->_printer->info(instruction, [this, &item, &line, &index](const std::string& s) {
+        if(index++ != item.index)
+            return;
+
+        line.chunks << RendererChunk(QString(" ").repeated(this->getIndent(item.address)));
+        line.chunks << RendererChunk(S_TO_QS(s));
+    });
+}
+
+void ListingRenderer::renderInstruction(const REDasm::ListingItem &item, RendererLine &line)
+{
+    REDasm::InstructionPtr instruction = this->_disassembler->listing()[item.address];
+
+    this->renderAddress(instruction->address, line);
+
+    if(instruction->blockIs(REDasm::BlockTypes::Ignore))
+        line.chunks << RendererChunk("  ");
+    else if(instruction->blockIs(REDasm::BlockTypes::BlockStart))
+        line.chunks << RendererChunk("/ ");
+    else if(instruction->blockIs(REDasm::BlockTypes::BlockEnd))
+        line.chunks << RendererChunk("\\ ");
+    else
+        line.chunks << RendererChunk("| ");
+
+    this->renderMnemonic(instruction, line);
+    this->renderOperands(instruction, line);
+
+    if(instruction->comments.empty())
+        return;
+
+    line.chunks << RendererChunk(QString(" ").repeated(this->getIndent(instruction->address) + INDENT_COMMENT));
+    line.chunks << RendererChunk(S_TO_QS(this->_disassembler->comment(instruction)), THEME_VALUE("comment_fg"));
+}
+
+void ListingRenderer::renderSymbol(const REDasm::ListingItem &item, RendererLine &line)
+{
+    REDasm::SymbolPtr symbol = this->_symbols->symbol(item.address);
+
+    if(!symbol)
+        return;
+
+    this->_printer->symbol(symbol, [this, &line, &item](const REDasm::SymbolPtr& symbol, const std::string& value) {
+        if(symbol->address != item.address) // Skip pointed symbols, they have their own row
+            return;
+
+        this->renderAddress(symbol->address, line);
+
+        RendererChunk namechunk(S_TO_QS(symbol->displayName()) + " ", THEME_VALUE("label_fg"));
+        namechunk.address = symbol->address;
+        namechunk.action = DisassemblerDocument::GotoAction;
+        line.chunks << namechunk;
+
+        RendererChunk valuechunk(S_TO_QS(value));
+
+        if(symbol->is(REDasm::SymbolTypes::String))
+            valuechunk.color = THEME_VALUE("string_fg");
+        else if(!symbol->is(REDasm::SymbolTypes::Pointer))
+            valuechunk.color = THEME_VALUE("data_fg");
+        else
+        {
+            REDasm::SymbolPtr ptrsymbol = this->_disassembler->dereferenceSymbol(symbol);
+
+            if(ptrsymbol)
+            {
+                valuechunk.address = ptrsymbol->address;
+                valuechunk.action = DisassemblerDocument::GotoAction;
+            }
+        }
+
+        line.chunks << valuechunk;
+    });
+}
+
+void ListingRenderer::renderAddress(address_t address, RendererLine &line)
+{
+    const REDasm::Segment* segment = this->getSegment(address);
+    QString segmentname = segment ? S_TO_QS(segment->name) : "unk";
+    QString hexaddress = S_TO_QS(REDasm::hex(address, this->_disassembler->format()->bits(), false));
+
+    line.chunks << RendererChunk(QString("%1:%2 ").arg(segmentname, hexaddress), THEME_VALUE("address_fg"));
+    line.chunks << RendererChunk(QString(" ").repeated(INDENT_WIDTH + 2));
+}
+
+void ListingRenderer::renderMnemonic(const REDasm::InstructionPtr &instruction, RendererLine &line)
+{
+    RendererChunk chunk(S_TO_QS(instruction->mnemonic) + " ");
+
+    if(instruction->isInvalid())
+        chunk.color = THEME_VALUE("instruction_invalid");
+    else if(instruction->is(REDasm::InstructionTypes::Stop))
+        chunk.color = THEME_VALUE("instruction_stop");
+    else if(instruction->is(REDasm::InstructionTypes::Nop))
+        chunk.color = THEME_VALUE("instruction_nop");
+    else if(instruction->is(REDasm::InstructionTypes::Call))
+        chunk.color = THEME_VALUE("instruction_call");
+    else if(instruction->is(REDasm::InstructionTypes::Jump))
+    {
+        if(instruction->is(REDasm::InstructionTypes::Conditional))
+            chunk.color = THEME_VALUE("instruction_jmp_c");
+        else
+            chunk.color = THEME_VALUE("instruction_jmp");
+    }
+
+    line.chunks << chunk;
+}
+
+void ListingRenderer::renderOperands(const REDasm::InstructionPtr &instruction, RendererLine &line)
+{
+    this->_printer->out(instruction, [this, &line](const REDasm::Operand& operand, const std::string& opsize, const std::string& opstr) {
+        if(operand.index > 0)
+            line.chunks << RendererChunk(", ");
+
+        if(!opsize.empty())
+            line.chunks << RendererChunk(S_TO_QS(opsize) + " ");
+
+        RendererChunk chunk(S_TO_QS(opstr));
+
+        if(operand.isNumeric())
+        {
+            REDasm::SymbolPtr symbol = this->_symbols->symbol(operand.u_value);
+
+            if(symbol)
+            {
+                if(symbol->is(REDasm::SymbolTypes::Pointer))
+                {
+                    REDasm::SymbolPtr ptrsymbol = this->_disassembler->dereferenceSymbol(symbol);
+
+                    if(ptrsymbol)
+                        symbol = ptrsymbol;
+                }
+
+                this->setMetaData(chunk, symbol);
+            }
+            else if(operand.is(REDasm::OperandTypes::Memory))
+                chunk.color = THEME_VALUE("memory_fg");
+            else
+                chunk.color = THEME_VALUE("immediate_fg");
+        }
+        else if(operand.is(REDasm::OperandTypes::Displacement))
+            chunk.color = THEME_VALUE("displacement_fg");
+        else if(operand.is(REDasm::OperandTypes::Register))
+            chunk.color = THEME_VALUE("register_fg");
+
+        line.chunks << chunk;
+    });
+}
+
+void ListingRenderer::setMetaData(RendererChunk &chunk, const REDasm::SymbolPtr &symbol)
+{
+    if(symbol->is(REDasm::SymbolTypes::Code))
+        chunk.color = THEME_VALUE("header_fg");
+    else if(symbol->is(REDasm::SymbolTypes::String))
+        chunk.color = THEME_VALUE("string_fg");
+    else
+        chunk.color = THEME_VALUE("data_fg");
+
+    chunk.address = symbol->address;
+    chunk.action = DisassemblerDocument::GotoAction;
+    chunk.underline = true;
+}
+
+const REDasm::Segment *ListingRenderer::getSegment(address_t address)
+{
+    if(this->_segment && this->_segment->contains(address))
+        return this->_segment;
+
+    this->_segment = this->_disassembler->format()->segment(address);
+    return this->_segment;
+}
+
+int ListingRenderer::getIndent(address_t address)
+{
+    const REDasm::Segment* segment = this->getSegment(address);
+    int width = this->_disassembler->format()->bits() / 4;
+
+    if(segment)
+        width += segment->name.length();
+
+    return width + INDENT_WIDTH;
+}
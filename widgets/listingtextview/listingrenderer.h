@@ -0,0 +1,60 @@
+#ifndef LISTINGRENDERER_H
+#define LISTINGRENDERER_H
+
+#include <QString>
+#include <QColor>
+#include <QList>
+#include "../../redasm/disassembler/disassembler.h"
+#include "../../redasm/disassembler/types/listingindex.h"
+
+struct RendererChunk
+{
+    RendererChunk(): address(0), action(0), underline(false) { }
+    RendererChunk(const QString& text, const QColor& color = QColor()): text(text), color(color), address(0), action(0), underline(false) { }
+
+    QString text;
+    QColor color;
+    address_t address;
+    int action;
+    bool underline;
+};
+
+struct RendererLine
+{
+    RendererLine(): row(0) { }
+    QString text() const;
+
+    size_t row;
+    REDasm::ListingItem item;
+    QList<RendererChunk> chunks;
+};
+
+class ListingRenderer // Formats a single listing row through the assembler's Printer
+{
+    public:
+        ListingRenderer(REDasm::Disassembler* disassembler, const REDasm::PrinterPtr& printer);
+        const REDasm::PrinterPtr& printer() const;
+        void render(const REDasm::ListingItem& item, RendererLine& line);
+
+    private:
+        void renderFunction(const REDasm::ListingItem& item, RendererLine& line);
+        void renderPrologue(const REDasm::ListingItem& item, RendererLine& line);
+        void renderLabel(const REDasm::ListingItem& item, RendererLine& line);
+        void renderInfo(const REDasm::ListingItem& item, RendererLine& line);
+        void renderInstruction(const REDasm::ListingItem& item, RendererLine& line);
+        void renderSymbol(const REDasm::ListingItem& item, RendererLine& line);
+        void renderAddress(address_t address, RendererLine& line);
+        void renderMnemonic(const REDasm::InstructionPtr& instruction, RendererLine& line);
+        void renderOperands(const REDasm::InstructionPtr& instruction, RendererLine& line);
+        void setMetaData(RendererChunk& chunk, const REDasm::SymbolPtr& symbol);
+        const REDasm::Segment *getSegment(address_t address);
+        int getIndent(address_t address);
+
+    private:
+        REDasm::Disassembler* _disassembler;
+        REDasm::SymbolTable* _symbols;
+        REDasm::PrinterPtr _printer;
+        REDasm::Segment* _segment;
+};
+
+#endif // LISTINGRENDERER_H
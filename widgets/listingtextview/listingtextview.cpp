@@ -0,0 +1,541 @@
+#include "listingtextview.h"
+#include "../disassemblerview/disassemblerdocument.h"
+#include "../../dialogs/referencesdialog.h"
+#include "../../dialogs/callgraphdialog.h"
+#include "../../themeprovider.h"
+#include <QFontDatabase>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QApplication>
+#include <QMouseEvent>
+#include <QScrollBar>
+#include <QClipboard>
+#include <QPainter>
+#include <QAction>
+
+#define LINE_MARGIN 2
+
+ListingTextView::ListingTextView(QWidget *parent): QAbstractScrollArea(parent), _issymboladdressvalid(false), _currentrow(0), _disassembler(NULL), _subscription(0), _currentaddress(INT64_MAX), _symboladdress(0)
+{
+    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    font.setPointSize(12);
+    font.setStyleHint(QFont::TypeWriter);
+
+    this->setFont(font);
+    this->setFocusPolicy(Qt::StrongFocus);
+    this->setContextMenuPolicy(Qt::CustomContextMenu);
+    this->setFrameStyle(QFrame::NoFrame);
+    this->createContextMenu();
+
+    viewport()->setCursor(Qt::ArrowCursor);
+
+    connect(this->verticalScrollBar(), &QScrollBar::valueChanged, [this](int) { this->viewport()->update(); });
+    connect(this->horizontalScrollBar(), &QScrollBar::valueChanged, [this](int) { this->viewport()->update(); });
+
+    connect(this, &ListingTextView::customContextMenuRequested, [this](const QPoint&) {
+        this->_contextmenu->exec(QCursor::pos());
+    });
+}
+
+ListingTextView::~ListingTextView()
+{
+    if(this->_disassembler)
+        this->_disassembler->journal()->unsubscribe(this->_subscription);
+}
+
+bool ListingTextView::canGoBack() const
+{
+    return !this->_backstack.isEmpty();
+}
+
+bool ListingTextView::canGoForward() const
+{
+    return !this->_forwardstack.isEmpty();
+}
+
+address_t ListingTextView::currentAddress() const
+{
+    return this->_currentaddress;
+}
+
+address_t ListingTextView::symbolAddress() const
+{
+    return this->_symboladdress;
+}
+
+void ListingTextView::setDisassembler(REDasm::Disassembler *disassembler)
+{
+    REDasm::PrinterPtr printer(disassembler->assembler()->createPrinter(disassembler, disassembler->symbolTable()));
+
+    if(this->_disassembler)
+        this->_disassembler->journal()->unsubscribe(this->_subscription);
+
+    this->_disassembler = disassembler;
+    this->_subscription = disassembler->journal()->subscribe([this](const REDasm::Change& change) { this->applyChange(change); });
+    this->_renderer = std::make_unique<ListingRenderer>(disassembler, printer);
+    this->_index.build(disassembler->listing(), printer);
+    this->adjustScrollBars();
+
+    REDasm::SymbolPtr symbol = disassembler->symbolTable()->entryPoint();
+
+    if(!symbol)
+    {
+        disassembler->symbolTable()->iterate(REDasm::SymbolTypes::FunctionMask, [&symbol](const REDasm::SymbolPtr& s) -> bool {
+            symbol = s;
+            return false;
+        });
+    }
+
+    if(symbol)
+        this->display(symbol->address);
+}
+
+void ListingTextView::goTo(const REDasm::SymbolPtr &symbol)
+{
+    this->goTo(symbol->address);
+}
+
+void ListingTextView::goTo(address_t address)
+{
+    if(this->_currentaddress != address)
+    {
+        this->_backstack.push(this->_currentaddress);
+        emit canGoBackChanged();
+    }
+
+    this->display(address);
+}
+
+void ListingTextView::rename(address_t address)
+{
+    if(!this->_issymboladdressvalid)
+        return;
+
+    REDasm::SymbolTable* symboltable = this->_disassembler->symbolTable();
+    REDasm::SymbolPtr symbol = symboltable->symbol(address);
+
+    if(!symbol)
+        return;
+
+    QString sym = S_TO_QS(symbol->name), s = QInputDialog::getText(this, QString("Rename %1").arg(sym), "Symbol name:", QLineEdit::Normal, sym);
+
+    if(s.isEmpty())
+        return;
+
+    REDasm::SymbolPtr checksymbol = symboltable->symbol(s.toStdString());
+
+    if(checksymbol)
+    {
+        QMessageBox::warning(this, "Rename failed", "Duplicate symbol name");
+        this->rename(address);
+        return;
+    }
+
+    std::string newsym = s.simplified().replace(" ", "_").toStdString();
+
+    if(s.simplified().isEmpty() || !symboltable->update(symbol, newsym))
+        return;
+
+    emit symbolRenamed(symbol);
+}
+
+void ListingTextView::goBack()
+{
+    if(this->_backstack.isEmpty())
+        return;
+
+    address_t address = this->_backstack.pop();
+    this->_forwardstack.push(this->_currentaddress);
+
+    emit canGoBackChanged();
+    emit canGoForwardChanged();
+    this->display(address);
+}
+
+void ListingTextView::goForward()
+{
+    if(this->_forwardstack.isEmpty())
+        return;
+
+    address_t address = this->_forwardstack.pop();
+    this->_backstack.push(this->_currentaddress);
+
+    emit canGoBackChanged();
+    emit canGoForwardChanged();
+    this->display(address);
+}
+
+void ListingTextView::paintEvent(QPaintEvent *)
+{
+    if(!this->_renderer)
+        return;
+
+    QPainter painter(this->viewport());
+    QFontMetrics fm = this->fontMetrics();
+    int lh = this->lineHeight(), xoffset = -this->horizontalScrollBar()->value(), maxwidth = 0;
+    size_t firstrow = this->verticalScrollBar()->value();
+    size_t lastrow = std::min(this->_index.size(), firstrow + this->visibleRows() + 1);
+    QColor highlightcolor = ThemeProvider::highlightColor(), seekcolor = ThemeProvider::seekColor();
+
+    this->_visiblelines.clear();
+    painter.setFont(this->font());
+
+    for(size_t row = firstrow; row < lastrow; row++)
+    {
+        RendererLine line;
+        line.row = row;
+        this->_renderer->render(this->_index.at(row), line);
+
+        int y = (row - firstrow) * lh, x = xoffset;
+
+        if(row == this->_currentrow)
+            painter.fillRect(0, y, this->viewport()->width(), lh, this->palette().alternateBase());
+
+        for(int i = 0; i < line.chunks.size(); i++)
+        {
+            const RendererChunk& chunk = line.chunks.at(i);
+            int w = fm.width(chunk.text);
+
+            if(!this->_currentword.isEmpty() && (chunk.text.trimmed() == this->_currentword))
+                painter.fillRect(x, y, w, lh, highlightcolor);
+
+            QFont font = this->font();
+            font.setUnderline(chunk.underline);
+            painter.setFont(font);
+
+            if((row == this->_currentrow) && !i && line.item.is(REDasm::ListingItemTypes::InstructionItem))
+                painter.setPen(seekcolor);
+            else
+                painter.setPen(chunk.color.isValid() ? chunk.color : this->palette().color(QPalette::Text));
+
+            painter.drawText(x, y + fm.ascent() + (LINE_MARGIN / 2), chunk.text);
+            x += w;
+        }
+
+        maxwidth = std::max(maxwidth, x - xoffset);
+        this->_visiblelines.append(line);
+    }
+
+    // Grow the horizontal range lazily: we only know the widths of the rows that have been rendered
+    if(maxwidth > this->horizontalScrollBar()->maximum() + this->viewport()->width())
+        this->horizontalScrollBar()->setMaximum(maxwidth - this->viewport()->width());
+}
+
+void ListingTextView::resizeEvent(QResizeEvent *e)
+{
+    QAbstractScrollArea::resizeEvent(e);
+    this->adjustScrollBars();
+}
+
+void ListingTextView::mousePressEvent(QMouseEvent *e)
+{
+    size_t row = 0;
+    const RendererChunk* chunk = this->chunkAt(e->pos(), &row);
+
+    if(row < this->_index.size())
+        this->setCurrentRow(row);
+
+    if(chunk)
+        this->_currentword = chunk->text.trimmed();
+
+    if(!chunk || !chunk->action)
+    {
+        this->_issymboladdressvalid = false;
+        emit symbolDeselected();
+    }
+    else
+        this->updateSymbolAddress(chunk->address);
+
+    this->viewport()->update();
+    QAbstractScrollArea::mousePressEvent(e);
+}
+
+void ListingTextView::mouseDoubleClickEvent(QMouseEvent *e)
+{
+    QAbstractScrollArea::mouseDoubleClickEvent(e);
+
+    const RendererChunk* chunk = this->chunkAt(e->pos());
+
+    if(!chunk || !chunk->action)
+        return;
+
+    if(chunk->action == DisassemblerDocument::LabelAction)
+        this->checkLabel(chunk->address);
+    else
+        this->goTo(chunk->address);
+}
+
+void ListingTextView::keyPressEvent(QKeyEvent *e)
+{
+    if(this->_index.empty())
+        return;
+
+    size_t row = this->_currentrow, pagerows = std::max<size_t>(1, this->visibleRows());
+
+    if(e->key() == Qt::Key_Up)
+        row = row ? row - 1 : 0;
+    else if(e->key() == Qt::Key_Down)
+        row = std::min(row + 1, this->_index.size() - 1);
+    else if(e->key() == Qt::Key_PageUp)
+        row = (row > pagerows) ? row - pagerows : 0;
+    else if(e->key() == Qt::Key_PageDown)
+        row = std::min(row + pagerows, this->_index.size() - 1);
+    else if(e->key() == Qt::Key_Home)
+        row = 0;
+    else if(e->key() == Qt::Key_End)
+        row = this->_index.size() - 1;
+    else if(e->key() == Qt::Key_X)
+    {
+        if(this->_issymboladdressvalid)
+            this->showReferences(this->_symboladdress);
+
+        return;
+    }
+    else if(e->key() == Qt::Key_N)
+    {
+        this->rename(this->_symboladdress);
+        return;
+    }
+    else
+    {
+        QAbstractScrollArea::keyPressEvent(e);
+        return;
+    }
+
+    this->setCurrentRow(row);
+    this->ensureRowVisible(row);
+}
+
+void ListingTextView::createContextMenu()
+{
+    this->_contextmenu = new QMenu(this);
+
+    this->_actrename = this->_contextmenu->addAction("Rename", [this]() { this->rename(this->_symboladdress);} );
+
+    this->_actcreatestring = this->_contextmenu->addAction("Create String", [this]() {
+        if(!this->_disassembler->dataToString(this->_symboladdress))
+            return;
+
+        emit invalidateSymbols();
+    });
+
+    this->_contextmenu->addSeparator();
+    this->_actxrefs = this->_contextmenu->addAction("Cross References", [this]() { this->showReferences(this->_symboladdress); });
+    this->_actfollow = this->_contextmenu->addAction("Follow", [this]() { this->goTo(this->_symboladdress); });
+    this->_actgoto = this->_contextmenu->addAction("Goto...", this, &ListingTextView::gotoRequested);
+    this->_actcallgraph = this->_contextmenu->addAction("Call Graph", [this]() { this->showCallGraph(this->_symboladdress); });
+    this->_acthexdump = this->_contextmenu->addAction("Hex Dump", [this]() { emit hexDumpRequested(this->_symboladdress); });
+    this->_contextmenu->addSeparator();
+    this->_actback = this->_contextmenu->addAction("Back", this, &ListingTextView::goBack);
+    this->_actforward = this->_contextmenu->addAction("Forward", this, &ListingTextView::goForward);
+    this->_contextmenu->addSeparator();
+
+    this->_actcopy = this->_contextmenu->addAction("Copy", [this]() {
+        foreach(const RendererLine& line, this->_visiblelines)
+        {
+            if(line.row == this->_currentrow)
+                qApp->clipboard()->setText(line.text());
+        }
+    });
+
+    connect(this->_contextmenu, &QMenu::aboutToShow, this, &ListingTextView::adjustContextMenu);
+}
+
+void ListingTextView::adjustContextMenu()
+{
+    this->_actback->setVisible(this->canGoBack());
+    this->_actforward->setVisible(this->canGoForward());
+
+    if(!this->_issymboladdressvalid)
+    {
+        this->_actrename->setVisible(false);
+        this->_actcreatestring->setVisible(false);
+        this->_actxrefs->setVisible(false);
+        this->_actfollow->setVisible(false);
+        this->_actcallgraph->setVisible(false);
+        this->_acthexdump->setVisible(false);
+        return;
+    }
+
+    REDasm::Segment* segment = this->_disassembler->format()->segment(this->_symboladdress);
+    REDasm::SymbolPtr symbol = this->_disassembler->symbolTable()->symbol(this->_symboladdress);
+
+    this->_actrename->setVisible(symbol != NULL);
+    this->_actcallgraph->setVisible(symbol && symbol->isFunction());
+
+    if((segment && segment->is(REDasm::SegmentTypes::Data)) && (symbol && !symbol->isFunction() && symbol->is(REDasm::SymbolTypes::Data)))
+        this->_actcreatestring->setVisible(this->_disassembler->locationIsString(this->_symboladdress) > 1);
+    else
+        this->_actcreatestring->setVisible(false);
+
+    this->_actxrefs->setVisible(symbol != NULL);
+    this->_actfollow->setVisible(symbol && (symbol->is(REDasm::SymbolTypes::Code)));
+    this->_acthexdump->setVisible(segment && !segment->is(REDasm::SegmentTypes::Bss));
+}
+
+void ListingTextView::adjustScrollBars()
+{
+    size_t rows = this->_index.size(), visiblerows = this->visibleRows();
+
+    this->verticalScrollBar()->setPageStep(visiblerows);
+    this->verticalScrollBar()->setRange(0, (rows > visiblerows) ? rows - visiblerows : 0);
+    this->horizontalScrollBar()->setPageStep(this->viewport()->width());
+    this->viewport()->update();
+}
+
+void ListingTextView::applyChange(const REDasm::Change &change)
+{
+    if(change.is(REDasm::ChangeTypes::SymbolRenamed) || change.is(REDasm::ChangeTypes::InstructionUpdated) || change.is(REDasm::ChangeTypes::ReferenceAdded))
+    {
+        this->viewport()->update(); // Rows are rendered on demand: just repaint
+        return;
+    }
+
+    if(change.is(REDasm::ChangeTypes::SymbolCreated))
+    {
+        REDasm::SymbolPtr symbol = this->_disassembler->symbolTable()->symbol(change.address);
+
+        if(!symbol || symbol->is(REDasm::SymbolTypes::Code)) // Code rows are handled by FunctionBoundsChanged
+            return;
+
+        this->_index.insert(change.address, REDasm::ListingItemTypes::SymbolItem);
+    }
+    else if(change.is(REDasm::ChangeTypes::SymbolErased))
+        this->_index.remove(change.address);
+    else if(change.is(REDasm::ChangeTypes::FunctionBoundsChanged))
+        this->_index.updateFunction(this->_disassembler->listing(), change.address, this->_renderer->printer());
+    else
+        return;
+
+    if(!this->_index.empty()) // Rows have been shifted, follow the current address
+        this->_currentrow = this->_index.rowOf(this->_currentaddress);
+
+    this->adjustScrollBars();
+}
+
+void ListingTextView::display(address_t address)
+{
+    if(!this->_renderer)
+        return;
+
+    this->_disassembler->disassembleOnDemand(address); // Lazy mode: disassemble what the user asks for
+
+    size_t row = 0;
+
+    if(!this->_index.indexOf(address, &row))
+        return;
+
+    this->setCurrentRow(row);
+
+    int firstrow = std::max<int>(0, static_cast<int>(row) - static_cast<int>(this->visibleRows() / 2)); // Center on jump
+    this->verticalScrollBar()->setValue(firstrow);
+    this->viewport()->update();
+}
+
+void ListingTextView::setCurrentRow(size_t row)
+{
+    this->_currentrow = row;
+    this->viewport()->update();
+
+    address_t address = this->_index.at(row).address;
+
+    if(address == this->_currentaddress)
+        return;
+
+    this->_currentaddress = address;
+    emit addressChanged(this->_currentaddress);
+}
+
+void ListingTextView::ensureRowVisible(size_t row)
+{
+    size_t firstrow = this->verticalScrollBar()->value(), visiblerows = this->visibleRows();
+
+    if(row < firstrow)
+        this->verticalScrollBar()->setValue(row);
+    else if(visiblerows && (row >= firstrow + visiblerows))
+        this->verticalScrollBar()->setValue(row - visiblerows + 1);
+}
+
+void ListingTextView::updateSymbolAddress(address_t address)
+{
+    this->_issymboladdressvalid = true;
+    this->_symboladdress = address;
+    emit symbolAddressChanged();
+}
+
+void ListingTextView::checkLabel(address_t address)
+{
+    u64 c = this->_disassembler->getReferencesCount(address);
+
+    if(!c)
+        return;
+
+    if(c == 1)
+    {
+        REDasm::ReferenceVector refs = this->_disassembler->getReferences(address);
+        this->goTo(refs.front());
+        return;
+    }
+
+    this->showReferences(address);
+}
+
+void ListingTextView::showReferences(address_t address)
+{
+    REDasm::SymbolPtr symbol = this->_disassembler->symbolTable()->symbol(address);
+
+    if(!symbol)
+        return;
+
+    if(!this->_disassembler->getReferencesCount(address))
+    {
+        QMessageBox::information(this, "No References", "There are no references to " + S_TO_QS(symbol->displayName()));
+        return;
+    }
+
+    ReferencesDialog dlgreferences(this->_disassembler, this->_currentaddress, symbol, this);
+    connect(&dlgreferences, &ReferencesDialog::jumpTo, [this](address_t address) { this->goTo(address); });
+    dlgreferences.exec();
+}
+
+void ListingTextView::showCallGraph(address_t address)
+{
+    CallGraphDialog dlgcallgraph(address, this->_disassembler, this);
+    dlgcallgraph.exec();
+}
+
+const RendererChunk *ListingTextView::chunkAt(const QPoint &pos, size_t *row)
+{
+    size_t r = this->verticalScrollBar()->value() + (pos.y() / this->lineHeight());
+
+    if(row)
+        *row = r;
+
+    QFontMetrics fm = this->fontMetrics();
+    const QList<RendererLine>& lines = this->_visiblelines; // Don't detach: returned chunk lives in '_visiblelines'
+
+    for(const RendererLine& line : lines)
+    {
+        if(line.row != r)
+            continue;
+
+        int x = -this->horizontalScrollBar()->value();
+
+        for(const RendererChunk& chunk : line.chunks)
+        {
+            int w = fm.width(chunk.text);
+
+            if((pos.x() >= x) && (pos.x() < (x + w)))
+                return &chunk;
+
+            x += w;
+        }
+
+        break;
+    }
+
+    return NULL;
+}
+
+size_t ListingTextView::visibleRows() const { return this->viewport()->height() / this->lineHeight(); }
+int ListingTextView::lineHeight() const { return this->fontMetrics().height() + LINE_MARGIN; }
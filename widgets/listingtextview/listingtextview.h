@@ -0,0 +1,80 @@
+#ifndef LISTINGTEXTVIEW_H
+#define LISTINGTEXTVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QStack>
+#include <memory>
+#include <QMenu>
+#include "listingrenderer.h"
+
+class ListingTextView : public QAbstractScrollArea // Virtualized listing: only visible rows are rendered
+{
+    Q_OBJECT
+
+    public:
+        explicit ListingTextView(QWidget *parent = 0);
+        ~ListingTextView();
+        bool canGoBack() const;
+        bool canGoForward() const;
+        address_t currentAddress() const;
+        address_t symbolAddress() const;
+        void setDisassembler(REDasm::Disassembler* disassembler);
+
+    public slots:
+        void goTo(const REDasm::SymbolPtr& symbol);
+        void goTo(address_t address);
+        void rename(address_t address);
+        void goBack();
+        void goForward();
+
+    protected:
+        virtual void paintEvent(QPaintEvent*);
+        virtual void resizeEvent(QResizeEvent *e);
+        virtual void mousePressEvent(QMouseEvent *e);
+        virtual void mouseDoubleClickEvent(QMouseEvent *e);
+        virtual void keyPressEvent(QKeyEvent *e);
+
+    private:
+        void createContextMenu();
+        void adjustContextMenu();
+        void adjustScrollBars();
+        void applyChange(const REDasm::Change& change);
+        void display(address_t address);
+        void setCurrentRow(size_t row);
+        void ensureRowVisible(size_t row);
+        void updateSymbolAddress(address_t address);
+        void checkLabel(address_t address);
+        void showReferences(address_t address);
+        void showCallGraph(address_t address);
+        const RendererChunk* chunkAt(const QPoint& pos, size_t* row = NULL);
+        size_t visibleRows() const;
+        int lineHeight() const;
+
+    signals:
+        void gotoRequested();
+        void canGoBackChanged();
+        void canGoForwardChanged();
+        void invalidateSymbols();
+        void hexDumpRequested(address_t address);
+        void symbolRenamed(const REDasm::SymbolPtr& symbol);
+        void symbolAddressChanged();
+        void symbolDeselected();
+        void addressChanged(address_t address);
+
+    private:
+        bool _issymboladdressvalid;
+        size_t _currentrow;
+        QString _currentword;
+        QStack<address_t> _backstack, _forwardstack;
+        QList<RendererLine> _visiblelines;
+        REDasm::ListingIndex _index;
+        REDasm::Disassembler* _disassembler;
+        REDasm::ChangeJournal::subscription_t _subscription;
+        std::unique_ptr<ListingRenderer> _renderer;
+        QAction *_actrename, *_actcreatestring, *_actxrefs, *_actfollow, *_actcallgraph;
+        QAction *_actgoto, *_acthexdump, *_actback, *_actforward, *_actcopy;
+        QMenu* _contextmenu;
+        address_t _currentaddress, _symboladdress;
+};
+
+#endif // LISTINGTEXTVIEW_H